@@ -60,7 +60,7 @@
 // - Increment the HIP_COMPILER_API_TABLE_STEP_VERSION when new compiler API functions are added
 // - Reset any of the *_STEP_VERSION defines to zero if the corresponding *_MAJOR_VERSION increases
 #define HIP_API_TABLE_STEP_VERSION 0
-#define HIP_RUNTIME_API_TABLE_STEP_VERSION 0
+#define HIP_RUNTIME_API_TABLE_STEP_VERSION 1
 #define HIP_COMPILER_API_TABLE_STEP_VERSION 0
 
 // HIP API interface
@@ -937,6 +937,9 @@ typedef hipError_t (*t_hipGraphAddNode)(hipGraphNode_t *pGraphNode, hipGraph_t g
                            const hipGraphNode_t *pDependencies, size_t numDependencies,
                            hipGraphNodeParams *nodeParams);
 typedef hipError_t (*t_hipExtGetLastError)();
+typedef hipError_t (*t_hipExtLaunchKernelBatch)(hipLaunchParams* launchParamsList,
+                                                int numKernels, hipStream_t stream,
+                                                unsigned int flags);
 
 // HIP Compiler dispatch table
 struct HipCompilerDispatchTable {
@@ -1398,4 +1401,5 @@ struct HipDispatchTable {
   t_hipGraphExecExternalSemaphoresWaitNodeSetParams hipGraphExecExternalSemaphoresWaitNodeSetParams_fn;
   t_hipGraphAddNode hipGraphAddNode_fn;
   t_hipExtGetLastError hipExtGetLastError_fn;
+  t_hipExtLaunchKernelBatch hipExtLaunchKernelBatch_fn;
 };
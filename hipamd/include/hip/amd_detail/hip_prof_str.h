@@ -398,7 +398,8 @@ enum hip_api_id_t {
   HIP_API_ID_hipGraphExternalSemaphoresWaitNodeSetParams = 378,
   HIP_API_ID_hipExtGetLastError = 379,
   HIP_API_ID_hipGraphAddNode = 380,
-  HIP_API_ID_LAST = 380,
+  HIP_API_ID_hipExtLaunchKernelBatch = 381,
+  HIP_API_ID_LAST = 381,
 
   HIP_API_ID_hipChooseDevice = HIP_API_ID_CONCAT(HIP_API_ID_,hipChooseDevice),
   HIP_API_ID_hipGetDeviceProperties = HIP_API_ID_CONCAT(HIP_API_ID_,hipGetDeviceProperties),
@@ -525,6 +526,7 @@ static inline const char* hip_api_name(const uint32_t id) {
     case HIP_API_ID_hipEventSynchronize: return "hipEventSynchronize";
     case HIP_API_ID_hipExtGetLinkTypeAndHopCount: return "hipExtGetLinkTypeAndHopCount";
     case HIP_API_ID_hipExtLaunchKernel: return "hipExtLaunchKernel";
+    case HIP_API_ID_hipExtLaunchKernelBatch: return "hipExtLaunchKernelBatch";
     case HIP_API_ID_hipExtLaunchMultiKernelMultiDevice: return "hipExtLaunchMultiKernelMultiDevice";
     case HIP_API_ID_hipExtMallocWithFlags: return "hipExtMallocWithFlags";
     case HIP_API_ID_hipExtModuleLaunchKernel: return "hipExtModuleLaunchKernel";
@@ -908,6 +910,7 @@ static inline uint32_t hipApiIdByName(const char* name) {
   if (strcmp("hipEventSynchronize", name) == 0) return HIP_API_ID_hipEventSynchronize;
   if (strcmp("hipExtGetLinkTypeAndHopCount", name) == 0) return HIP_API_ID_hipExtGetLinkTypeAndHopCount;
   if (strcmp("hipExtLaunchKernel", name) == 0) return HIP_API_ID_hipExtLaunchKernel;
+  if (strcmp("hipExtLaunchKernelBatch", name) == 0) return HIP_API_ID_hipExtLaunchKernelBatch;
   if (strcmp("hipExtLaunchMultiKernelMultiDevice", name) == 0) return HIP_API_ID_hipExtLaunchMultiKernelMultiDevice;
   if (strcmp("hipExtMallocWithFlags", name) == 0) return HIP_API_ID_hipExtMallocWithFlags;
   if (strcmp("hipExtModuleLaunchKernel", name) == 0) return HIP_API_ID_hipExtModuleLaunchKernel;
@@ -1600,6 +1603,13 @@ typedef struct hip_api_data_s {
       hipEvent_t stopEvent;
       int flags;
     } hipExtLaunchKernel;
+    struct {
+      hipLaunchParams* launchParamsList;
+      hipLaunchParams launchParamsList__val;
+      int numKernels;
+      hipStream_t stream;
+      unsigned int flags;
+    } hipExtLaunchKernelBatch;
     struct {
       hipLaunchParams* launchParamsList;
       hipLaunchParams launchParamsList__val;
@@ -3837,6 +3847,13 @@ typedef struct hip_api_data_s {
   cb_data.args.hipExtLaunchKernel.stopEvent = (hipEvent_t)stopEvent; \
   cb_data.args.hipExtLaunchKernel.flags = (int)flags; \
 };
+// hipExtLaunchKernelBatch[('hipLaunchParams*', 'launchParamsList'), ('int', 'numKernels'), ('hipStream_t', 'stream'), ('unsigned int', 'flags')]
+#define INIT_hipExtLaunchKernelBatch_CB_ARGS_DATA(cb_data) { \
+  cb_data.args.hipExtLaunchKernelBatch.launchParamsList = (hipLaunchParams*)launchParamsList; \
+  cb_data.args.hipExtLaunchKernelBatch.numKernels = (int)numKernels; \
+  cb_data.args.hipExtLaunchKernelBatch.stream = (hipStream_t)stream; \
+  cb_data.args.hipExtLaunchKernelBatch.flags = (unsigned int)flags; \
+};
 // hipExtLaunchMultiKernelMultiDevice[('hipLaunchParams*', 'launchParamsList'), ('int', 'numDevices'), ('unsigned int', 'flags')]
 #define INIT_hipExtLaunchMultiKernelMultiDevice_CB_ARGS_DATA(cb_data) { \
   cb_data.args.hipExtLaunchMultiKernelMultiDevice.launchParamsList = (hipLaunchParams*)launchParamsList; \
@@ -6059,6 +6076,10 @@ static inline void hipApiArgsInit(hip_api_id_t id, hip_api_data_t* data) {
     case HIP_API_ID_hipExtLaunchKernel:
       if (data->args.hipExtLaunchKernel.args) data->args.hipExtLaunchKernel.args__val = *(data->args.hipExtLaunchKernel.args);
       break;
+// hipExtLaunchKernelBatch[('hipLaunchParams*', 'launchParamsList'), ('int', 'numKernels'), ('hipStream_t', 'stream'), ('unsigned int', 'flags')]
+    case HIP_API_ID_hipExtLaunchKernelBatch:
+      if (data->args.hipExtLaunchKernelBatch.launchParamsList) data->args.hipExtLaunchKernelBatch.launchParamsList__val = *(data->args.hipExtLaunchKernelBatch.launchParamsList);
+      break;
 // hipExtLaunchMultiKernelMultiDevice[('hipLaunchParams*', 'launchParamsList'), ('int', 'numDevices'), ('unsigned int', 'flags')]
     case HIP_API_ID_hipExtLaunchMultiKernelMultiDevice:
       if (data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList) data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList__val = *(data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList);
@@ -7784,6 +7805,15 @@ static inline const char* hipApiString(hip_api_id_t id, const hip_api_data_t* da
       oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernel.flags);
       oss << ")";
     break;
+    case HIP_API_ID_hipExtLaunchKernelBatch:
+      oss << "hipExtLaunchKernelBatch(";
+      if (data->args.hipExtLaunchKernelBatch.launchParamsList == NULL) oss << "launchParamsList=NULL";
+      else { oss << "launchParamsList="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.launchParamsList__val); }
+      oss << ", numKernels="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.numKernels);
+      oss << ", stream="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.stream);
+      oss << ", flags="; roctracer::hip_support::detail::operator<<(oss, data->args.hipExtLaunchKernelBatch.flags);
+      oss << ")";
+    break;
     case HIP_API_ID_hipExtLaunchMultiKernelMultiDevice:
       oss << "hipExtLaunchMultiKernelMultiDevice(";
       if (data->args.hipExtLaunchMultiKernelMultiDevice.launchParamsList == NULL) oss << "launchParamsList=NULL";
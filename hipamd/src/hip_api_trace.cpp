@@ -757,6 +757,8 @@ hipError_t hipGraphExternalSemaphoresWaitNodeSetParams(
 hipError_t hipModuleLaunchCooperativeKernelMultiDevice(hipFunctionLaunchParams* launchParamsList,
                                                        unsigned int numDevices, unsigned int flags);
 hipError_t hipExtGetLastError();
+hipError_t hipExtLaunchKernelBatch(hipLaunchParams* launchParamsList, int numKernels,
+                                   hipStream_t stream, unsigned int flags);
 }  // namespace hip
 
 namespace hip {
@@ -1227,6 +1229,7 @@ void UpdateDispatchTable(HipDispatchTable* ptrDispatchTable) {
   ptrDispatchTable->hipDrvGraphAddMemsetNode_fn = hip::hipDrvGraphAddMemsetNode;
   ptrDispatchTable->hipGetDevicePropertiesR0000_fn = hip::hipGetDevicePropertiesR0000;
   ptrDispatchTable->hipExtGetLastError_fn = hip::hipExtGetLastError;
+  ptrDispatchTable->hipExtLaunchKernelBatch_fn = hip::hipExtLaunchKernelBatch;
 }
 
 #if HIP_ROCPROFILER_REGISTER > 0
@@ -1759,7 +1762,20 @@ HIP_ENFORCE_ABI(HipDispatchTable, hipLaunchHostFunc_spt_fn, 426)
 HIP_ENFORCE_ABI(HipDispatchTable, hipGetStreamDeviceId_fn, 427)
 HIP_ENFORCE_ABI(HipDispatchTable, hipDrvGraphAddMemsetNode_fn, 428)
 
-static_assert(HIP_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && HIP_RUNTIME_API_TABLE_STEP_VERSION == 0,
+// HIP_RUNTIME_API_TABLE_STEP_VERSION == 1
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphAddExternalSemaphoresWaitNode_fn, 429)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphAddExternalSemaphoresSignalNode_fn, 430)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExternalSemaphoresSignalNodeSetParams_fn, 431)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExternalSemaphoresWaitNodeSetParams_fn, 432)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExternalSemaphoresSignalNodeGetParams_fn, 433)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExternalSemaphoresWaitNodeGetParams_fn, 434)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExecExternalSemaphoresSignalNodeSetParams_fn, 435)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphExecExternalSemaphoresWaitNodeSetParams_fn, 436)
+HIP_ENFORCE_ABI(HipDispatchTable, hipGraphAddNode_fn, 437)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtGetLastError_fn, 438)
+HIP_ENFORCE_ABI(HipDispatchTable, hipExtLaunchKernelBatch_fn, 439)
+
+static_assert(HIP_RUNTIME_API_TABLE_MAJOR_VERSION == 0 && HIP_RUNTIME_API_TABLE_STEP_VERSION == 1,
               "If you get this error, add new HIP_ENFORCE_ABI(...) code for the new function "
               "pointers and then update this check so it is true");
 #endif
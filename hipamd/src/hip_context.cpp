@@ -23,11 +23,14 @@
 #include "hip_platform.hpp"
 #include "platform/runtime.hpp"
 #include "utils/flags.hpp"
+#include "utils/parallel.hpp"
 #include "utils/versions.hpp"
 
 std::once_flag g_ihipInitialized;
 
 namespace hip {
+std::atomic<bool> g_initialized(false);
+std::atomic<uint32_t> g_instrumentation(0);
 std::vector<hip::Device*> g_devices;
 thread_local TlsAggregator tls;
 amd::Context* host_context = nullptr;
@@ -42,25 +45,38 @@ void init(bool* status) {
   constexpr bool kDirectDispatch = IS_LINUX;
 #endif
   AMD_DIRECT_DISPATCH = flagIsDefault(AMD_DIRECT_DISPATCH) ? kDirectDispatch : AMD_DIRECT_DISPATCH;
-  if (!amd::Runtime::init()) {
+  const bool runtime_init = amd::Runtime::init();
+  // Log flags are final after the runtime init, enable logging before any early return,
+  // so the failing API call is still logged
+  SetInstrumentation(kApiLog, (AMD_LOG_LEVEL >= amd::LOG_INFO) && (AMD_LOG_MASK & amd::LOG_API));
+  if (!runtime_init) {
     *status = false;
     return;
   }
   ClPrint(amd::LOG_INFO, amd::LOG_INIT, "Direct Dispatch: %d", AMD_DIRECT_DISPATCH);
 
-
   const std::vector<amd::Device*>& devices = amd::Device::getDevices(CL_DEVICE_TYPE_GPU, false);
 
-  for (unsigned int i=0; i<devices.size(); i++) {
-    // Enable active wait on the device by default
-    devices[i]->SetActiveWait(true);
-    // use the eternal contexts that already exist for new hip::Device's here
-    auto device = new Device(&devices[i]->context(), i);
-    if ((device == nullptr) || !device->Create()) {
+  // The HIP devices only create their memory pools, hence they are created concurrently and
+  // added in the device order, so the device indices stay the same
+  std::vector<std::unique_ptr<Device>> hip_devices = amd::parallelCreate<Device>(
+      devices.size(), ROC_DEVICE_INIT_THREADS, [&devices](size_t i) -> Device* {
+        // Enable active wait on the device by default
+        devices[i]->SetActiveWait(true);
+        // use the eternal contexts that already exist for new hip::Device's here
+        auto device = new Device(&devices[i]->context(), i);
+        if ((device != nullptr) && !device->Create()) {
+          delete device;
+          return nullptr;
+        }
+        return device;
+      });
+  for (auto& device : hip_devices) {
+    if (!device) {
       *status = false;
       return;
     }
-    g_devices.push_back(device);
+    g_devices.push_back(device.release());
   }
 
   amd::Context* hContext = new amd::Context(devices, amd::Context::Info());
@@ -76,6 +92,7 @@ void init(bool* status) {
 
   PlatformState::instance().init();
   *status = true;
+  g_initialized.store(true, std::memory_order_release);
   return;
 }
 
@@ -23,6 +23,7 @@
 
 #include "hip_internal.hpp"
 #include "hip_mempool_impl.hpp"
+#include "platform/sampler.hpp"
 
 #undef hipGetDeviceProperties
 #undef hipDeviceProp_t
@@ -137,6 +138,10 @@ void Device::Reset() {
 
 // ================================================================================================
 Device::~Device() {
+  for (auto& it : samplers_) {
+    it.second->release();
+  }
+
   if (default_mem_pool_ != nullptr) {
     default_mem_pool_->release();
   }
@@ -53,6 +53,12 @@ bool EventDD::ready(eventType type) {
 }
 
 hipError_t Event::query() {
+  // Lock-free path for the events, which were recorded and already observed complete,
+  // or weren't recorded at all
+  if (completed_.load(std::memory_order_acquire)) {
+    return hipSuccess;
+  }
+
   amd::ScopedLock lock(lock_);
 
   // If event is not recorded, event_ is null, hence return hipSuccess
@@ -60,7 +66,11 @@ hipError_t Event::query() {
     return hipSuccess;
   }
 
-  return ready(Query) ? hipSuccess : hipErrorNotReady;
+  if (!ready(Query)) {
+    return hipErrorNotReady;
+  }
+  completed_.store(true, std::memory_order_release);
+  return hipSuccess;
 }
 
 hipError_t Event::synchronize() {
@@ -71,6 +81,14 @@ hipError_t Event::synchronize() {
     return hipSuccess;
   }
 
+  if (activity_prof::IsEnabled(OP_ID_DISPATCH)) {
+    // The activity records are reported on the event status update, hence the profiler needs
+    // the wait for the status and the delivery of the records after it
+    event_->awaitCompletion();
+    activity_prof::FlushActivity();
+    return hipSuccess;
+  }
+
   auto hip_device = g_devices[deviceId()];
   // Check HW status of the ROCcrl event. Note: not all ROCclr modes support HW status
   static constexpr bool kWaitCompletion = true;
@@ -245,6 +263,7 @@ hipError_t Event::enqueueRecordCommand(hipStream_t stream, amd::Command* command
     event_->release();
   }
   event_ = &command->event();
+  completed_.store(false, std::memory_order_relaxed);
   unrecorded_ = !record;
 
   return hipSuccess;
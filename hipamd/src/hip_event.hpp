@@ -22,6 +22,7 @@
 #define HIP_EVENT_H
 
 #include "hip_internal.hpp"
+#include "hip_event_ipc_signal.hpp"
 #include "thread/monitor.hpp"
 
 // Internal structure for stream callback handler
@@ -68,15 +69,22 @@ class LaunchHostFuncCallback : public StreamCallback {
 void CL_CALLBACK ihipStreamCallback(cl_event event, cl_int command_exec_status, void* user_data);
 
 
-#define IPC_SIGNALS_PER_EVENT 32
-typedef struct ihipIpcEventShmem_s {
-  std::atomic<int> owners;
-  std::atomic<int> owners_device_id;
-  std::atomic<int> owners_process_id;
-  std::atomic<int> read_index;
-  std::atomic<int> write_index;
-  uint32_t signal[IPC_SIGNALS_PER_EVENT];
-} ihipIpcEventShmem_t;
+//! Shared memory of an IPC event, which the pending wake callbacks refer to. The event detaches
+//! the memory under the lock before the unmap, so a late callback doesn't touch the mapping
+struct ihipIpcWakeTarget {
+  amd::Monitor lock_{"IPC event wake lock"};
+  ihipIpcEventShmem_t* shmem_ = nullptr;
+};
+
+//! Wake request for the signal slot at \a offset_, passed to ihipIpcEventWakeSignal
+struct ihipIpcWakeRequest {
+  std::shared_ptr<ihipIpcWakeTarget> target_;
+  int offset_;
+};
+
+//! Wakes up all processes, blocked on the signal slot of the ihipIpcWakeRequest \a request.
+//! The request is released by the call
+void ihipIpcEventWakeSignal(void* request);
 
 class EventMarker : public amd::Marker {
  public:
@@ -109,7 +117,8 @@ class Event {
 
  public:
   Event(unsigned int flags) : flags(flags), lock_("hipEvent_t", true),
-                              event_(nullptr), unrecorded_(false), stream_(nullptr) {
+                              event_(nullptr), unrecorded_(false), stream_(nullptr),
+                              completed_(true) {
     // No need to init event_ here as addMarker does that
     device_id_ = hip::getCurrentDevice()->deviceId();  // Created in current device ctx
   }
@@ -140,6 +149,7 @@ class Event {
       event_->release();
     }
     event_ = &command.event();
+    completed_.store(false, std::memory_order_relaxed);
     unrecorded_ = !record;
     command.retain();
   }
@@ -178,6 +188,8 @@ class Event {
   //! hip*ModuleLaunchKernel API which takes start and stop events so no
   //! hipEventRecord is called. Cleanup needed once those APIs are deprecated.
   bool unrecorded_;
+  //! The current event_ is known to be complete, so query() can skip the lock and HW checks
+  std::atomic<bool> completed_;
 };
 
 class EventDD : public Event {
@@ -200,6 +212,7 @@ class IPCEvent : public Event {
     void setipcname(const char* name) { ipc_name_ = std::string(name); }
   };
   ihipIpcEvent_t ipc_evt_;
+  std::shared_ptr<ihipIpcWakeTarget> wake_target_;  //!< Target of the pending wake callbacks
 
  public:
   ~IPCEvent() {
@@ -207,6 +220,11 @@ class IPCEvent : public Event {
       int owners = --ipc_evt_.ipc_shmem_->owners;
       // Make sure event is synchronized
       hipError_t status = synchronize();
+      if (wake_target_ != nullptr) {
+        // Unregister the wake callbacks, which are still in flight, from the shared memory
+        amd::ScopedLock lock(wake_target_->lock_);
+        wake_target_->shmem_ = nullptr;
+      }
       status  = ihipHostUnregister(&ipc_evt_.ipc_shmem_->signal);
       if (!amd::Os::MemoryUnmapFile(ipc_evt_.ipc_shmem_, sizeof(hip::ihipIpcEventShmem_t))) {
         // print hipErrorInvalidHandle;
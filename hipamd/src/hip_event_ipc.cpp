@@ -32,6 +32,19 @@ namespace hip {
 
 hipError_t ihipEventCreateWithFlags(hipEvent_t* event, unsigned flags);
 
+// ================================================================================================
+void ihipIpcEventWakeSignal(void* request) {
+  auto wake = reinterpret_cast<ihipIpcWakeRequest*>(request);
+  {
+    amd::ScopedLock lock(wake->target_->lock_);
+    // The event could be destroyed and its shared memory unmapped before the callback
+    if (wake->target_->shmem_ != nullptr) {
+      ihipIpcEventWake(&wake->target_->shmem_->signal[wake->offset_]);
+    }
+  }
+  delete wake;
+}
+
 bool IPCEvent::createIpcEventShmemIfNeeded() {
   if (ipc_evt_.ipc_shmem_) {
     // ipc_shmem_ already created, no need to create it again
@@ -92,10 +105,7 @@ hipError_t IPCEvent::synchronize() {
     int prev_read_idx = ipc_evt_.ipc_shmem_->read_index;
     if (prev_read_idx >= 0) {
       int offset = (prev_read_idx % IPC_SIGNALS_PER_EVENT);
-      while ((ipc_evt_.ipc_shmem_->read_index < prev_read_idx + IPC_SIGNALS_PER_EVENT) &&
-             (ipc_evt_.ipc_shmem_->signal[offset] != 0)) {
-        amd::Os::sleep(1);
-      }
+      ihipIpcEventWaitSignal(ipc_evt_.ipc_shmem_, offset, prev_read_idx + IPC_SIGNALS_PER_EVENT);
     }
   }
   return hipSuccess;
@@ -156,29 +166,42 @@ hipError_t IPCEvent::enqueueRecordCommand(hipStream_t stream, amd::Command* comm
     createIpcEventShmemIfNeeded();
     int write_index = ipc_evt_.ipc_shmem_->write_index++;
     int offset = write_index % IPC_SIGNALS_PER_EVENT;
-    while (ipc_evt_.ipc_shmem_->signal[offset] != 0) {
-      amd::Os::sleep(1);
-    }
+    // Wait for the slot to be released by the device
+    ihipIpcEventWaitSignal(ipc_evt_.ipc_shmem_, offset, std::numeric_limits<int>::max());
     // Lock signal.
     ipc_evt_.ipc_shmem_->signal[offset] = 1;
     ipc_evt_.ipc_shmem_->owners_device_id = deviceId();
     command->enqueue();
 
+    // Wake up the waiting processes after the device released the slot. The wake runs in the
+    // completion callback of the signal write, so the record doesn't need an extra command
+    if (wake_target_ == nullptr) {
+      wake_target_ = std::make_shared<ihipIpcWakeTarget>();
+      wake_target_->shmem_ = ipc_evt_.ipc_shmem_;
+    }
+    auto request = new ihipIpcWakeRequest{wake_target_, offset};
+    StreamCallback* cbo = new LaunchHostFuncCallback(ihipIpcEventWakeSignal, request);
+
     // device writes 0 to signal after the hipEventRecord command is completed
     // the signal value is checked by WaitThenDecrementSignal cb
     hipError_t status = ihipStreamOperation(stream, ROCCLR_COMMAND_STREAM_WRITE_VALUE,
                                  &(ipc_evt_.ipc_shmem_->signal[offset]),
                                  0,
-                                 0, 0, sizeof(uint32_t));
+                                 0, 0, sizeof(uint32_t), cbo);
     if (status != hipSuccess) {
+      delete cbo;
+      delete request;
       return status;
     }
 
     // Update read index to indicate new signal.
     int expected = write_index - 1;
     while (!ipc_evt_.ipc_shmem_->read_index.compare_exchange_weak(expected, write_index)) {
-      amd::Os::sleep(1);
+      amd::Os::yield();
     }
+    // The waiters for the slot, which was recorded IPC_SIGNALS_PER_EVENT records earlier, block
+    // on the same signal word and finish once read_index moves past the old record
+    ihipIpcEventWake(&ipc_evt_.ipc_shmem_->signal[offset]);
   } else {
     return Event::enqueueRecordCommand(stream, command, record);
   }
@@ -0,0 +1,76 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_event_ipc_signal.hpp"
+#include "os/os.hpp"
+
+#include <algorithm>
+#include <limits>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+// ================================================================================================
+namespace hip {
+
+// Spin budget before a waiter blocks in the kernel. It adapts to the observed handoff latency
+static std::atomic<uint32_t> ipcSpinCount{256};
+constexpr uint32_t kIpcMinSpinCount = 16;
+constexpr uint32_t kIpcMaxSpinCount = 4096;
+
+// ================================================================================================
+void ihipIpcEventWaitSignal(ihipIpcEventShmem_t* shmem, int offset, int limit) {
+  volatile uint32_t* signal = &shmem->signal[offset];
+  auto busy = [&]() { return (shmem->read_index < limit) && (*signal != 0); };
+
+  uint32_t spin_count = ipcSpinCount.load(std::memory_order_relaxed);
+  for (uint32_t spin = 0; spin < spin_count; ++spin) {
+    if (!busy()) {
+      // The slot was released while spinning, allow longer spins next time
+      ipcSpinCount.store(std::min(spin_count * 2, kIpcMaxSpinCount), std::memory_order_relaxed);
+      return;
+    }
+    amd::Os::yield();
+  }
+  ipcSpinCount.store(std::max(spin_count / 2, kIpcMinSpinCount), std::memory_order_relaxed);
+
+  while (busy()) {
+#if defined(__linux__)
+    // The recording process wakes the waiters once the device releases the slot.
+    // The timeout only covers a wake, which could be lost if the producer exits
+    struct timespec timeout = {0, 1000000};
+    syscall(SYS_futex, signal, FUTEX_WAIT, 1, &timeout, nullptr, 0);
+#else
+    amd::Os::sleep(1);
+#endif
+  }
+}
+
+// ================================================================================================
+void ihipIpcEventWake(volatile uint32_t* signal) {
+#if defined(__linux__)
+  syscall(SYS_futex, signal, FUTEX_WAKE, std::numeric_limits<int>::max(), nullptr, nullptr, 0);
+#endif
+}
+
+}  // namespace hip
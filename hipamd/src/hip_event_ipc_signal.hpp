@@ -0,0 +1,43 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace hip {
+
+#define IPC_SIGNALS_PER_EVENT 32
+typedef struct ihipIpcEventShmem_s {
+  std::atomic<int> owners;
+  std::atomic<int> owners_device_id;
+  std::atomic<int> owners_process_id;
+  std::atomic<int> read_index;
+  std::atomic<int> write_index;
+  uint32_t signal[IPC_SIGNALS_PER_EVENT];
+} ihipIpcEventShmem_t;
+
+//! Waits until the IPC signal slot at \a offset is released or \a read_index reaches \a limit
+void ihipIpcEventWaitSignal(ihipIpcEventShmem_t* shmem, int offset, int limit);
+//! Wakes up all processes, blocked on the IPC signal slot \a signal
+void ihipIpcEventWake(volatile uint32_t* signal);
+
+}  // namespace hip
@@ -50,16 +50,9 @@ inline hipError_t ihipGraphAddNode(hip::GraphNode* graphNode, hip::Graph* graph,
     DuplicateDep.insert(pDependencies[i]);
     pDependencies[i]->AddEdge(graphNode);
   }
-  if (capture == false) {
-    {
-      amd::ScopedLock lock(g_streamSetLock);
-      for (auto stream : g_allCapturingStreams) {
-        if (stream->GetCaptureGraph() == graph) {
-          graph->AddManualNodeDuringCapture(graphNode);
-          break;
-        }
-      }
-    }
+  // The graph tracks its own capture state, so no scan of the capturing streams is required
+  if ((capture == false) && graph->IsCapturing()) {
+    graph->AddManualNodeDuringCapture(graphNode);
   }
   return hipSuccess;
 }
@@ -867,6 +860,7 @@ hipError_t hipStreamBeginCapture_common(hipStream_t stream, hipStreamCaptureMode
   }
 
   s->SetCaptureGraph(new hip::Graph(s->GetDevice()));
+  s->GetCaptureGraph()->SetCapturing(true);
   s->SetCaptureId();
   s->SetCaptureMode(mode);
   s->SetOriginStream();
@@ -936,6 +930,7 @@ hipError_t hipStreamEndCapture_common(hipStream_t stream, hip::Graph** pGraph) {
     amd::ScopedLock lock(g_streamSetLock);
     g_allCapturingStreams.erase(std::find(g_allCapturingStreams.begin(), g_allCapturingStreams.end(), s));
   }
+  s->GetCaptureGraph()->SetCapturing(false);
   // check if all parallel streams have joined
   // Nodes that are removed from the dependency set via API hipStreamUpdateCaptureDependencies do
   // not result in hipErrorStreamCaptureUnjoined
@@ -2229,23 +2224,44 @@ hipError_t hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
     HIP_RETURN(hipErrorInvalidValue);
   }
 
-  std::vector<hip::GraphNode*> newGraphNodes;
-  reinterpret_cast<hip::Graph*>(hGraph)->TopologicalOrder(newGraphNodes);
-  std::vector<hip::GraphNode*>& oldGraphExecNodes =
-      reinterpret_cast<hip::GraphExec*>(hGraphExec)->GetNodes();
-  if (newGraphNodes.size() != oldGraphExecNodes.size()) {
-    *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
-    *hErrorNode_out = nullptr;
-    HIP_RETURN(hipErrorGraphExecUpdateFailure);
+  hip::GraphExec* graphExec = reinterpret_cast<hip::GraphExec*>(hGraphExec);
+  hip::Graph* graph = reinterpret_cast<hip::Graph*>(hGraph);
+  std::vector<hip::GraphNode*>& oldGraphExecNodes = graphExec->GetNodes();
+  // Match the nodes by identity if the graph is the one the executable graph was instantiated
+  // from. That avoids the topological sort and allows an exact check of the dependencies
+  std::vector<hip::GraphNode*> matchedExecNodes;
+  bool identityMatch = (graph->GetNodeCount() == oldGraphExecNodes.size());
+  if (identityMatch) {
+    matchedExecNodes.reserve(oldGraphExecNodes.size());
+    for (auto node : graph->GetNodes()) {
+      hip::GraphNode* clonedNode = graphExec->GetClonedNode(node);
+      if (clonedNode == nullptr) {
+        identityMatch = false;
+        break;
+      }
+      matchedExecNodes.push_back(clonedNode);
+    }
   }
+  std::vector<hip::GraphNode*> sortedGraphNodes;
+  if (!identityMatch) {
+    graph->TopologicalOrder(sortedGraphNodes);
+    if (sortedGraphNodes.size() != oldGraphExecNodes.size()) {
+      *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
+      *hErrorNode_out = nullptr;
+      HIP_RETURN(hipErrorGraphExecUpdateFailure);
+    }
+    matchedExecNodes = oldGraphExecNodes;
+  }
+  const std::vector<hip::GraphNode*>& newGraphNodes =
+      identityMatch ? graph->GetNodes() : sortedGraphNodes;
 
   for (std::vector<hip::GraphNode*>::size_type i = 0; i != newGraphNodes.size(); i++) {
     // Checks if all the node types are same before updating
-    if (newGraphNodes[i]->GetType() == oldGraphExecNodes[i]->GetType()) {
+    if (newGraphNodes[i]->GetType() == matchedExecNodes[i]->GetType()) {
       if (newGraphNodes[i]->GetType() != hipGraphNodeTypeHost &&
           newGraphNodes[i]->GetType() != hipGraphNodeTypeEmpty) {
         if (newGraphNodes[i]->GetParentGraph()->device_ !=
-            oldGraphExecNodes[i]->GetParentGraph()->device_) {
+            matchedExecNodes[i]->GetParentGraph()->device_) {
           *updateResult_out = hipGraphExecUpdateErrorUnsupportedFunctionChange;
           *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
           return hipErrorGraphExecUpdateFailure;
@@ -2258,7 +2274,7 @@ hipError_t hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
           const hip::GraphMemcpyNode* newMemcpyNode =
              static_cast<hip::GraphMemcpyNode const*>(newGraphNodes[i]);
           const hip::GraphMemcpyNode* oldMemcpyNode =
-             static_cast<hip::GraphMemcpyNode const*>(oldGraphExecNodes[i]);
+             static_cast<hip::GraphMemcpyNode const*>(matchedExecNodes[i]);
           hipMemcpyKind newKind, oldKind;
           newKind = newMemcpyNode->GetMemcpyKind();
           oldKind = oldMemcpyNode->GetMemcpyKind();
@@ -2273,14 +2289,35 @@ hipError_t hipGraphExecUpdate(hipGraphExec_t hGraphExec, hipGraph_t hGraph,
       const std::vector<hip::GraphNode*>& newGraphDependencies =
                         newGraphNodes[i]->GetDependencies();
       const std::vector<hip::GraphNode*>& oldGraphDependencies =
-                        oldGraphExecNodes[i]->GetDependencies();
-      if (newGraphDependencies.size() != oldGraphDependencies.size()) {
+                        matchedExecNodes[i]->GetDependencies();
+      bool sameDependencies = (newGraphDependencies.size() == oldGraphDependencies.size());
+      if (sameDependencies && identityMatch) {
+        for (auto dependency : newGraphDependencies) {
+          if (std::find(oldGraphDependencies.begin(), oldGraphDependencies.end(),
+                        graphExec->GetClonedNode(dependency)) == oldGraphDependencies.end()) {
+            sameDependencies = false;
+            break;
+          }
+        }
+      }
+      if (!sameDependencies) {
         *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
         *updateResult_out = hipGraphExecUpdateErrorTopologyChanged;
         HIP_RETURN(hipErrorGraphExecUpdateFailure);
       }
 
-      hipError_t status = oldGraphExecNodes[i]->SetParams(newGraphNodes[i]);
+      // Skip the nodes without changes, so the update cost depends on the changed nodes only
+      if (matchedExecNodes[i]->HasSameParams(newGraphNodes[i])) {
+        continue;
+      }
+      hipError_t status = matchedExecNodes[i]->SetParams(newGraphNodes[i]);
+      if (status == hipSuccess && DEBUG_CLR_GRAPH_PACKET_CAPTURE &&
+          newGraphNodes[i]->GetType() == hipGraphNodeTypeKernel &&
+          static_cast<hip::GraphKernelNode*>(matchedExecNodes[i])->IsPacketCaptured()) {
+        // The captured packet holds the old arguments, hence form it again for the changed node
+        status = graphExec->UpdateAQLPacket(
+            static_cast<hip::GraphKernelNode*>(matchedExecNodes[i]));
+      }
       if (status != hipSuccess) {
         *hErrorNode_out = reinterpret_cast<hipGraphNode_t>(newGraphNodes[i]);
         if (status == hipErrorInvalidDeviceFunction) {
@@ -2330,7 +2367,8 @@ hipError_t hipGraphAddMemAllocNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
   hip::GraphNode* node = mem_alloc_node;
   auto status =
       ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                       reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+                       reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                       numDependencies, false);
   // The address must be provided during the node creation time
   pNodeParams->dptr =
       (HIP_MEM_POOL_USE_VM) ? mem_alloc_node->ReserveAddress() : mem_alloc_node->Execute();
@@ -2380,7 +2418,8 @@ hipError_t hipGraphAddMemFreeNode(hipGraphNode_t* pGraphNode, hipGraph_t graph,
   hip::GraphNode* node = mem_free_node;
   auto status =
       ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                       reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+                       reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                       numDependencies, false);
   *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
   HIP_RETURN(status);
 }
@@ -2751,7 +2790,8 @@ hipError_t hipGraphAddNode(hipGraphNode_t *pGraphNode, hipGraph_t graph,
       node = mem_alloc_node;
       status =
           ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                       reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+                       reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                       numDependencies, false);
       // The address must be provided during the node creation time
       nodeParams->alloc.dptr =
         (HIP_MEM_POOL_USE_VM) ? mem_alloc_node->ReserveAddress() : mem_alloc_node->Execute();
@@ -2775,7 +2815,8 @@ hipError_t hipGraphAddNode(hipGraphNode_t *pGraphNode, hipGraph_t graph,
     node = new hip::GraphMemFreeNode(nodeParams->free.dptr);
     status =
       ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                       reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+                       reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                       numDependencies, false);
       break;
     default:
       status = hipErrorInvalidValue;
@@ -2792,7 +2833,8 @@ hipError_t hipGraphAddExternalSemaphoresSignalNode(hipGraphNode_t* pGraphNode, h
                numDependencies, nodeParams);  
   hip::GraphNode* node = new hip::hipGraphExternalSemSignalNode(nodeParams);
   hipError_t status = ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                         reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+                         reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                         numDependencies, false);
   *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
   HIP_RETURN(status);
 }
@@ -2808,7 +2850,8 @@ hipError_t hipGraphAddExternalSemaphoresWaitNode(hipGraphNode_t* pGraphNode, hip
   }
   hip::GraphNode* node = new hip::hipGraphExternalSemWaitNode(nodeParams);
   hipError_t status = ihipGraphAddNode(node, reinterpret_cast<hip::Graph*>(graph),
-                          reinterpret_cast<hip::GraphNode* const*>(pDependencies), numDependencies);
+                          reinterpret_cast<hip::GraphNode* const*>(pDependencies),
+                          numDependencies, false);
   *pGraphNode = reinterpret_cast<hipGraphNode_t>(node);
   HIP_RETURN(status);
 }
@@ -19,8 +19,15 @@
  THE SOFTWARE. */
 
 #include "hip_graph_internal.hpp"
+#include "utils/parallel.hpp"
+#include <algorithm>
 #include <queue>
 
+namespace {
+// Minimum number of nodes per thread for parallel node preparation
+constexpr size_t kMinNodesPerThread = 64;
+}
+
 #define CASE_STRING(X, C)                                                                          \
   case X:                                                                                          \
     case_string = #C;                                                                              \
@@ -180,67 +187,24 @@ std::vector<std::pair<Node, Node>> Graph::GetEdges() const {
   return edges;
 }
 
-void Graph::GetRunListUtil(Node v, std::unordered_map<Node, bool>& visited,
-                               std::vector<Node>& singleList,
-                               std::vector<std::vector<Node>>& parallelLists,
-                               std::unordered_map<Node, std::vector<Node>>& dependencies) {
-  // Mark the current node as visited.
-  visited[v] = true;
-  singleList.push_back(v);
-  // Recurse for all the vertices adjacent to this vertex
-  for (auto& adjNode : v->GetEdges()) {
-    if (!visited[adjNode]) {
-      // For the parallel list nodes add parent as the dependency
-      if (singleList.empty()) {
-        ClPrint(amd::LOG_INFO, amd::LOG_CODE,
-                "[hipGraph] For %s(%p) - add parent as dependency %s(%p)",
-                GetGraphNodeTypeString(adjNode->GetType()), adjNode,
-                GetGraphNodeTypeString(v->GetType()), v);
-        dependencies[adjNode].push_back(v);
-      }
-      GetRunListUtil(adjNode, visited, singleList, parallelLists, dependencies);
-    } else {
-      for (auto& list : parallelLists) {
-        // Merge singleList when adjNode matches with the first element of the list in existing
-        // lists
-        if (adjNode == list[0]) {
-          for (auto k = singleList.rbegin(); k != singleList.rend(); ++k) {
-            list.insert(list.begin(), *k);
-          }
-          singleList.erase(singleList.begin(), singleList.end());
-        }
-      }
-      // If the list cannot be merged with the existing list add as dependancy
-      if (!singleList.empty()) {
-        ClPrint(amd::LOG_INFO, amd::LOG_CODE, "[hipGraph] For %s(%p) - add dependency %s(%p)",
-                GetGraphNodeTypeString(adjNode->GetType()), adjNode,
-                GetGraphNodeTypeString(v->GetType()), v);
-        dependencies[adjNode].push_back(v);
-      }
-    }
-  }
-  if (!singleList.empty()) {
-    parallelLists.push_back(singleList);
-    singleList.erase(singleList.begin(), singleList.end());
-  }
-}
 // The function to do Topological Sort.
-// It uses recursive GetRunListUtil()
+// It uses the iterative BuildRunLists() and runs in O(V+E), excluding list merges
 void Graph::GetRunList(std::vector<std::vector<Node>>& parallelLists,
                            std::unordered_map<Node, std::vector<Node>>& dependencies) {
-  std::vector<Node> singleList;
-
-  // Mark all the vertices as not visited
-  std::unordered_map<Node, bool> visited;
-  for (auto node : vertices_) visited[node] = false;
-
-  // Call the recursive helper function for all vertices one by one
   for (auto node : vertices_) {
     // If the node has embedded child graph
     node->GetRunList(parallelLists, dependencies);
-    if (visited[node] == false) {
-      GetRunListUtil(node, visited, singleList, parallelLists, dependencies);
-    }
+  }
+
+  std::vector<Node> topoOrder;
+  if ((HIP_GRAPH_MAX_STREAMS != 0) && TopologicalOrder(topoOrder)) {
+    ScheduleRunList(topoOrder, parallelLists, dependencies);
+  } else {
+    BuildRunLists(vertices_, parallelLists, dependencies, [](Node node, Node dependency) {
+      ClPrint(amd::LOG_INFO, amd::LOG_CODE, "[hipGraph] For %s(%p) - add dependency %s(%p)",
+              GetGraphNodeTypeString(node->GetType()), node,
+              GetGraphNodeTypeString(dependency->GetType()), dependency);
+    });
   }
   for (size_t i = 0; i < parallelLists.size(); i++) {
     for (size_t j = 0; j < parallelLists[i].size(); j++) {
@@ -249,9 +213,78 @@ void Graph::GetRunList(std::vector<std::vector<Node>>& parallelLists,
     }
   }
 }
+// ================================================================================================
+void Graph::ScheduleRunList(const std::vector<Node>& topoOrder,
+                            std::vector<std::vector<Node>>& parallelLists,
+                            std::unordered_map<Node, std::vector<Node>>& dependencies) {
+  const size_t count = topoOrder.size();
+  std::unordered_map<Node, uint32_t> index;
+  index.reserve(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    index[topoOrder[i]] = i;
+  }
+  std::vector<uint64_t> cost(count);
+  std::vector<std::vector<uint32_t>> successors(count);
+  std::vector<std::vector<uint32_t>> predecessors(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    cost[i] = topoOrder[i]->EstimateCost();
+    for (auto edge : topoOrder[i]->GetEdges()) {
+      successors[i].push_back(index[edge]);
+      predecessors[index[edge]].push_back(i);
+    }
+  }
+  std::vector<uint32_t> streams = ScheduleGraphStreams(cost, successors, HIP_GRAPH_MAX_STREAMS);
+  const uint32_t numStreams =
+      (count != 0) ? *std::max_element(streams.begin(), streams.end()) + 1 : 0;
+
+  // Each stream runs its nodes in the topological order, the same order as graph launch
+  // enqueues the commands
+  const size_t base = parallelLists.size();
+  parallelLists.resize(base + numStreams);
+  std::vector<uint32_t> position(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    auto& list = parallelLists[base + streams[i]];
+    list.push_back(topoOrder[i]);
+    position[i] = static_cast<uint32_t>(list.size());
+  }
+
+  // Track the last position in every stream, known to be complete before the node starts.
+  // A wait is added only if the predecessor isn't already covered by the stream order or by
+  // an earlier wait, which removes the redundant cross-stream markers
+  std::vector<std::vector<uint32_t>> completed(count, std::vector<uint32_t>(numStreams, 0));
+  std::vector<int64_t> lastOnStream(numStreams, -1);
+  for (uint32_t i = 0; i < count; ++i) {
+    const uint32_t s = streams[i];
+    auto& known = completed[i];
+    if (lastOnStream[s] >= 0) {
+      known = completed[lastOnStream[s]];
+    }
+    known[s] = position[i];
+    // The latest predecessors cover more of the other streams, hence check them first
+    auto& preds = predecessors[i];
+    std::sort(preds.begin(), preds.end(), std::greater<uint32_t>());
+    for (auto pred : preds) {
+      const uint32_t t = streams[pred];
+      if ((t == s) || (position[pred] <= known[t])) {
+        continue;
+      }
+      ClPrint(amd::LOG_INFO, amd::LOG_CODE, "[hipGraph] For %s(%p) - add dependency %s(%p)",
+              GetGraphNodeTypeString(topoOrder[i]->GetType()), topoOrder[i],
+              GetGraphNodeTypeString(topoOrder[pred]->GetType()), topoOrder[pred]);
+      dependencies[topoOrder[i]].push_back(topoOrder[pred]);
+      for (uint32_t k = 0; k < numStreams; ++k) {
+        known[k] = std::max(known[k], completed[pred][k]);
+      }
+    }
+    lastOnStream[s] = i;
+  }
+}
+
 bool Graph::TopologicalOrder(std::vector<Node>& TopoOrder) {
   std::queue<Node> q;
   std::unordered_map<Node, int> inDegree;
+  inDegree.reserve(vertices_.size());
+  TopoOrder.reserve(TopoOrder.size() + vertices_.size());
   for (auto entry : vertices_) {
     if (entry->GetInDegree() == 0) {
       q.push(entry);
@@ -354,129 +387,179 @@ hipError_t GraphExec::Init() {
 
 hipError_t GraphExec::CaptureAQLPackets() {
   hipError_t status = hipSuccess;
-  if (parallelLists_.size() == 1) {
-    size_t kernArgSizeForGraph = 0;
-    // GPU packet capture is enabled for kernel nodes. Calculate the kernel
-    // arg size required for all graph kernel nodes to allocate
-    for (const auto& list : parallelLists_) {
-      for (auto& node : list) {
-        if (node->GetType() == hipGraphNodeTypeKernel) {
-          kernArgSizeForGraph += reinterpret_cast<hip::GraphKernelNode*>(node)->GetKerArgSize();
-        }
-      }
-    }
-
-    auto device = g_devices[ihipGetDevice()]->devices()[0];
-    if (device->info().largeBar_) {
-      // Pad kernel argument buffer with sentinal size bytes to do a readback later
-      kernArgSizeForGraph += sizeof(int);
-      kernarg_pool_graph_ =
-          reinterpret_cast<address>(device->deviceLocalAlloc(kernArgSizeForGraph));
-      device_kernarg_pool_ = true;
-    } else {
-      kernarg_pool_graph_ = reinterpret_cast<address>(
-          device->hostAlloc(kernArgSizeForGraph, 0, amd::Device::MemorySegment::kKernArg));
+  // Assign the branch streams in the same order as the launch does, so every packet is formed
+  // for the HW queue it's dispatched on. The first list is captured on the capture stream
+  UpdateStream(parallelLists_, capture_stream_, this);
+  size_t kernArgSizeForGraph = 0;
+  // GPU packet capture is enabled for kernel nodes. Calculate the kernel
+  // arg size required for all graph kernel nodes to allocate
+  std::vector<hip::GraphKernelNode*> kernelNodes;
+  for (auto& node : topoOrder_) {
+    if (node->GetType() == hipGraphNodeTypeKernel) {
+      auto kernelNode = reinterpret_cast<hip::GraphKernelNode*>(node);
+      kernArgSizeForGraph += kernelNode->GetKerArgSize();
+      kernelNodes.push_back(kernelNode);
     }
+  }
 
-    if (kernarg_pool_graph_ == nullptr) {
+  auto device = g_devices[ihipGetDevice()]->devices()[0];
+  if (device->info().largeBar_) {
+    // Pad kernel argument buffer with sentinal size bytes to do a readback later
+    kernArgSizeForGraph += sizeof(int);
+    kernarg_pool_graph_ =
+        reinterpret_cast<address>(device->deviceLocalAlloc(kernArgSizeForGraph));
+    device_kernarg_pool_ = true;
+  } else {
+    kernarg_pool_graph_ = reinterpret_cast<address>(
+        device->hostAlloc(kernArgSizeForGraph, 0, amd::Device::MemorySegment::kKernArg));
+  }
+
+  if (kernarg_pool_graph_ == nullptr) {
+    return hipErrorMemoryAllocation;
+  }
+  kernarg_pool_size_graph_ = kernArgSizeForGraph;
+
+  // Create the kernel commands in parallel. That validates and captures the kernel arguments,
+  // which is the most expensive part of the packet capture
+  std::vector<hipError_t> createStatus(kernelNodes.size(), hipSuccess);
+  // Worker threads must run with the same current device as the caller
+  hip::Device* cur_device = hip::getCurrentDevice();
+  amd::parallelFor(
+      kernelNodes.size(), HIP_GRAPH_INSTANTIATE_THREADS, kMinNodesPerThread,
+      [&](size_t idx) {
+        createStatus[idx] = kernelNodes[idx]->CreateCommand(kernelNodes[idx]->GetQueue());
+      },
+      [cur_device]() { hip::tls.device_ = cur_device; });
+
+  for (size_t idx = 0; idx < kernelNodes.size(); ++idx) {
+    auto kernelNode = kernelNodes[idx];
+    // From the kernel pool allocate the kern arg size required for the current kernel node.
+    address kernArgOffset = allocKernArg(kernelNode->GetKernargSegmentByteSize(),
+                                         kernelNode->GetKernargSegmentAlignment());
+    if (kernArgOffset == nullptr) {
       return hipErrorMemoryAllocation;
     }
-    kernarg_pool_size_graph_ = kernArgSizeForGraph;
-
-    for (auto& node : topoOrder_) {
-      if (node->GetType() == hipGraphNodeTypeKernel) {
-        auto kernelNode = reinterpret_cast<hip::GraphKernelNode*>(node);
-        // From the kernel pool allocate the kern arg size required for the current kernel node.
-        address kernArgOffset = allocKernArg(kernelNode->GetKernargSegmentByteSize(),
-                                             kernelNode->GetKernargSegmentAlignment());
-        if (kernArgOffset == nullptr) {
-          return hipErrorMemoryAllocation;
+    kernelNode->SetKernArgSlot({kernArgOffset, kernelNode->GetKernargSegmentByteSize()});
+    // Form GPU packet capture for the kernel node in the topological order.
+    kernelNode->FormPacket(kernArgOffset, createStatus[idx]);
+  }
+
+  if (device_kernarg_pool_) {
+    // Write HDP_MEM_COHERENCY_FLUSH_CNTL reg to initiate flush read to HDP mem. Verify mem
+    // by readback of sentinal value at the tail end of the kernarg surface (allocated above)
+    // This needs to be done for PCIE connected devices only. HDP path is disabled for XGMI
+    // between CPU<->GPU
+    if (!device->isXgmi()) {
+      static int host_val = 1;
+      address dev_ptr = kernarg_pool_graph_ + kernarg_pool_size_graph_ - sizeof(int);
+      *dev_ptr = host_val;
+      if (device->info().hdpMemFlushCntl == nullptr) {
+        amd::Command* command = new amd::Marker(*capture_stream_, true);
+        if (command != nullptr) {
+          command->enqueue();
+          command->release();
         }
-        // Form GPU packet capture for the kernel node.
-        kernelNode->CaptureAndFormPacket(capture_stream_, kernArgOffset) ;
-      }
-    }
-
-    if (device_kernarg_pool_) {
-      // Write HDP_MEM_COHERENCY_FLUSH_CNTL reg to initiate flush read to HDP mem. Verify mem
-      // by readback of sentinal value at the tail end of the kernarg surface (allocated above)
-      // This needs to be done for PCIE connected devices only. HDP path is disabled for XGMI
-      // between CPU<->GPU
-      if (!device->isXgmi()) {
-        static int host_val = 1;
-        address dev_ptr = kernarg_pool_graph_ + kernarg_pool_size_graph_ - sizeof(int);
-        *dev_ptr = host_val;
-        if (device->info().hdpMemFlushCntl == nullptr) {
-          amd::Command* command = new amd::Marker(*capture_stream_, true);
-          if (command != nullptr) {
-            command->enqueue();
-            command->release();
-          }
-        } else {
-          *device->info().hdpMemFlushCntl = 1;
-        }
-        while (*dev_ptr != host_val);
-        host_val++;
+      } else {
+        *device->info().hdpMemFlushCntl = 1;
       }
+      while (*dev_ptr != host_val);
+      host_val++;
     }
+  }
 
-    ResetQueueIndex();
+  for (auto kernelNode : kernelNodes) {
+    hip::Stream* stream = kernelNode->GetCaptureStream();
+    capture_queue_generations_[stream] = stream->vdev()->queueGeneration();
   }
+  ResetQueueIndex();
   return status;
 }
 
-hipError_t GraphExec::UpdateAQLPacket(hip::GraphKernelNode* node) {
-  if (parallelLists_.size() == 1) {
-    size_t pool_new_usage = 0;
-    address result = nullptr;
-    if (!kernarg_graph_.empty()) {
-      // 1. Allocate memory for the kernel args
-      size_t kernArgSizeForNode = 0;
-      kernArgSizeForNode = node->GetKerArgSize();
-
-      result = amd::alignUp(kernarg_graph_.back() + kernarg_graph_cur_offset_,
-                            node->GetKernargSegmentAlignment());
-      pool_new_usage = (result + kernArgSizeForNode) - kernarg_graph_.back();
-    }
-    if (pool_new_usage != 0 && pool_new_usage <= kernarg_graph_size_) {
-      kernarg_graph_cur_offset_ = pool_new_usage;
-    } else {
-      address kernarg_graph;
-      auto device = g_devices[ihipGetDevice()]->devices()[0];
-      if (device->info().largeBar_) {
-        kernarg_graph = reinterpret_cast<address>(device->deviceLocalAlloc(kernarg_graph_size_));
-      } else {
-        kernarg_graph = reinterpret_cast<address>(
-            device->hostAlloc(kernarg_graph_size_, 0, amd::Device::MemorySegment::kKernArg));
-      }
-      kernarg_graph_.push_back(kernarg_graph);
-      kernarg_graph_cur_offset_ = 0;
-
-      // 1. Allocate memory for the kernel args
-      size_t kernArgSizeForNode = 0;
-      kernArgSizeForNode = node->GetKerArgSize();
-      result = amd::alignUp(kernarg_graph_.back() + kernarg_graph_cur_offset_,
-                            node->GetKernargSegmentAlignment());
-      const size_t pool_new_usage = (result + kernArgSizeForNode) - kernarg_graph_.back();
-      if (pool_new_usage <= kernarg_graph_size_) {
-        kernarg_graph_cur_offset_ = pool_new_usage;
+hipError_t GraphExec::RefreshAQLPackets() {
+  // The kernel arguments of the captured packets refer to the HW queue of the stream they were
+  // formed on, i.e. the hidden queue pointer. A queue migration makes them stale
+  std::unordered_set<hip::Stream*> migrated;
+  for (auto& it : capture_queue_generations_) {
+    const uint generation = it.first->vdev()->queueGeneration();
+    if (generation != it.second) {
+      it.second = generation;
+      migrated.insert(it.first);
+    }
+  }
+  if (migrated.empty()) {
+    return hipSuccess;
+  }
+  ClPrint(amd::LOG_INFO, amd::LOG_CODE, "[hipGraph] %zu capture streams migrated, form packets "
+          "again", migrated.size());
+  for (auto& node : topoOrder_) {
+    if (node->GetType() == hipGraphNodeTypeKernel &&
+        static_cast<GraphKernelNode*>(node)->IsPacketCaptured() &&
+        migrated.count(static_cast<GraphKernelNode*>(node)->GetCaptureStream()) != 0) {
+      // The arguments move to a new slot, if the previous launch may still read the old one
+      hipError_t status = UpdateAQLPacket(static_cast<GraphKernelNode*>(node));
+      if (status != hipSuccess) {
+        return status;
       }
     }
-
-    // 2. copy kernel args / create new AQL packet
-    node->CaptureAndFormPacket(capture_stream_, result);
   }
   return hipSuccess;
 }
 
+hipError_t GraphExec::UpdateAQLPacket(hip::GraphKernelNode* node) {
+  // The old arguments are patched in place if no launch is in flight. Otherwise they go to
+  // a new slot and the old one is reused, once the launches, which read it, completed
+  auto device = g_devices[ihipGetDevice()]->devices()[0];
+  GraphKernargSlots::Slot slot = kernarg_slots_.Replace(
+      node->GetKernArgSlot(), node->GetKerArgSize(), node->GetKernargSegmentAlignment(),
+      launches_, CompletedLaunches(), [device](size_t size) {
+        return reinterpret_cast<uint8_t*>(device->info().largeBar_ ?
+            device->deviceLocalAlloc(size) :
+            device->hostAlloc(size, 0, amd::Device::MemorySegment::kKernArg));
+      });
+  if (slot.ptr == nullptr) {
+    return hipErrorMemoryAllocation;
+  }
+  node->SetKernArgSlot(slot);
+
+  // The packet is formed again for the HW queue of the node's branch
+  node->CaptureAndFormPacket(node->GetCaptureStream(), slot.ptr);
+  return hipSuccess;
+}
+
+void GraphExec::TrackLaunch(hip::Stream* stream) {
+  ++launches_;
+  // Drop the completed launches, so the list stays bounded by the launches in flight
+  CompletedLaunches();
+  amd::Command* command = stream->getLastQueuedCommand(true);
+  if (command != nullptr) {
+    pending_launches_.emplace_back(launches_, command);
+  }
+}
+
+uint64_t GraphExec::CompletedLaunches() {
+  while (!pending_launches_.empty() &&
+         pending_launches_.front().second->status() == CL_COMPLETE) {
+    pending_launches_.front().second->release();
+    pending_launches_.pop_front();
+  }
+  // The launches before the first pending one completed
+  return pending_launches_.empty() ? launches_ : pending_launches_.front().first - 1;
+}
+
 hipError_t FillCommands(std::vector<std::vector<Node>>& parallelLists,
                         std::unordered_map<Node, std::vector<Node>>& nodeWaitLists,
                         std::vector<Node>& topoOrder, Graph* clonedGraph,
                         amd::Command*& graphStart, amd::Command*& graphEnd, hip::Stream* stream) {
   hipError_t status = hipSuccess;
   for (auto& node : topoOrder) {
-    // TODO: clone commands from next launch
-    status = node->CreateCommand(node->GetQueue());
+    if (node->GetType() == hipGraphNodeTypeKernel && node->GetEnabled() &&
+        static_cast<GraphKernelNode*>(node)->IsPacketCaptured()) {
+      // Dispatch the AQL packet formed at instantiation for the queue of the branch. The command
+      // only tracks the dependencies between the branches
+      status = static_cast<GraphKernelNode*>(node)->CreateCapturedCommand(node->GetQueue());
+    } else {
+      status = node->CreateCommand(node->GetQueue());
+    }
     if (status != hipSuccess) return status;
     amd::Command::EventWaitList waitList;
     for (auto depNode : nodeWaitLists[node]) {
@@ -585,6 +668,10 @@ hipError_t GraphExec::Run(hipStream_t stream) {
     amd::AccumulateCommand* accumulate = nullptr;
     bool isLastPacketKernel = false;
     if (DEBUG_CLR_GRAPH_PACKET_CAPTURE) {
+      status = RefreshAQLPackets();
+      if (status != hipSuccess) {
+        return status;
+      }
       uint8_t* lastCapturedPacket = (topoOrder_.back()->GetType() == hipGraphNodeTypeKernel) ?
                                   topoOrder_.back()->GetAqlPacket() : nullptr;
       accumulate = new amd::AccumulateCommand(*hip_stream, {}, nullptr, lastCapturedPacket);
@@ -623,6 +710,12 @@ hipError_t GraphExec::Run(hipStream_t stream) {
       accumulate->release();
     }
   } else {
+    if (DEBUG_CLR_GRAPH_PACKET_CAPTURE) {
+      status = RefreshAQLPackets();
+      if (status != hipSuccess) {
+        return status;
+      }
+    }
     UpdateStream(parallelLists_, hip_stream, this);
     amd::Command* rootCommand = nullptr;
     amd::Command* endCommand = nullptr;
@@ -643,6 +736,10 @@ hipError_t GraphExec::Run(hipStream_t stream) {
       endCommand->release();
     }
   }
+  if (DEBUG_CLR_GRAPH_PACKET_CAPTURE) {
+    // The captured kernel arguments can't be reused until the launch completed
+    TrackLaunch(hip_stream);
+  }
   ResetQueueIndex();
   return status;
 }
@@ -20,6 +20,7 @@
 
 #pragma once
 #include <algorithm>
+#include <deque>
 #include <queue>
 #include <stack>
 #include <iostream>
@@ -30,6 +31,9 @@
 #include "hip/hip_runtime.h"
 #include "hip_internal.hpp"
 #include "hip_graph_helper.hpp"
+#include "hip_graph_schedule.hpp"
+#include "hip_graph_kernarg.hpp"
+#include "hip_graph_runlist.hpp"
 #include "hip_event.hpp"
 #include "hip_platform.hpp"
 #include "hip_mempool_impl.hpp"
@@ -323,6 +327,9 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
     }
   }
   virtual hipError_t GetNumParallelStreams(size_t &num) { return hipSuccess; }
+  /// Returns estimated execution cost of the node for the stream scheduling, in units of
+  /// a minimal operation on the device
+  virtual uint64_t EstimateCost() const { return 1; }
   /// Enqueue commands part of the node
   virtual void EnqueueCommands(hipStream_t stream) {
     // If the node is disabled it becomes empty node. To maintain ordering just enqueue marker.
@@ -346,6 +353,9 @@ struct GraphNode : public hipGraphNodeDOTAttribute {
   virtual Graph* GetChildGraph() { return nullptr; }
   void SetParentGraph(Graph* graph) { parentGraph_ = graph; }
   virtual hipError_t SetParams(GraphNode* node) { return hipSuccess; }
+  /// Returns true if the parameters match the node of the same type, hence an update of
+  /// the executable graph can skip the node. The check is conservative
+  virtual bool HasSameParams(const GraphNode* node) const { return false; }
   virtual void GenerateDOT(std::ostream& fout, hipGraphDebugDotFlags flag) {}
   virtual void GenerateDOTNode(size_t graphId, std::ostream& fout, hipGraphDebugDotFlags flag) {
     fout << "\n";
@@ -381,6 +391,7 @@ struct Graph {
   hip::MemoryPool* mem_pool_; //!< Memory pool, associated with this graph
   std::unordered_set<GraphNode*> capturedNodes_;
   bool graphInstantiated_;
+  std::atomic<bool> capturing_{false};  //!< The graph is the graph of an active stream capture
 
  public:
   Graph(hip::Device* device, const Graph* original = nullptr)
@@ -409,6 +420,10 @@ struct Graph {
 
   }
 
+  /// Marks the graph as the graph of an active stream capture
+  void SetCapturing(bool capturing) { capturing_.store(capturing, std::memory_order_release); }
+  bool IsCapturing() const { return capturing_.load(std::memory_order_acquire); }
+
   void AddManualNodeDuringCapture(GraphNode* node) { capturedNodes_.insert(node); }
 
   std::unordered_set<GraphNode*> GetManualNodesDuringCapture() { return capturedNodes_; }
@@ -455,11 +470,11 @@ struct Graph {
   // Delete user obj resource from graph
   void RemoveUserObjGraph(UserObject* pUserObj) { graphUserObj_.erase(pUserObj); }
 
-  void GetRunListUtil(Node v, std::unordered_map<Node, bool>& visited,
-                      std::vector<Node>& singleList, std::vector<std::vector<Node>>& parallelLists,
-                      std::unordered_map<Node, std::vector<Node>>& dependencies);
   void GetRunList(std::vector<std::vector<Node>>& parallelLists,
                   std::unordered_map<Node, std::vector<Node>>& dependencies);
+  void ScheduleRunList(const std::vector<Node>& topoOrder,
+                       std::vector<std::vector<Node>>& parallelLists,
+                       std::unordered_map<Node, std::vector<Node>>& dependencies);
   bool TopologicalOrder(std::vector<Node>& TopoOrder);
   void GetUserObjs(std::unordered_set<UserObject*>& graphExeUserObjs) {
     for (auto userObj : graphUserObj_) {
@@ -543,6 +558,7 @@ struct Graph {
     graphInstantiated_ = graphInstantiate;
   }
 };
+
 struct GraphKernelNode;
 struct GraphExec {
   std::vector<std::vector<Node>> parallelLists_;
@@ -564,9 +580,13 @@ struct GraphExec {
   address kernarg_pool_graph_ = nullptr;
   uint32_t kernarg_pool_size_graph_ = 0;
   uint32_t kernarg_pool_cur_graph_offset_ = 0;
-  std::vector<address> kernarg_graph_;
-  uint32_t kernarg_graph_cur_offset_ = 0;
-  uint32_t kernarg_graph_size_ = 128 * Ki;
+  //! Kernel argument slots of the packets, which were formed again after the instantiation
+  GraphKernargSlots kernarg_slots_{128 * Ki};
+  uint64_t launches_ = 0;  //!< The number of the graph launches
+  //! The last command of every launch, which may still be in flight, in the launch order
+  std::deque<std::pair<uint64_t, amd::Command*>> pending_launches_;
+  //! HW queue generation of the captured packets by the capture stream
+  std::unordered_map<hip::Stream*, uint> capture_queue_generations_;
 
  public:
   GraphExec(std::vector<Node>& topoOrder, std::vector<std::vector<Node>>& lists,
@@ -596,10 +616,13 @@ struct GraphExec {
     auto device = g_devices[ihipGetDevice()]->devices()[0];
     if (DEBUG_CLR_GRAPH_PACKET_CAPTURE) {
       device->hostFree(kernarg_pool_graph_, kernarg_pool_size_graph_);
-      for (auto& element : kernarg_graph_) {
-        device->hostFree(element, kernarg_graph_size_);
+      for (auto& chunk : kernarg_slots_.Chunks()) {
+        device->hostFree(chunk.ptr, chunk.size);
       }
     }
+    for (auto& launch : pending_launches_) {
+      launch.second->release();
+    }
     amd::ScopedLock lock(graphExecSetLock_);
     graphExecSet_.erase(this);
     delete clonedGraph_;
@@ -645,6 +668,12 @@ struct GraphExec {
   // Capture GPU Packets from graph commands
   hipError_t CaptureAQLPackets();
   hipError_t UpdateAQLPacket(hip::GraphKernelNode* node);
+  // Tracks the completion of the launch, which was enqueued on the stream
+  void TrackLaunch(hip::Stream* stream);
+  // Returns the number of the first launches, which completed
+  uint64_t CompletedLaunches();
+  // Forms the captured packets again if their capture stream moved to another HW queue
+  hipError_t RefreshAQLPackets();
 };
 
 struct ChildGraphNode : public GraphNode {
@@ -690,6 +719,14 @@ struct ChildGraphNode : public GraphNode {
     return hipSuccess;
   }
 
+  uint64_t EstimateCost() const {
+    uint64_t cost = 1;
+    for (auto& node : childGraph_->GetNodes()) {
+      cost += node->EstimateCost();
+    }
+    return cost;
+  }
+
   void SetStream(hip::Stream* stream, GraphExec* ptr = nullptr) {
     stream_ = stream;
     UpdateStream(parallelLists_, stream, ptr);
@@ -778,9 +815,26 @@ class GraphKernelNode : public GraphNode {
   size_t alignedKernArgSize_;          //!< Aligned size required for kernel args
   size_t kernargSegmentByteSize_;      //!< Kernel arg segment byte size
   size_t kernargSegmentAlignment_;     //!< Kernel arg segment alignment
+  bool packetCaptured_ = false;        //!< AQL packet and kernel args are formed for launches
+  size_t paramsSize_ = 0;              //!< Size of the allocation with the copied kernel args
+  hip::Stream* captureStream_ = nullptr;  //!< Stream of the HW queue the packet is formed for
+  GraphKernargSlots::Slot kernArgSlot_;   //!< Kernel arguments of the captured packet
 
  public:
   size_t GetKerArgSize() const { return alignedKernArgSize_; }
+  bool IsPacketCaptured() const { return packetCaptured_; }
+  hip::Stream* GetCaptureStream() const { return captureStream_; }
+  const GraphKernargSlots::Slot& GetKernArgSlot() const { return kernArgSlot_; }
+  void SetKernArgSlot(const GraphKernargSlots::Slot& slot) { kernArgSlot_ = slot; }
+  uint64_t EstimateCost() const {
+    // A unit of cost is roughly a wave of work-items on the whole device
+    constexpr uint64_t kWorkItemsPerUnit = 256 * Ki;
+    const uint64_t workItems =
+        static_cast<uint64_t>(kernelParams_.gridDim.x) * kernelParams_.gridDim.y *
+        kernelParams_.gridDim.z * kernelParams_.blockDim.x * kernelParams_.blockDim.y *
+        kernelParams_.blockDim.z;
+    return 1 + workItems / kWorkItemsPerUnit;
+  }
   size_t GetKernargSegmentByteSize() const { return kernargSegmentByteSize_; }
   size_t GetKernargSegmentAlignment() const { return kernargSegmentAlignment_; }
   void PrintAttributes(std::ostream& out, hipGraphDebugDotFlags flag) {
@@ -804,6 +858,14 @@ class GraphKernelNode : public GraphNode {
 
   void CaptureAndFormPacket(hip::Stream* capture_stream, address kernArgOffset) {
     hipError_t status = CreateCommand(capture_stream);
+    FormPacket(kernArgOffset, status);
+  }
+
+  // Forms GPU packet from the command, created with CreateCommand(). The command creation
+  // captures the kernel arguments and can run on any thread, but the packet forming submits
+  // to the capture stream and must be serialized
+  void FormPacket(address kernArgOffset, hipError_t status) {
+    captureStream_ = stream_;
     for (auto& command : commands_) {
       reinterpret_cast<amd::NDRangeKernelCommand*>(command)->setCapturingState(
           true, GetAqlPacket(), kernArgOffset);
@@ -815,6 +877,25 @@ class GraphKernelNode : public GraphNode {
       SetKernelName(reinterpret_cast<amd::NDRangeKernelCommand*>(command)->kernel().name());
       command->release();
     }
+    packetCaptured_ = (status == hipSuccess);
+  }
+
+  // Creates a command, which dispatches the captured AQL packet on the stream of the branch.
+  // The kernel arguments were copied at capture, hence the launch skips the argument capture
+  // and validation
+  hipError_t CreateCapturedCommand(hip::Stream* stream) {
+    hipError_t status = GraphNode::CreateCommand(stream);
+    if (status != hipSuccess) {
+      return status;
+    }
+    amd::AccumulateCommand* command =
+        new amd::AccumulateCommand(*stream, {}, nullptr, GetAqlPacket());
+    if (command == nullptr) {
+      return hipErrorOutOfMemory;
+    }
+    command->addKernelName(GetKernelName());
+    commands_.emplace_back(command);
+    return hipSuccess;
   }
 
   std::string GetLabel(hipGraphDebugDotFlags flag) {
@@ -904,48 +985,23 @@ class GraphKernelNode : public GraphNode {
     const amd::KernelSignature& signature = kernel->signature();
     numParams_ = signature.numParameters();
 
-    // Allocate/assign memory if params are passed part of 'kernelParams'
+    // Allocate/assign memory if params are passed part of 'kernelParams'. The pointer array
+    // and all arguments share a single allocation to avoid a heap call per argument
     if (pNodeParams->kernelParams != nullptr) {
-      kernelParams_.kernelParams = (void**)malloc(numParams_ * sizeof(void*));
+      kernelParams_.kernelParams = CopyKernelParams(
+          pNodeParams->kernelParams, numParams_,
+          [&signature](uint32_t i) { return signature.at(i).size_; }, &paramsSize_);
       if (kernelParams_.kernelParams == nullptr) {
         return hipErrorOutOfMemory;
       }
-
-      for (uint32_t i = 0; i < numParams_; ++i) {
-        const amd::KernelParameterDescriptor& desc = signature.at(i);
-        kernelParams_.kernelParams[i] = malloc(desc.size_);
-        if (kernelParams_.kernelParams[i] == nullptr) {
-          return hipErrorOutOfMemory;
-        }
-        ::memcpy(kernelParams_.kernelParams[i], (pNodeParams->kernelParams[i]), desc.size_);
-      }
     }
-
-    // Allocate/assign memory if params are passed as part of 'extra'
+    // Allocate/assign memory if params are passed as part of 'extra'. The struct, the size and
+    // the kernargs share a single allocation
     else if (pNodeParams->extra != nullptr) {
-      // 'extra' is a struct that contains the following info: {
-      // HIP_LAUNCH_PARAM_BUFFER_POINTER, kernargs,
-      // HIP_LAUNCH_PARAM_BUFFER_SIZE, &kernargs_size,
-      // HIP_LAUNCH_PARAM_END }
-      unsigned int numExtra = 5;
-      kernelParams_.extra = (void**)malloc(numExtra * sizeof(void*));
+      kernelParams_.extra = CopyKernelExtra(pNodeParams->extra, &paramsSize_);
       if (kernelParams_.extra == nullptr) {
         return hipErrorOutOfMemory;
       }
-      kernelParams_.extra[0] = pNodeParams->extra[0];
-      size_t kernargs_size = *((size_t*)pNodeParams->extra[3]);
-      kernelParams_.extra[1] = malloc(kernargs_size);
-      if (kernelParams_.extra[1] == nullptr) {
-        return hipErrorOutOfMemory;
-      }
-      kernelParams_.extra[2] = pNodeParams->extra[2];
-      kernelParams_.extra[3] = malloc(sizeof(void*));
-      if (kernelParams_.extra[3] == nullptr) {
-        return hipErrorOutOfMemory;
-      }
-      *((size_t*)kernelParams_.extra[3]) = kernargs_size;
-      ::memcpy(kernelParams_.extra[1], (pNodeParams->extra[1]), kernargs_size);
-      kernelParams_.extra[4] = pNodeParams->extra[4];
     }
     return hipSuccess;
   }
@@ -967,25 +1023,18 @@ class GraphKernelNode : public GraphNode {
   ~GraphKernelNode() { freeParams(); }
 
   void freeParams() {
-    // Deallocate memory allocated for kernargs passed via 'kernelParams'
+    // Deallocate memory allocated for kernargs passed via 'kernelParams'.
+    // The arguments are stored in the same allocation
     if (kernelParams_.kernelParams != nullptr) {
-      for (size_t i = 0; i < numParams_; ++i) {
-        if (kernelParams_.kernelParams[i] != nullptr) {
-          free(kernelParams_.kernelParams[i]);
-        }
-        kernelParams_.kernelParams[i] = nullptr;
-      }
       free(kernelParams_.kernelParams);
       kernelParams_.kernelParams = nullptr;
     }
     // Deallocate memory allocated for kernargs passed via 'extra'
     else if (kernelParams_.extra != nullptr) {
-      free(kernelParams_.extra[1]);
-      free(kernelParams_.extra[3]);
-      memset(kernelParams_.extra, 0, 5 * sizeof(kernelParams_.extra[0]));  // 5 items
       free(kernelParams_.extra);
       kernelParams_.extra = nullptr;
     }
+    paramsSize_ = 0;
   }
 
   GraphKernelNode(const GraphKernelNode& rhs) : GraphNode(rhs) {
@@ -1008,9 +1057,16 @@ class GraphKernelNode : public GraphNode {
   }
 
   hipError_t CreateCommand(hip::Stream* stream) {
-    hipFunction_t func = nullptr;
-    hipError_t status = validateKernelParams(&kernelParams_, &func,
-                                             stream ? hip::getDeviceID(stream->context()) : -1);
+    const int devId = stream ? hip::getDeviceID(stream->context()) : ihipGetDevice();
+    hipFunction_t func = getFunc(kernelParams_, devId);
+    if (!func) {
+      return hipErrorInvalidDeviceFunction;
+    }
+    // Validation sets the arguments on the kernel object shared by all launches of the function,
+    // hence hold the function lock until the command captured them. Instantiation creates the
+    // commands of the graph concurrently
+    amd::ScopedLock lock(hip::DeviceFunc::asFunction(func)->dflock_);
+    hipError_t status = validateKernelParams(&kernelParams_, nullptr, devId);
     if (hipSuccess != status) {
       return status;
     }
@@ -1141,6 +1197,35 @@ class GraphKernelNode : public GraphNode {
     return SetParams(&kernelNode->kernelParams_);
   }
 
+  bool HasSameParams(const GraphNode* node) const {
+    const GraphKernelNode* kernelNode = static_cast<GraphKernelNode const*>(node);
+    const hipKernelNodeParams& params = kernelNode->kernelParams_;
+    if ((kernelParams_.func != params.func) ||
+        (kernelParams_.sharedMemBytes != params.sharedMemBytes) ||
+        (kernelParams_.gridDim.x != params.gridDim.x) ||
+        (kernelParams_.gridDim.y != params.gridDim.y) ||
+        (kernelParams_.gridDim.z != params.gridDim.z) ||
+        (kernelParams_.blockDim.x != params.blockDim.x) ||
+        (kernelParams_.blockDim.y != params.blockDim.y) ||
+        (kernelParams_.blockDim.z != params.blockDim.z) ||
+        (paramsSize_ != kernelNode->paramsSize_) ||
+        ((kernelParams_.kernelParams == nullptr) != (params.kernelParams == nullptr)) ||
+        ((kernelParams_.extra == nullptr) != (params.extra == nullptr))) {
+      return false;
+    }
+    if (kernelParams_.kernelParams != nullptr) {
+      // The arguments follow the pointer array in the same allocation
+      const size_t offset = KernelParamsDataOffset(numParams_);
+      return ::memcmp(reinterpret_cast<const_address>(kernelParams_.kernelParams) + offset,
+                      reinterpret_cast<const_address>(params.kernelParams) + offset,
+                      paramsSize_ - offset) == 0;
+    } else if (kernelParams_.extra != nullptr) {
+      return ::memcmp(kernelParams_.extra[1], params.extra[1],
+                      *reinterpret_cast<const size_t*>(kernelParams_.extra[3])) == 0;
+    }
+    return true;
+  }
+
   static hipError_t validateKernelParams(const hipKernelNodeParams* pNodeParams,
                                          hipFunction_t* ptrFunc = nullptr, int devId = -1) {
     devId = devId == -1 ? ihipGetDevice() : devId;
@@ -1180,6 +1265,14 @@ class GraphMemcpyNode : public GraphNode {
   }
   ~GraphMemcpyNode() {}
 
+  uint64_t EstimateCost() const {
+    constexpr uint64_t kBytesPerUnit = 1 * Mi;
+    const uint64_t bytes = static_cast<uint64_t>(copyParams_.extent.width) *
+        std::max<size_t>(copyParams_.extent.height, 1) *
+        std::max<size_t>(copyParams_.extent.depth, 1);
+    return 1 + bytes / kBytesPerUnit;
+  }
+
   GraphMemcpyNode(const GraphMemcpyNode& rhs) : GraphNode(rhs) {
     copyParams_ = rhs.copyParams_;
   }
@@ -1343,6 +1436,11 @@ class GraphMemcpyNode1D : public GraphMemcpyNode {
     return new GraphMemcpyNode1D(static_cast<GraphMemcpyNode1D const&>(*this));
   }
 
+  uint64_t EstimateCost() const {
+    constexpr uint64_t kBytesPerUnit = 1 * Mi;
+    return 1 + count_ / kBytesPerUnit;
+  }
+
   virtual hipError_t CreateCommand(hip::Stream* stream) {
     if ((kind_ == hipMemcpyHostToHost || kind_ == hipMemcpyDefault) && IsHtoHMemcpy(dst_, src_)) {
       return hipSuccess;
@@ -1702,6 +1800,14 @@ class GraphMemsetNode : public GraphNode {
     return new GraphMemsetNode(static_cast<GraphMemsetNode const&>(*this));
   }
 
+  uint64_t EstimateCost() const {
+    // Fill writes only, hence it's cheaper than a copy of the same size
+    constexpr uint64_t kBytesPerUnit = 2 * Mi;
+    const uint64_t bytes = static_cast<uint64_t>(memsetParams_.width) *
+        std::max<size_t>(memsetParams_.height, 1) * memsetParams_.elementSize;
+    return 1 + bytes / kBytesPerUnit;
+  }
+
   std::string GetLabel(hipGraphDebugDotFlags flag) {
     std::string label;
     if (flag == hipGraphDebugDotFlagsMemsetNodeParams || flag == hipGraphDebugDotFlagsVerbose) {
@@ -1845,6 +1951,14 @@ class GraphMemsetNode : public GraphNode {
     const GraphMemsetNode* memsetNode = static_cast<GraphMemsetNode const*>(node);
     return SetParams(&memsetNode->memsetParams_);
   }
+
+  bool HasSameParams(const GraphNode* node) const {
+    const hipMemsetParams& params = static_cast<GraphMemsetNode const*>(node)->memsetParams_;
+    return (memsetParams_.dst == params.dst) && (memsetParams_.value == params.value) &&
+        (memsetParams_.elementSize == params.elementSize) &&
+        (memsetParams_.width == params.width) && (memsetParams_.height == params.height) &&
+        (memsetParams_.pitch == params.pitch);
+  }
 };
 
 class GraphEventRecordNode : public GraphNode {
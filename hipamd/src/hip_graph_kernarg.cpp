@@ -0,0 +1,125 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_graph_kernarg.hpp"
+#include <algorithm>
+
+namespace hip {
+
+static inline bool IsAligned(const uint8_t* ptr, size_t alignment) {
+  return (reinterpret_cast<uintptr_t>(ptr) % alignment) == 0;
+}
+
+// ================================================================================================
+GraphKernargSlots::Slot GraphKernargSlots::Replace(const Slot& old, size_t size, size_t alignment,
+                                                   uint64_t launches, uint64_t completed,
+                                                   const ChunkAlloc& chunkAlloc) {
+  alignment = std::max<size_t>(alignment, 1);
+  Reclaim(completed);
+  // No launch reads the old arguments, hence the packet can be formed again in place
+  if ((completed >= launches) && (old.ptr != nullptr) && (old.size >= size) &&
+      IsAligned(old.ptr, alignment)) {
+    return old;
+  }
+  Slot slot = Alloc(size, alignment, chunkAlloc);
+  if ((slot.ptr != nullptr) && (old.ptr != nullptr)) {
+    if (completed >= launches) {
+      free_.push_back(old);
+    } else {
+      retired_.emplace_back(launches, old);
+    }
+  }
+  return slot;
+}
+
+// ================================================================================================
+GraphKernargSlots::Slot GraphKernargSlots::Alloc(size_t size, size_t alignment,
+                                                 const ChunkAlloc& chunkAlloc) {
+  // The nodes are usually updated with the same kernel, so the first fit is the old size
+  for (auto it = free_.begin(); it != free_.end(); ++it) {
+    if ((it->size >= size) && IsAligned(it->ptr, alignment)) {
+      Slot slot = *it;
+      *it = free_.back();
+      free_.pop_back();
+      return slot;
+    }
+  }
+
+  // Carve the slot from the last chunk, allocate a new chunk if it doesn't fit
+  auto carve = [this, size, alignment]() {
+    Slot slot;
+    if (!chunks_.empty()) {
+      const Slot& chunk = chunks_.back();
+      const uintptr_t base = reinterpret_cast<uintptr_t>(chunk.ptr);
+      const uintptr_t start = (base + offset_ + alignment - 1) / alignment * alignment;
+      if ((start - base + size) <= chunk.size) {
+        slot.ptr = chunk.ptr + (start - base);
+        slot.size = size;
+        offset_ = start - base + size;
+      }
+    }
+    return slot;
+  };
+  Slot slot = carve();
+  if (slot.ptr == nullptr) {
+    Slot chunk;
+    chunk.size = std::max(chunkSize_, size + alignment - 1);
+    chunk.ptr = chunkAlloc(chunk.size);
+    if (chunk.ptr != nullptr) {
+      chunks_.push_back(chunk);
+      offset_ = 0;
+      slot = carve();
+    }
+  }
+  return slot;
+}
+
+// ================================================================================================
+void GraphKernargSlots::Reclaim(uint64_t completed) {
+  // The slots are retired in the launch order
+  while (!retired_.empty() && (retired_.front().first <= completed)) {
+    free_.push_back(retired_.front().second);
+    retired_.pop_front();
+  }
+}
+
+// ================================================================================================
+void** CopyKernelExtra(void* const* extra, size_t* totalSize) {
+  constexpr size_t kNumExtra = 5;
+  // The struct and the size are followed by the kernargs
+  const size_t headerSize = AlignKernelParam(kNumExtra * sizeof(void*) + sizeof(size_t));
+  const size_t kernargsSize = *reinterpret_cast<const size_t*>(extra[3]);
+  void** copy = reinterpret_cast<void**>(malloc(headerSize + kernargsSize));
+  if (copy == nullptr) {
+    return nullptr;
+  }
+  uint8_t* data = reinterpret_cast<uint8_t*>(copy);
+  copy[0] = extra[0];
+  copy[1] = data + headerSize;
+  copy[2] = extra[2];
+  copy[3] = data + kNumExtra * sizeof(void*);
+  copy[4] = extra[4];
+  *reinterpret_cast<size_t*>(copy[3]) = kernargsSize;
+  memcpy(copy[1], extra[1], kernargsSize);
+  *totalSize = headerSize + kernargsSize;
+  return copy;
+}
+
+}  // namespace hip
@@ -0,0 +1,123 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace hip {
+
+/// Kernel argument slots of the captured kernel nodes, which formed their AQL packets again
+/// after the instantiation. The new slots are carved from chunks of a fixed size. A replaced
+/// slot may still be read by the graph launches in flight, hence it's retired with the launch
+/// count and reused, once all those launches completed. The memory stays bounded by the
+/// arguments of the nodes and of the launches in flight
+class GraphKernargSlots {
+ public:
+  struct Slot {
+    uint8_t* ptr = nullptr;
+    size_t size = 0;
+  };
+  /// Allocates a chunk of kernel argument memory of the requested size
+  typedef std::function<uint8_t*(size_t)> ChunkAlloc;
+
+  explicit GraphKernargSlots(size_t chunkSize) : chunkSize_(chunkSize) {}
+
+  /// Returns the slot for the new arguments of a node, which used the old slot. The old slot
+  /// is patched in place, if it fits and all launches completed, i.e. completed == launches.
+  /// Otherwise the old slot is retired with launches and a new one is allocated.
+  /// Returns an empty slot on an allocation failure and keeps the old slot
+  Slot Replace(const Slot& old, size_t size, size_t alignment, uint64_t launches,
+               uint64_t completed, const ChunkAlloc& chunkAlloc);
+
+  /// Returns the allocated chunks, which are released with the graph
+  const std::vector<Slot>& Chunks() const { return chunks_; }
+  /// Returns the number of the slots, which are ready for reuse
+  size_t NumFree() const { return free_.size(); }
+  /// Returns the number of the slots, which wait for the launches
+  size_t NumRetired() const { return retired_.size(); }
+
+ private:
+  /// Returns a free slot or a slot from the current chunk, allocates a new chunk if it's full
+  Slot Alloc(size_t size, size_t alignment, const ChunkAlloc& chunkAlloc);
+  /// Moves the retired slots, which no pending launch reads, to the free slots
+  void Reclaim(uint64_t completed);
+
+  size_t chunkSize_;                                   //!< Size of a new chunk
+  std::vector<Slot> chunks_;                           //!< Allocated chunks
+  size_t offset_ = 0;                                  //!< Used bytes of the last chunk
+  std::vector<Slot> free_;                             //!< Slots, ready for reuse
+  std::deque<std::pair<uint64_t, Slot>> retired_;      //!< Slots and the launches, which read them
+};
+
+/// Alignment of every copied kernel argument of a graph kernel node
+constexpr size_t kKernelParamAlignment = alignof(std::max_align_t);
+
+/// Returns the size aligned to kKernelParamAlignment
+inline size_t AlignKernelParam(size_t size) {
+  return (size + kKernelParamAlignment - 1) & ~(kKernelParamAlignment - 1);
+}
+
+/// Returns the offset of the first argument after the pointer array of the copied arguments
+inline size_t KernelParamsDataOffset(uint32_t numParams) {
+  return AlignKernelParam(numParams * sizeof(void*));
+}
+
+/// Copies the kernel arguments into a single allocation, which starts with the argument
+/// pointers. sizeOf(i) returns the size of the argument i. The padding is cleared, so two copies
+/// of the same arguments compare bytewise. Returns the allocation, released with free(), and
+/// its size in totalSize, or nullptr on an allocation failure
+template <typename SizeOf>
+void** CopyKernelParams(void* const* params, uint32_t numParams, SizeOf sizeOf,
+                        size_t* totalSize) {
+  size_t size = KernelParamsDataOffset(numParams);
+  for (uint32_t i = 0; i < numParams; ++i) {
+    size += AlignKernelParam(sizeOf(i));
+  }
+  void** copy = reinterpret_cast<void**>(malloc(std::max(size, sizeof(void*))));
+  if (copy == nullptr) {
+    return nullptr;
+  }
+  memset(copy, 0, size);
+  uint8_t* argData = reinterpret_cast<uint8_t*>(copy) + KernelParamsDataOffset(numParams);
+  for (uint32_t i = 0; i < numParams; ++i) {
+    copy[i] = argData;
+    memcpy(argData, params[i], sizeOf(i));
+    argData += AlignKernelParam(sizeOf(i));
+  }
+  *totalSize = size;
+  return copy;
+}
+
+/// Copies the 'extra' launch arguments { HIP_LAUNCH_PARAM_BUFFER_POINTER, kernargs,
+/// HIP_LAUNCH_PARAM_BUFFER_SIZE, &kernargs_size, HIP_LAUNCH_PARAM_END } with the kernargs and
+/// their size into a single allocation. Returns the allocation, released with free(), and its
+/// size in totalSize, or nullptr on an allocation failure
+void** CopyKernelExtra(void* const* extra, size_t* totalSize);
+
+}  // namespace hip
@@ -0,0 +1,104 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace hip {
+
+/// Splits the nodes of a graph into the lists, which run in order on one stream. The lists
+/// follow a depth first traversal of the vertices. A visited node either merges the current
+/// list into the list it heads or becomes a dependency of the current node. Node provides its
+/// successors with GetEdges(). onDependency(node, dependency) is called for every added
+/// dependency. The traversal keeps an explicit stack, so deep graphs don't overflow the thread
+/// stack, and runs in O(V+E), excluding the list merges
+template <typename Node, typename OnDependency>
+void BuildRunLists(const std::vector<Node>& vertices,
+                   std::vector<std::vector<Node>>& parallelLists,
+                   std::unordered_map<Node, std::vector<Node>>& dependencies,
+                   OnDependency onDependency) {
+  // The first node of every list, used to merge the lists
+  std::unordered_map<Node, size_t> listHeads;
+  for (size_t i = 0; i < parallelLists.size(); i++) {
+    listHeads[parallelLists[i][0]] = i;
+  }
+  std::unordered_map<Node, bool> visited;
+  visited.reserve(vertices.size());
+  for (auto node : vertices) visited[node] = false;
+
+  std::vector<Node> singleList;
+  // Stack of the nodes and the next edge to visit
+  std::vector<std::pair<Node, size_t>> stack;
+  for (auto v : vertices) {
+    if (visited[v]) {
+      continue;
+    }
+    visited[v] = true;
+    singleList.push_back(v);
+    stack.emplace_back(v, 0);
+    while (!stack.empty()) {
+      Node node = stack.back().first;
+      const auto& edges = node->GetEdges();
+      if (stack.back().second == edges.size()) {
+        // All adjacent vertices were visited, close the current list
+        if (!singleList.empty()) {
+          listHeads[singleList[0]] = parallelLists.size();
+          parallelLists.push_back(singleList);
+          singleList.clear();
+        }
+        stack.pop_back();
+        continue;
+      }
+      Node adjNode = edges[stack.back().second++];
+      if (!visited[adjNode]) {
+        // For the parallel list nodes add parent as the dependency
+        if (singleList.empty()) {
+          onDependency(adjNode, node);
+          dependencies[adjNode].push_back(node);
+        }
+        visited[adjNode] = true;
+        singleList.push_back(adjNode);
+        stack.emplace_back(adjNode, 0);
+      } else {
+        // Merge singleList when adjNode matches with the first element of an existing list
+        auto head = listHeads.find(adjNode);
+        if ((head != listHeads.end()) && !singleList.empty()) {
+          size_t index = head->second;
+          auto& list = parallelLists[index];
+          list.insert(list.begin(), singleList.begin(), singleList.end());
+          listHeads.erase(head);
+          listHeads[list[0]] = index;
+          singleList.clear();
+        }
+        // If the list cannot be merged with the existing list add as dependancy
+        if (!singleList.empty()) {
+          onDependency(adjNode, node);
+          dependencies[adjNode].push_back(node);
+        }
+      }
+    }
+  }
+}
+
+}  // namespace hip
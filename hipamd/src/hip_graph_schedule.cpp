@@ -0,0 +1,109 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "hip_graph_schedule.hpp"
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+// ================================================================================================
+std::vector<uint32_t> ScheduleGraphStreams(const std::vector<uint64_t>& cost,
+                                           const std::vector<std::vector<uint32_t>>& successors,
+                                           uint32_t maxStreams) {
+  // The cost of a wait on another stream, in the same units as the node cost
+  constexpr uint64_t kCrossStreamCost = 1;
+  const size_t count = cost.size();
+  std::vector<uint32_t> streams(count, 0);
+  if ((count == 0) || (maxStreams <= 1)) {
+    return streams;
+  }
+
+  std::vector<std::vector<uint32_t>> predecessors(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    for (auto succ : successors[i]) {
+      predecessors[succ].push_back(i);
+    }
+  }
+
+  // The longest path from the node to the end of the graph, including the node itself
+  std::vector<uint64_t> level(count, 0);
+  for (size_t i = count; i-- > 0;) {
+    uint64_t succLevel = 0;
+    for (auto succ : successors[i]) {
+      succLevel = std::max(succLevel, level[succ]);
+    }
+    level[i] = cost[i] + succLevel;
+  }
+
+  // Schedule the ready nodes on the critical path first. Ties keep the topological order
+  auto lower = [&level](uint32_t a, uint32_t b) {
+    return (level[a] < level[b]) || ((level[a] == level[b]) && (a > b));
+  };
+  std::priority_queue<uint32_t, std::vector<uint32_t>, decltype(lower)> ready(lower);
+  std::vector<size_t> pending(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    pending[i] = predecessors[i].size();
+    if (pending[i] == 0) {
+      ready.push(i);
+    }
+  }
+
+  std::vector<uint64_t> finish(count, 0);
+  std::vector<uint64_t> streamTime;  // Estimated time, when each stream becomes idle
+  streamTime.reserve(maxStreams);
+  while (!ready.empty()) {
+    uint32_t node = ready.top();
+    ready.pop();
+    uint64_t readyTime = 0;
+    for (auto pred : predecessors[node]) {
+      readyTime = std::max(readyTime, finish[pred]);
+    }
+    // Pick the stream with the earliest start. A new stream is considered last, so the
+    // existing streams win the ties and the stream count stays low
+    uint32_t best = 0;
+    uint64_t bestStart = std::numeric_limits<uint64_t>::max();
+    const uint32_t numCandidates =
+        std::min<uint32_t>(static_cast<uint32_t>(streamTime.size()) + 1, maxStreams);
+    for (uint32_t s = 0; s < numCandidates; ++s) {
+      uint64_t start = std::max(readyTime, (s < streamTime.size()) ? streamTime[s] : 0);
+      for (auto pred : predecessors[node]) {
+        if (streams[pred] != s) {
+          start += kCrossStreamCost;
+        }
+      }
+      if (start < bestStart) {
+        best = s;
+        bestStart = start;
+      }
+    }
+    if (best == streamTime.size()) {
+      streamTime.push_back(0);
+    }
+    streams[node] = best;
+    finish[node] = bestStart + cost[node];
+    streamTime[best] = finish[node];
+    for (auto succ : successors[node]) {
+      if (--pending[succ] == 0) {
+        ready.push(succ);
+      }
+    }
+  }
+  return streams;
+}
@@ -51,5 +51,5 @@ const char* hipApiName(uint32_t id) { return hip_api_name(id); }
 
 extern "C" void hipRegisterTracerCallback(int (*function)(activity_domain_t domain,
                                                           uint32_t operation_id, void* data)) {
-  activity_prof::report_activity.store(function, std::memory_order_relaxed);
+  activity_prof::RegisterReportActivity(function);
 }
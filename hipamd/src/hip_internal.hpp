@@ -29,9 +29,12 @@
 #include "hip_graph_capture.hpp"
 
 #include <unordered_set>
+#include <map>
+#include <tuple>
 #include <thread>
 #include <stack>
 #include <mutex>
+#include <atomic>
 #include <iterator>
 #ifdef _WIN32
 #include <process.h>
@@ -95,10 +98,12 @@ const char* ihipGetErrorName(hipError_t hip_error);
 
 #define HIP_INIT(noReturn)                                                                         \
   {                                                                                                \
-    bool status = true;                                                                            \
-    std::call_once(g_ihipInitialized, hip::init, &status);                                         \
-    if (!status && !noReturn) {                                                                    \
-      HIP_RETURN(hipErrorInvalidDevice);                                                           \
+    if (unlikely(!hip::g_initialized.load(std::memory_order_acquire))) {                           \
+      bool status = true;                                                                          \
+      std::call_once(g_ihipInitialized, hip::init, &status);                                       \
+      if (!status && !noReturn) {                                                                  \
+        HIP_RETURN(hipErrorInvalidDevice);                                                         \
+      }                                                                                            \
     }                                                                                              \
     if (hip::tls.device_ == nullptr && hip::g_devices.size() > 0) {                                \
       hip::tls.device_ = hip::g_devices[0];                                                        \
@@ -108,8 +113,10 @@ const char* ihipGetErrorName(hipError_t hip_error);
 
 #define HIP_INIT_VOID()                                                                            \
   {                                                                                                \
-    bool status = true;                                                                            \
-    std::call_once(g_ihipInitialized, hip::init, &status);                                         \
+    if (unlikely(!hip::g_initialized.load(std::memory_order_acquire))) {                           \
+      bool status = true;                                                                          \
+      std::call_once(g_ihipInitialized, hip::init, &status);                                       \
+    }                                                                                              \
     if (hip::tls.device_ == nullptr && hip::g_devices.size() > 0) {                           \
       hip::tls.device_ = hip::g_devices[0];                                                   \
       amd::Os::setPreferredNumaNode(hip::g_devices[0]->devices()[0]->getPreferredNumaNode()); \
@@ -119,13 +126,19 @@ const char* ihipGetErrorName(hipError_t hip_error);
 
 #define HIP_API_PRINT(...)                                          \
   uint64_t startTimeUs=0;                                           \
-  HIPPrintDuration(amd::LOG_INFO, amd::LOG_API, &startTimeUs,       \
-                  "%s %s ( %s ) %s", KGRN,                          \
-                  __func__, ToString( __VA_ARGS__ ).c_str(), KNRM);
+  if (unlikely(hip::IsInstrumented(hip::kApiLog))) {                \
+    HIPPrintDuration(amd::LOG_INFO, amd::LOG_API, &startTimeUs,     \
+                    "%s %s ( %s ) %s", KGRN,                        \
+                    __func__, ToString( __VA_ARGS__ ).c_str(), KNRM); \
+  }
 
 #define HIP_ERROR_PRINT(err, ...)                                                  \
-  ClPrint(amd::LOG_INFO, amd::LOG_API, "%s: Returned %s : %s",                     \
-          __func__, hip::ihipGetErrorName(err), ToString( __VA_ARGS__ ).c_str());
+  do {                                                                             \
+    if (unlikely(hip::IsInstrumented(hip::kApiLog))) {                             \
+      ClPrint(amd::LOG_INFO, amd::LOG_API, "%s: Returned %s : %s",                 \
+              __func__, hip::ihipGetErrorName(err), ToString( __VA_ARGS__ ).c_str()); \
+    }                                                                              \
+  } while (false);
 
 #define HIP_INIT_API_INTERNAL(noReturn, cid, ...)                                                  \
   amd::Thread* thread = amd::Thread::current();                                                    \
@@ -153,8 +166,10 @@ const char* ihipGetErrorName(hipError_t hip_error);
 
 #define HIP_RETURN_DURATION(ret, ...)                                                              \
   hip::tls.last_error_ = ret;                                                                      \
-  HIPPrintDuration(amd::LOG_INFO, amd::LOG_API, &startTimeUs, "%s: Returned %s : %s", __func__,    \
-                   hip::ihipGetErrorName(hip::tls.last_error_), ToString(__VA_ARGS__).c_str());    \
+  if (unlikely(hip::IsInstrumented(hip::kApiLog))) {                                               \
+    HIPPrintDuration(amd::LOG_INFO, amd::LOG_API, &startTimeUs, "%s: Returned %s : %s", __func__,  \
+                     hip::ihipGetErrorName(hip::tls.last_error_), ToString(__VA_ARGS__).c_str());  \
+  }                                                                                                \
   return hip::tls.last_error_;
 
 #define HIP_RETURN(ret, ...)                      \
@@ -447,6 +462,11 @@ public:
 
     std::set<MemoryPool*> mem_pools_;
 
+    /// Sampler state: normalized coords, addressing, filter and mip filter modes, min/max lod
+    typedef std::tuple<bool, uint32_t, uint32_t, uint32_t, float, float> SamplerState;
+    /// Samplers shared between all texture objects with the same state on this device
+    std::map<SamplerState, amd::Sampler*> samplers_;
+
   public:
     Device(amd::Context* ctx, int devId): context_(ctx),
         deviceId_(devId),
@@ -534,6 +554,9 @@ public:
     /// Removes a destroyed stream from the safe list of memory pools
     void RemoveStreamFromPools(Stream* stream);
 
+    /// Returns a retained sampler with the requested state, shared between texture objects
+    amd::Sampler* AcquireSampler(bool normCoords, uint32_t addrMode, uint32_t filterMode,
+                                 uint32_t mipFilterMode, float minLod, float maxLod);
   };
 
   /// Thread Local Storage Variables Aggregator Class
@@ -561,6 +584,30 @@ public:
 
   extern void init(bool* status);
 
+  /// Set after a successful init(), so API entries can skip std::call_once
+  extern std::atomic<bool> g_initialized;
+
+  /// Instrumentation, active on the API entry and return. API tracing has its own
+  /// check of the registered callback in the callbacks spawner
+  enum InstrumentationMask : uint32_t {
+    kApiLog   = 0x1   //!< API calls are logged (AMD_LOG_LEVEL >= LOG_INFO with LOG_API)
+  };
+  extern std::atomic<uint32_t> g_instrumentation;
+
+  /// Returns true if any of the requested instrumentation is active
+  inline bool IsInstrumented(uint32_t mask) {
+    return (g_instrumentation.load(std::memory_order_relaxed) & mask) != 0;
+  }
+
+  /// Enables or disables instrumentation in the global mask
+  inline void SetInstrumentation(uint32_t mask, bool enable) {
+    if (enable) {
+      g_instrumentation.fetch_or(mask, std::memory_order_relaxed);
+    } else {
+      g_instrumentation.fetch_and(~mask, std::memory_order_relaxed);
+    }
+  }
+
   extern Device* getCurrentDevice();
 
   extern void setCurrentDevice(unsigned int index);
@@ -602,9 +649,12 @@ public:
   extern hipError_t ihipGetDeviceProperties(hipDeviceProp_t* props, hipDevice_t device);
 
   extern hipError_t ihipDeviceGet(hipDevice_t* device, int deviceId);
+  class StreamCallback;
+  //! Enqueues a stream wait or write value operation. The optional \a callback runs once the
+  //! operation completes and is owned by the command on success
   extern hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
                                         uint64_t value, uint64_t mask, unsigned int flags,
-                                        size_t sizeBytes);
+                                        size_t sizeBytes, StreamCallback* callback = nullptr);
   hipError_t ihipMemcpy(void* dst, const void* src, size_t sizeBytes, hipMemcpyKind kind,
                         hip::Stream& stream, bool isHostAsync = false, bool isGPUAsync = true);
   constexpr bool kOptionChangeable = true;
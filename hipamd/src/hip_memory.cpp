@@ -491,6 +491,51 @@ void ihipHtoHMemcpy(void* dst, const void* src, size_t sizeBytes, hip::Stream& s
   memcpy(dst, src, sizeBytes);
 }
 
+// ================================================================================================
+bool ihipMemcpyDirect(void* dst, const void* src, size_t sizeBytes, amd::Memory* srcMemory,
+                      amd::Memory* dstMemory, hip::Stream& stream) {
+  // Small synchronous copies to/from host accessible memory are done by CPU, which avoids
+  // the command submission and the completion signal round trip
+  if (sizeBytes > HIP_MEMCPY_DIRECT_SIZE) {
+    return false;
+  }
+  // The profiler expects an activity record for every copy, which requires a command
+  if (activity_prof::IsEnabled(OP_ID_COPY)) {
+    return false;
+  }
+  amd::Memory* memory = (srcMemory != nullptr) ? srcMemory : dstMemory;
+  amd::Device* device = memory->getContext().devices()[0];
+  bool flushHdp = false;
+  if (((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) & memory->getMemFlags()) == 0) {
+    constexpr uint32_t kNoDirectAccessFlags =
+        CL_MEM_VA_RANGE_AMD | ROCCLR_MEM_INTERPROCESS | ROCCLR_MEM_PHYMEM;
+    // Device memory is CPU accessible with large BAR only. CPU reads from it are uncached,
+    // hence have a separate size limit
+    if (!device->info().largeBar_ || (device != &stream.device()) ||
+        (memory->getContext().devices().size() != 1) ||
+        (memory->getType() != CL_MEM_OBJECT_BUFFER) || memory->ipcShared() ||
+        memory->isInterop() || ((memory->getMemFlags() & kNoDirectAccessFlags) != 0) ||
+        ((srcMemory != nullptr) && (sizeBytes > HIP_MEMCPY_DIRECT_READ_SIZE))) {
+      return false;
+    }
+    // CPU writes go through HDP on PCIe, hence HDP must be flushed before GPU access,
+    // unless the device doesn't cache the host writes in HDP
+    flushHdp = (dstMemory != nullptr) && !device->isXgmi() && device->settings().hostHdpFlush_;
+    if (flushHdp && (device->info().hdpMemFlushCntl == nullptr)) {
+      return false;
+    }
+  }
+
+  // Wait for the prior work on the stream before CPU access
+  stream.finish();
+  ::memcpy(dst, src, sizeBytes);
+  if (flushHdp) {
+    std::atomic_thread_fence(std::memory_order_release);
+    *device->info().hdpMemFlushCntl = 1u;
+  }
+  return true;
+}
+
 // ================================================================================================
 hipError_t ihipMemcpy(void* dst, const void* src, size_t sizeBytes, hipMemcpyKind kind,
                       hip::Stream& stream, bool isHostAsync, bool isGPUAsync) {
@@ -515,6 +560,9 @@ hipError_t ihipMemcpy(void* dst, const void* src, size_t sizeBytes, hipMemcpyKin
     return hipSuccess;
   } else if (((srcMemory == nullptr) && (dstMemory != nullptr)) ||
              ((srcMemory != nullptr) && (dstMemory == nullptr))) {
+    if (ihipMemcpyDirect(dst, src, sizeBytes, srcMemory, dstMemory, stream)) {
+      return hipSuccess;
+    }
     isHostAsync = false;
   } else if (srcMemory->getContext().devices()[0] == dstMemory->getContext().devices()[0]) {
     hipMemoryType srcMemoryType = ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
@@ -3623,6 +3671,60 @@ hipError_t hipHostGetDevicePointer(void** devicePointer, void* hostPointer, unsi
   HIP_RETURN(hipSuccess);
 }
 
+// ================================================================================================
+namespace {
+//! Attributes of the allocation a pointer belongs to. The memory object is resolved with a single
+//! range probe and the remaining attributes are derived from it, so queries of several attributes
+//! don't repeat the lookup (and the HSA pointer info fallback) for each one.
+class PointerRecord {
+ public:
+  explicit PointerRecord(const void* ptr) {
+    memObj_ = getMemoryObject(ptr, offset_);
+    if (memObj_ != nullptr) {
+      memFlags_ = memObj_->getMemFlags();
+    }
+  }
+
+  //! Returns true if the pointer belongs to a known allocation
+  bool valid() const { return memObj_ != nullptr; }
+
+  amd::Memory* memObj() const { return memObj_; }
+  size_t offset() const { return offset_; }
+
+  //! Host or registered allocations, as opposed to device local memory
+  bool isHost() const {
+    return ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) & memFlags_) != 0;
+  }
+
+  bool isManaged() const {
+    constexpr uint32_t kManagedAlloc = (CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_ALLOC_HOST_PTR);
+    return (memFlags_ & kManagedAlloc) == kManagedAlloc;
+  }
+
+  //! Host address of the pointer, registered memory reports the original host pointer
+  char* hostPointer() const {
+    char* base = (memObj_->getHostMem() != nullptr) ? static_cast<char*>(memObj_->getHostMem())
+                                                    : static_cast<char*>(memObj_->getSvmPtr());
+    return base + offset_;
+  }
+
+  //! Device memory of the allocation on the device it was allocated on
+  device::Memory* ownerDeviceMemory() const {
+    // Device IDs are the indices into g_devices, so the owner doesn't need a search
+    const int deviceId = memObj_->getUserData().deviceId;
+    if ((deviceId < 0) || (static_cast<size_t>(deviceId) >= g_devices.size())) {
+      return nullptr;
+    }
+    return memObj_->getDeviceMemory(*g_devices[deviceId]->devices()[0]);
+  }
+
+ private:
+  amd::Memory* memObj_ = nullptr;  //!< Memory object of the allocation, nullptr if unknown
+  size_t offset_ = 0;              //!< Offset of the pointer from the start of the allocation
+  uint32_t memFlags_ = 0;          //!< Memory flags of the allocation
+};
+}  // namespace
+
 // ================================================================================================
 hipError_t hipPointerGetAttributes(hipPointerAttribute_t* attributes, const void* ptr) {
   HIP_INIT_API(hipPointerGetAttributes, attributes, ptr);
@@ -3630,40 +3732,26 @@ hipError_t hipPointerGetAttributes(hipPointerAttribute_t* attributes, const void
   if (attributes == nullptr || ptr == nullptr) {
     HIP_RETURN(hipErrorInvalidValue);
   }
-  size_t offset = 0;
-  amd::Memory* memObj = getMemoryObject(ptr, offset);
-  int device = 0;
-  device::Memory* devMem = nullptr;
+  PointerRecord record(ptr);
   memset(attributes, 0, sizeof(hipPointerAttribute_t));
 
-  if (memObj != nullptr) {
-    attributes->type = ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
-        memObj->getMemFlags())? hipMemoryTypeHost : hipMemoryTypeDevice;
+  if (record.valid()) {
+    amd::Memory* memObj = record.memObj();
+    attributes->type = record.isHost() ? hipMemoryTypeHost : hipMemoryTypeDevice;
     if (attributes->type == hipMemoryTypeHost) {
-      if (memObj->getHostMem() != nullptr) {
-        attributes->hostPointer = static_cast<char*>(memObj->getHostMem()) + offset;
-      }
-      else {
-        attributes->hostPointer = static_cast<char*>(memObj->getSvmPtr()) + offset;
-      }
+      attributes->hostPointer = record.hostPointer();
     }
     // the pointer that attribute is retrieved for might not be on the current device
-    for (const auto& device : g_devices) {
-      if(device->deviceId() == memObj->getUserData().deviceId) {
-        devMem = memObj->getDeviceMemory(*device->devices()[0]);
-        break;
-      }
-    }
+    device::Memory* devMem = record.ownerDeviceMemory();
     //getDeviceMemory can fail, hence validate the sanity of the mem obtained
     if (nullptr == devMem) {
       DevLogPrintfError("getDeviceMemory for ptr failed : %p", ptr);
       HIP_RETURN(hipErrorMemoryAllocation);
     }
 
-    attributes->devicePointer = reinterpret_cast<char*>(devMem->virtualAddress() + offset);
-    constexpr uint32_t kManagedAlloc = (CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_ALLOC_HOST_PTR);
-    attributes->isManaged =
-        ((memObj->getMemFlags() & kManagedAlloc) == kManagedAlloc) ? true : false;
+    attributes->devicePointer =
+        reinterpret_cast<char*>(devMem->virtualAddress() + record.offset());
+    attributes->isManaged = record.isManaged();
     attributes->allocationFlags = memObj->getUserData().flags;
     attributes->device = memObj->getUserData().deviceId;
     if (attributes->isManaged) {
@@ -3705,12 +3793,10 @@ hipError_t ihipPointerSetAttribute(const void* value, hipPointer_attribute attri
 }
 
 // ================================================================================================
-hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
-                                    hipDeviceptr_t ptr) {
-
-  size_t offset = 0;
-  amd::Memory* memObj = getMemoryObject(ptr, offset);
-  constexpr uint32_t kManagedAlloc = (CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_ALLOC_HOST_PTR);
+static hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
+                                           hipDeviceptr_t ptr, const PointerRecord& record) {
+  amd::Memory* memObj = record.memObj();
+  const size_t offset = record.offset();
 
   hipError_t status = hipSuccess;
 
@@ -3722,8 +3808,7 @@ hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
       case HIP_POINTER_ATTRIBUTE_MEMORY_TYPE : {
         if (memObj) { // checks for host type or device type
           *reinterpret_cast<uint32_t*>(data) =
-          ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) &
-            memObj->getMemFlags())? hipMemoryTypeHost : hipMemoryTypeDevice;
+              record.isHost() ? hipMemoryTypeHost : hipMemoryTypeDevice;
         } else { // checks for array type
           cl_mem dstMemObj = reinterpret_cast<cl_mem>((static_cast<hipArray*>(ptr))->data);
           if (!is_valid(dstMemObj)) {
@@ -3759,16 +3844,9 @@ hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
       }
       case HIP_POINTER_ATTRIBUTE_HOST_POINTER : {
         if (memObj) {
-          if ((CL_MEM_SVM_FINE_GRAIN_BUFFER | CL_MEM_USE_HOST_PTR) & memObj->getMemFlags()) {
-            if (memObj->getHostMem() != nullptr) {
-              // Registered memory
-              *reinterpret_cast<char**>(data) =
-                static_cast<char*>(memObj->getHostMem()) + offset;
-            } else {
-              // Prepinned memory
-              *reinterpret_cast<char**>(data) =
-                static_cast<char*>(memObj->getSvmPtr()) + offset;
-            }
+          if (record.isHost()) {
+            // Registered memory reports the host pointer, prepinned memory the SVM pointer
+            *reinterpret_cast<char**>(data) = record.hostPointer();
           } else {
             *reinterpret_cast<char**>(data) = nullptr;
             status = hipErrorInvalidValue;
@@ -3800,8 +3878,7 @@ hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
       }
       case HIP_POINTER_ATTRIBUTE_IS_MANAGED : {
         if (memObj) {
-          *reinterpret_cast<bool*>(data) =
-               ((memObj->getMemFlags() & kManagedAlloc) == kManagedAlloc) ? true : false;
+          *reinterpret_cast<bool*>(data) = record.isManaged();
         } else {
           *reinterpret_cast<bool*>(data) = false;
           return hipErrorInvalidValue;
@@ -3900,6 +3977,13 @@ hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
   return status;
 }
 
+// ================================================================================================
+hipError_t ihipPointerGetAttributes(void* data, hipPointer_attribute attribute,
+                                    hipDeviceptr_t ptr) {
+  PointerRecord record(ptr);
+  return ihipPointerGetAttributes(data, attribute, ptr, record);
+}
+
 // ================================================================================================
 hipError_t hipPointerSetAttribute(const void* value, hipPointer_attribute attribute,
                                   hipDeviceptr_t ptr) {
@@ -3933,10 +4017,12 @@ hipError_t hipDrvPointerGetAttributes(unsigned int numAttributes, hipPointer_att
      HIP_RETURN(hipErrorInvalidValue);
    }
 
+   // Resolve the allocation once and answer all the queried attributes from it
+   PointerRecord record(ptr);
    // Ignore the status, hipDrvPointerGetAttributes always returns success
    // If the ptr is invalid, the queried attributes will be assigned default values
-   for (int i = 0; i < numAttributes; ++i) {
-     hipError_t status = ihipPointerGetAttributes(data[i], attributes[i], ptr);
+   for (unsigned int i = 0; i < numAttributes; ++i) {
+     hipError_t status = ihipPointerGetAttributes(data[i], attributes[i], ptr, record);
    }
    HIP_RETURN(hipSuccess);
 }
@@ -805,6 +805,131 @@ hipError_t hipExtLaunchMultiKernelMultiDevice(hipLaunchParams* launchParamsList,
   HIP_RETURN(ihipLaunchCooperativeKernelMultiDevice(launchParamsList, numDevices, flags, 0));
 }
 
+hipError_t ihipLaunchKernelBatch(hipLaunchParams* launchParamsList, int numKernels,
+                                 hipStream_t stream) {
+  int deviceId = hip::Stream::DeviceId(stream);
+  IHIP_RETURN_ONFAIL(PlatformState::instance().initStatManagedVarDevicePtr(deviceId));
+
+  hip::Stream* hip_stream = hip::getStream(stream);
+  auto device = g_devices[deviceId]->devices()[0];
+  std::vector<amd::NDRangeKernelCommand*> commands;
+  commands.reserve(numKernels);
+
+  auto releaseCommands = [&commands]() {
+    for (auto command : commands) {
+      command->release();
+    }
+  };
+
+  // Validate and capture all launches before anything is submitted to the device
+  for (int i = 0; i < numKernels; ++i) {
+    const hipLaunchParams& launch = launchParamsList[i];
+    hipFunction_t func = nullptr;
+    hipError_t status = PlatformState::instance().getStatFunc(&func, launch.func, deviceId);
+    if ((status != hipSuccess) || (func == nullptr)) {
+      releaseCommands();
+      return (status == hipErrorNoBinaryForGpu) ? status : hipErrorInvalidDeviceFunction;
+    }
+    size_t globalWorkSizeX = static_cast<size_t>(launch.gridDim.x) * launch.blockDim.x;
+    size_t globalWorkSizeY = static_cast<size_t>(launch.gridDim.y) * launch.blockDim.y;
+    size_t globalWorkSizeZ = static_cast<size_t>(launch.gridDim.z) * launch.blockDim.z;
+    if (globalWorkSizeX > std::numeric_limits<uint32_t>::max() ||
+        globalWorkSizeY > std::numeric_limits<uint32_t>::max() ||
+        globalWorkSizeZ > std::numeric_limits<uint32_t>::max()) {
+      releaseCommands();
+      return hipErrorInvalidConfiguration;
+    }
+    uint32_t globalX = static_cast<uint32_t>(globalWorkSizeX);
+    uint32_t globalY = static_cast<uint32_t>(globalWorkSizeY);
+    uint32_t globalZ = static_cast<uint32_t>(globalWorkSizeZ);
+    // Make sure the app doesn't launch a workgroup bigger than the global size
+    uint32_t blockDimX = std::min(launch.blockDim.x, globalX);
+    uint32_t blockDimY = std::min(launch.blockDim.y, globalY);
+    uint32_t blockDimZ = std::min(launch.blockDim.z, globalZ);
+
+    hip::DeviceFunc* function = hip::DeviceFunc::asFunction(func);
+    amd::Kernel* kernel = function->kernel();
+    // The kernel parameters are shared, hence keep the lock until the arguments are captured
+    amd::ScopedLock lock(function->dflock_);
+
+    status = ihipLaunchKernel_validate(func, globalX, globalY, globalZ, launch.blockDim.x,
+                                       launch.blockDim.y, launch.blockDim.z, launch.sharedMem,
+                                       launch.args, nullptr, deviceId, 0);
+    if (status != hipSuccess) {
+      releaseCommands();
+      return status;
+    }
+    if (kernel->getDeviceKernel(*device)->getUniformWorkGroupSize()) {
+      if (((globalX % blockDimX) != 0) || ((globalY % blockDimY) != 0) ||
+          ((globalZ % blockDimZ) != 0)) {
+        releaseCommands();
+        return hipErrorInvalidValue;
+      }
+    }
+    amd::Command* command = nullptr;
+    status = ihipLaunchKernelCommand(command, func, globalX, globalY, globalZ, blockDimX,
+                                     blockDimY, blockDimZ, launch.sharedMem, hip_stream,
+                                     launch.args, nullptr);
+    if (status != hipSuccess) {
+      releaseCommands();
+      return status;
+    }
+    commands.push_back(static_cast<amd::NDRangeKernelCommand*>(command));
+  }
+
+  // The batch owns the captured kernel commands from now on
+  amd::Command::EventWaitList waitList;
+  amd::KernelBatchCommand* command = new amd::KernelBatchCommand(*hip_stream, waitList, commands);
+  if (command == nullptr) {
+    releaseCommands();
+    return hipErrorOutOfMemory;
+  }
+  command->enqueue();
+
+  hipError_t status = hipSuccess;
+  if (command->status() == CL_INVALID_OPERATION) {
+    status = hipErrorIllegalState;
+  }
+  command->release();
+
+  return status;
+}
+
+hipError_t hipExtLaunchKernelBatch(hipLaunchParams* launchParamsList, int numKernels,
+                                   hipStream_t stream, unsigned int flags) {
+  HIP_INIT_API(hipExtLaunchKernelBatch, launchParamsList, numKernels, stream, flags);
+
+  if ((launchParamsList == nullptr) || (numKernels <= 0) || (flags != 0)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+  if (!hip::isValid(stream)) {
+    HIP_RETURN(hipErrorInvalidValue);
+  }
+
+  // All launches of a batch must target the same stream
+  for (int i = 0; i < numKernels; ++i) {
+    if (launchParamsList[i].stream != stream) {
+      HIP_RETURN(hipErrorInvalidValue);
+    }
+  }
+
+  hip::getStreamPerThread(stream);
+  if (stream != nullptr &&
+      reinterpret_cast<hip::Stream*>(stream)->GetCaptureStatus() ==
+          hipStreamCaptureStatusActive) {
+    // Graph capture records every launch as a separate node
+    for (int i = 0; i < numKernels; ++i) {
+      hipLaunchParams launch = launchParamsList[i];
+      const void* func = launch.func;
+      HIP_RETURN_ONFAIL(hip::capturehipLaunchKernel(stream, func, launch.gridDim, launch.blockDim,
+                                                    launch.args, launch.sharedMem));
+    }
+    HIP_RETURN(hipSuccess);
+  }
+
+  HIP_RETURN(ihipLaunchKernelBatch(launchParamsList, numKernels, stream));
+}
+
 hipError_t hipModuleGetTexRef(textureReference** texRef, hipModule_t hmod, const char* name) {
   HIP_INIT_API(hipModuleGetTexRef, texRef, hmod, name);
 
@@ -329,7 +329,8 @@ hipError_t ihipOccupancyMaxActiveBlocksPerMultiprocessor(
   hip::DeviceFunc* function = hip::DeviceFunc::asFunction(func);
   const amd::Kernel& kernel = *function->kernel();
 
-  const device::Kernel::WorkGroupInfo* wrkGrpInfo = kernel.getDeviceKernel(device)->workGroupInfo();
+  const device::Kernel* devKernel = kernel.getDeviceKernel(device);
+  const device::Kernel::WorkGroupInfo* wrkGrpInfo = devKernel->workGroupInfo();
   if (bCalcPotentialBlkSz == false) {
     if (inputBlockSize <= 0) {
       return hipErrorInvalidValue;
@@ -350,6 +351,18 @@ hipError_t ihipOccupancyMaxActiveBlocksPerMultiprocessor(
       inputBlockSize = device.info().maxWorkGroupSize_;
     }
   }
+
+  // The result depends on the kernel metadata and the device limits only,
+  // so reuse the previous calculation for the same launch configuration
+  device::Kernel::Occupancy occupancy;
+  if (devKernel->FindCachedOccupancy(inputBlockSize, dynamicSMemSize, bCalcPotentialBlkSz,
+                                     &occupancy)) {
+    *maxBlocksPerCU = occupancy.maxBlocksPerCU_;
+    *numBlocksPerGrid = occupancy.numBlocksPerGrid_;
+    *bestBlockSize = occupancy.bestBlockSize_;
+    return hipSuccess;
+  }
+
   // Find wave occupancy per CU => simd_per_cu * GPR usage
   size_t MaxWavesPerSimd;
 
@@ -417,6 +430,11 @@ hipError_t ihipOccupancyMaxActiveBlocksPerMultiprocessor(
   // Unless those blocks are further constrained by LDS size.
   *numBlocksPerGrid = device.info().maxComputeUnits_ * std::min(bestBlocksPerCU, lds_occupancy_wgs);
 
+  occupancy.maxBlocksPerCU_ = *maxBlocksPerCU;
+  occupancy.numBlocksPerGrid_ = *numBlocksPerGrid;
+  occupancy.bestBlockSize_ = *bestBlockSize;
+  devKernel->CacheOccupancy(inputBlockSize, dynamicSMemSize, bCalcPotentialBlkSz, occupancy);
+
   return hipSuccess;
 }
 }  // namespace hip_impl
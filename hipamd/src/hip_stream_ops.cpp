@@ -20,11 +20,13 @@
 
 #include <hip/hip_runtime.h>
 #include "hip_internal.hpp"
+#include "hip_event.hpp"
 #include "platform/command_utils.hpp"
 
 namespace hip {
 hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void* ptr,
-                               uint64_t value, uint64_t mask, unsigned int flags, size_t sizeBytes) {
+                               uint64_t value, uint64_t mask, unsigned int flags, size_t sizeBytes,
+                               StreamCallback* callback) {
   size_t offset = 0;
   unsigned int outFlags = 0;
 
@@ -80,6 +82,10 @@ hipError_t ihipStreamOperation(hipStream_t stream, cl_command_type cmdType, void
   if (command == nullptr) {
     return hipErrorOutOfMemory;
   }
+  if (callback != nullptr && !command->setCallback(CL_COMPLETE, ihipStreamCallback, callback)) {
+    command->release();
+    return hipErrorOutOfMemory;
+  }
   command->enqueue();
   command->release();
   return hipSuccess;
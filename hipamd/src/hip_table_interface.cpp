@@ -1714,3 +1714,8 @@ extern "C" int hipGetStreamDeviceId(hipStream_t stream) {
 hipError_t hipExtGetLastError() {
   return hip::GetHipDispatchTable()->hipExtGetLastError_fn();
 }
+hipError_t hipExtLaunchKernelBatch(hipLaunchParams* launchParamsList, int numKernels,
+                                   hipStream_t stream, unsigned int flags) {
+  return hip::GetHipDispatchTable()->hipExtLaunchKernelBatch_fn(launchParamsList, numKernels,
+                                                                stream, flags);
+}
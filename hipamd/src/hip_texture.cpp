@@ -72,6 +72,89 @@ amd::Image* ihipImageCreate(const cl_channel_order channelOrder,
                             amd::Memory* buffer,
                             hipError_t& status);
 
+// ================================================================================================
+amd::Sampler* Device::AcquireSampler(bool normCoords, uint32_t addrMode, uint32_t filterMode,
+                                     uint32_t mipFilterMode, float minLod, float maxLod) {
+  amd::ScopedLock lock(lock_);
+  auto& sampler = samplers_[SamplerState(normCoords, addrMode, filterMode, mipFilterMode,
+                                         minLod, maxLod)];
+  if (sampler == nullptr) {
+    sampler = new amd::Sampler(*context_, normCoords, addrMode, filterMode, mipFilterMode,
+                               minLod, maxLod);
+    if (sampler == nullptr) {
+      samplers_.erase(SamplerState(normCoords, addrMode, filterMode, mipFilterMode,
+                                   minLod, maxLod));
+      return nullptr;
+    }
+    if (!sampler->create()) {
+      delete sampler;
+      samplers_.erase(SamplerState(normCoords, addrMode, filterMode, mipFilterMode,
+                                   minLod, maxLod));
+      return nullptr;
+    }
+  }
+  // The cache keeps the original reference, the texture object owns the new one
+  sampler->retain();
+  return sampler;
+}
+
+namespace {
+
+// ================================================================================================
+//! Images of texture objects (views of HIP arrays and images over linear memory), shared between
+//! the texture objects with the same resource, format and layout. An image stays in the cache
+//! while at least one texture object references it, so the cache never extends the lifetime
+//! of the resource.
+class TextureImageCache {
+ public:
+  //! Context, resource type, resource, width, height, row pitch, channel order and type
+  typedef std::tuple<amd::Context*, hipResourceType, const void*, size_t, size_t, size_t,
+                     cl_channel_order, cl_channel_type> Key;
+
+  //! Returns a retained image for the key or creates a new one with the create functor
+  template <typename Creator>
+  amd::Image* acquire(const Key& key, Creator create) {
+    amd::ScopedLock lock(lock_);
+    auto it = images_.find(key);
+    if (it != images_.end()) {
+      ++users_[it->second].second;
+      it->second->retain();
+      return it->second;
+    }
+    amd::Image* image = create();
+    if (image != nullptr) {
+      it = images_.emplace(key, image).first;
+      users_[image] = std::make_pair(it, 1);
+    }
+    return image;
+  }
+
+  //! Releases the image of a texture object
+  void release(amd::Image* image) {
+    {
+      amd::ScopedLock lock(lock_);
+      auto it = users_.find(image);
+      if ((it != users_.end()) && (--it->second.second == 0)) {
+        images_.erase(it->second.first);
+        users_.erase(it);
+      }
+    }
+    image->release();
+  }
+
+ private:
+  typedef std::map<Key, amd::Image*> Images;
+
+  amd::Monitor lock_{"Texture image cache lock"};
+  Images images_;   //!< Shared images
+  //! The number of texture objects per shared image and the image location in the cache
+  std::unordered_map<amd::Image*, std::pair<Images::iterator, uint32_t>> users_;
+};
+
+TextureImageCache texImageCache;
+
+}  // namespace
+
 hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
                                    const hipResourceDesc* pResDesc,
                                    const hipTextureDesc* pTexDesc,
@@ -188,23 +271,7 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
     mipFilterMode = hip::getCLFilterMode(pTexDesc->mipmapFilterMode);
   }
 
-  amd::Sampler* sampler = new amd::Sampler(*hip::getCurrentDevice()->asContext(),
-                                           pTexDesc->normalizedCoords,
-                                           addressMode,
-                                           filterMode,
-                                           mipFilterMode,
-                                           pTexDesc->minMipmapLevelClamp,
-                                           pTexDesc->maxMipmapLevelClamp);
-
-  if (sampler == nullptr) {
-    return hipErrorOutOfMemory;
-  }
-
-  if (!sampler->create()) {
-    delete sampler;
-    return hipErrorOutOfMemory;
-  }
-
+  amd::Context* context = hip::getCurrentDevice()->asContext();
   amd::Image* image = nullptr;
   switch (pResDesc->resType) {
   case hipResourceTypeArray: {
@@ -237,7 +304,11 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
         return hipErrorInvalidValue;
       }
 
-      image = image->createView(*hip::getCurrentDevice()->asContext(), imageFormat, nullptr);
+      amd::Image* parent = image;
+      image = texImageCache.acquire(
+          TextureImageCache::Key(context, pResDesc->resType, parent, 0, 0, 0, channelOrder,
+                                 channelType),
+          [&]() { return parent->createView(*context, imageFormat, nullptr); });
       if (image == nullptr) {
         return hipErrorInvalidValue;
       }
@@ -277,8 +348,11 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
         return hipErrorInvalidValue;
       }
 
-      image = image->createView(*hip::getCurrentDevice()->asContext(), imageFormat, nullptr, 0, 0,
-                                true);
+      amd::Image* parent = image;
+      image = texImageCache.acquire(
+          TextureImageCache::Key(context, pResDesc->resType, parent, 0, 0, 0, channelOrder,
+                                 channelType),
+          [&]() { return parent->createView(*context, imageFormat, nullptr, 0, 0, true); });
       if (image == nullptr) {
         return hipErrorInvalidValue;
       }
@@ -293,22 +367,30 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
     const amd::Image::Format imageFormat({channelOrder, channelType});
     const cl_mem_object_type imageType = hip::getCLMemObjectType(pResDesc->resType);
     const size_t imageSizeInBytes = pResDesc->res.linear.sizeInBytes;
-    amd::Memory* buffer = getMemoryObjectWithOffset(pResDesc->res.linear.devPtr, imageSizeInBytes);
+    const size_t imageWidth = imageSizeInBytes / imageFormat.getElementSize();
     hipError_t status = hipSuccess;
-    image = ihipImageCreate(channelOrder,
-                            channelType,
-                            imageType,
-                            imageSizeInBytes / imageFormat.getElementSize(), /* imageWidth */
-                            0, /* imageHeight */
-                            0, /* imageDepth */
-                            0, /* imageArraySize */
-                            0, /* imageRowPitch */
-                            0, /* imageSlicePitch */
-                            0, /* numMipLevels */
-                            0, /* offset */
-                            buffer,
-                            status);
-    buffer->release();
+    image = texImageCache.acquire(
+        TextureImageCache::Key(context, pResDesc->resType, pResDesc->res.linear.devPtr,
+                               imageWidth, 0, 0, channelOrder, channelType),
+        [&]() {
+          amd::Memory* buffer = getMemoryObjectWithOffset(pResDesc->res.linear.devPtr,
+                                                          imageSizeInBytes);
+          amd::Image* texImage = ihipImageCreate(channelOrder,
+                                                 channelType,
+                                                 imageType,
+                                                 imageWidth, /* imageWidth */
+                                                 0, /* imageHeight */
+                                                 0, /* imageDepth */
+                                                 0, /* imageArraySize */
+                                                 0, /* imageRowPitch */
+                                                 0, /* imageSlicePitch */
+                                                 0, /* numMipLevels */
+                                                 0, /* offset */
+                                                 buffer,
+                                                 status);
+          buffer->release();
+          return texImage;
+        });
     if (image == nullptr) {
       return status;
     }
@@ -321,24 +403,32 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
     const cl_mem_object_type imageType = hip::getCLMemObjectType(pResDesc->resType);
     const size_t imageSizeInBytes = pResDesc->res.pitch2D.width * imageFormat.getElementSize() +
                                     pResDesc->res.pitch2D.pitchInBytes * (pResDesc->res.pitch2D.height - 1);
-    amd::Memory* buffer = getMemoryObjectWithOffset(pResDesc->res.pitch2D.devPtr, imageSizeInBytes);
     hipError_t status = hipSuccess;
-    image = ihipImageCreate(channelOrder,
-                            channelType,
-                            imageType,
-                            pResDesc->res.pitch2D.width, /* imageWidth */
-                            pResDesc->res.pitch2D.height, /* imageHeight */
-                            0, /* imageDepth */
-                            0, /* imageArraySize */
-                            pResDesc->res.pitch2D.pitchInBytes, /* imageRowPitch */
-                            0, /* imageSlicePitch */
-                            0, /* numMipLevels */
-                            0, /* offset */
-                            buffer,
-                            status);
-    if (buffer != nullptr) {
-      buffer->release();
-    }
+    image = texImageCache.acquire(
+        TextureImageCache::Key(context, pResDesc->resType, pResDesc->res.pitch2D.devPtr,
+                               pResDesc->res.pitch2D.width, pResDesc->res.pitch2D.height,
+                               pResDesc->res.pitch2D.pitchInBytes, channelOrder, channelType),
+        [&]() {
+          amd::Memory* buffer = getMemoryObjectWithOffset(pResDesc->res.pitch2D.devPtr,
+                                                          imageSizeInBytes);
+          amd::Image* texImage = ihipImageCreate(channelOrder,
+                                                 channelType,
+                                                 imageType,
+                                                 pResDesc->res.pitch2D.width, /* imageWidth */
+                                                 pResDesc->res.pitch2D.height, /* imageHeight */
+                                                 0, /* imageDepth */
+                                                 0, /* imageArraySize */
+                                                 pResDesc->res.pitch2D.pitchInBytes, /* imageRowPitch */
+                                                 0, /* imageSlicePitch */
+                                                 0, /* numMipLevels */
+                                                 0, /* offset */
+                                                 buffer,
+                                                 status);
+          if (buffer != nullptr) {
+            buffer->release();
+          }
+          return texImage;
+        });
     if (image == nullptr) {
       return status;
     }
@@ -346,9 +436,23 @@ hipError_t ihipCreateTextureObject(hipTextureObject_t* pTexObject,
   }
   }
 
+  // Identical sampler states share one sampler object and SRD
+  amd::Sampler* sampler = hip::getCurrentDevice()->AcquireSampler(pTexDesc->normalizedCoords,
+                                                                  addressMode,
+                                                                  filterMode,
+                                                                  mipFilterMode,
+                                                                  pTexDesc->minMipmapLevelClamp,
+                                                                  pTexDesc->maxMipmapLevelClamp);
+  if (sampler == nullptr) {
+    texImageCache.release(image);
+    return hipErrorOutOfMemory;
+  }
+
   void *texObjectBuffer = nullptr;
   hipError_t err = ihipMalloc(&texObjectBuffer, sizeof(__hip_texture), CL_MEM_SVM_FINE_GRAIN_BUFFER);
   if (texObjectBuffer == nullptr || err != hipSuccess) {
+    texImageCache.release(image);
+    sampler->release();
     return hipErrorOutOfMemory;
   }
   *pTexObject = new (texObjectBuffer) __hip_texture{image, sampler, *pResDesc, *pTexDesc, (pResViewDesc != nullptr) ? *pResViewDesc : hipResourceViewDesc{}};
@@ -376,9 +480,9 @@ hipError_t ihipDestroyTextureObject(hipTextureObject_t texObject) {
     return hipErrorNotSupported;
   }
 
-  texObject->image->release();
+  texImageCache.release(texObject->image);
 
-  // The texture object always owns the sampler SRD.
+  // The texture object always owns a reference to the shared sampler SRD.
   texObject->sampler->release();
 
   // TODO Should call ihipFree() to not polute the api trace.
@@ -710,6 +710,51 @@ bool compileToBitCode(const amd_comgr_data_set_t compileInputs, const std::strin
   return true;
 }
 
+bool compileToPch(const amd_comgr_data_set_t compileInputs, const std::string& isa,
+                  std::vector<std::string>& compileOptions, std::string& buildLog,
+                  std::vector<char>& pch) {
+  amd_comgr_language_t lang = AMD_COMGR_LANGUAGE_HIP;
+  amd_comgr_action_info_t action;
+  amd_comgr_data_set_t output;
+  amd_comgr_data_set_t input = compileInputs;
+
+  if (auto res = createAction(action, compileOptions, isa, lang); res != AMD_COMGR_STATUS_SUCCESS) {
+    return false;
+  }
+
+  if (auto res = amd::Comgr::create_data_set(&output); res != AMD_COMGR_STATUS_SUCCESS) {
+    amd::Comgr::destroy_action_info(action);
+    return false;
+  }
+
+  // The frontend emits the PCH in place of the bitcode, so the device libraries can't be linked
+  if (auto res = amd::Comgr::do_action(AMD_COMGR_ACTION_COMPILE_SOURCE_TO_BC, action, input,
+                                       output);
+      res != AMD_COMGR_STATUS_SUCCESS) {
+    extractBuildLog(output, buildLog);
+    amd::Comgr::destroy_action_info(action);
+    amd::Comgr::destroy_data_set(output);
+    return false;
+  }
+
+  if (!extractBuildLog(output, buildLog)) {
+    amd::Comgr::destroy_action_info(action);
+    amd::Comgr::destroy_data_set(output);
+    return false;
+  }
+
+  if (!extractByteCodeBinary(output, AMD_COMGR_DATA_KIND_BC, pch)) {
+    amd::Comgr::destroy_action_info(action);
+    amd::Comgr::destroy_data_set(output);
+    return false;
+  }
+
+  // Clean up
+  amd::Comgr::destroy_action_info(action);
+  amd::Comgr::destroy_data_set(output);
+  return true;
+}
+
 bool linkLLVMBitcode(const amd_comgr_data_set_t linkInputs, const std::string& isa,
                      std::vector<std::string>& linkOptions, std::string& buildLog,
                      std::vector<char>& LinkedLLVMBitcode) {
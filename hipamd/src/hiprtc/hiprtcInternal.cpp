@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #include "hiprtcInternal.hpp"
+#include "hiprtcPch.hpp"
 
 #include <fstream>
 #include <streambuf>
@@ -281,6 +282,108 @@ bool RTCCompileProgram::transformOptions(std::vector<std::string>& compile_optio
 
 amd::Monitor RTCProgram::lock_("HIPRTC Program", true);
 
+namespace {
+constexpr char kBuiltinHeaderName[] = "hiprtc_runtime.h";
+
+//! Precompiled builtin headers, shared by all programs of the process. A PCH is built on the
+//! second compile of a configuration, see PchTable
+class BuiltinPchCache {
+ public:
+  static constexpr size_t kMaxEntries = 64;  //!< Max number of cached configurations
+
+  BuiltinPchCache() : lock_("HIPRTC builtin PCH cache", true), table_(kMaxEntries) {}
+  ~BuiltinPchCache() {
+    for (const auto& path : table_.files()) {
+      amd::Os::unlink(path);
+    }
+  }
+
+  //! Returns the PCH file for the configuration, builds it if the configuration repeats.
+  //! Returns an empty path if the PCH isn't available
+  std::string get(const std::string& isa, const std::vector<std::string>& options);
+
+  //! Drops the PCH of the configuration after clang rejected it
+  void reject(const std::string& isa, const std::vector<std::string>& options);
+
+ private:
+  static std::string key(const std::string& isa, const std::vector<std::string>& options);
+
+  //! Compiles the builtin header into a PCH file, returns an empty path on failure
+  static std::string build(const std::string& isa, const std::vector<std::string>& options);
+
+  amd::Monitor lock_;
+  PchTable table_;  //!< PCH files by the configuration (lock protected)
+};
+
+std::string BuiltinPchCache::key(const std::string& isa,
+                                 const std::vector<std::string>& options) {
+  size_t major = 0;
+  size_t minor = 0;
+  amd::Comgr::get_version(&major, &minor);
+  return pchKey(isa, std::to_string(major) + '.' + std::to_string(minor), options);
+}
+
+std::string BuiltinPchCache::build(const std::string& isa,
+                                   const std::vector<std::string>& options) {
+  std::vector<std::string> pchOptions = pchBuildOptions(options, kBuiltinHeaderName);
+  std::string path;
+  amd_comgr_data_set_t input;
+  if (amd::Comgr::create_data_set(&input) == AMD_COMGR_STATUS_SUCCESS) {
+    std::vector<char> source(__hipRTC_header, __hipRTC_header + __hipRTC_header_size);
+    std::vector<char> pch;
+    std::string log;
+    if (addCodeObjData(input, source, kBuiltinHeaderName, AMD_COMGR_DATA_KIND_SOURCE) &&
+        compileToPch(input, isa, pchOptions, log, pch) && !pch.empty()) {
+      path = amd::Os::getTempFileName() + ".pch";
+      std::ofstream f(path.c_str(), std::ios::trunc | std::ios::binary);
+      if (f.is_open() && f.write(pch.data(), pch.size())) {
+        ClPrint(amd::LOG_INFO, amd::LOG_CODE, "Built the hiprtc builtin PCH %s for %s",
+                path.c_str(), isa.c_str());
+      } else {
+        f.close();
+        amd::Os::unlink(path);
+        path.clear();
+      }
+    }
+    amd::Comgr::destroy_data_set(input);
+  }
+  if (path.empty()) {
+    LogInfo("Failed to build the hiprtc builtin PCH, the header will be compiled with the source");
+  }
+  return path;
+}
+
+std::string BuiltinPchCache::get(const std::string& isa,
+                                 const std::vector<std::string>& options) {
+  const std::string configKey = key(isa, options);
+  bool needBuild = false;
+  {
+    amd::ScopedLock lock(lock_);
+    std::string path = table_.acquire(configKey, &needBuild);
+    if (!needBuild) {
+      return path;
+    }
+  }
+
+  // No lock is held during the build, so the compiles of other configurations aren't blocked
+  const std::string path = build(isa, options);
+
+  amd::ScopedLock lock(lock_);
+  table_.insert(configKey, path);
+  return path;
+}
+
+void BuiltinPchCache::reject(const std::string& isa, const std::vector<std::string>& options) {
+  amd::ScopedLock lock(lock_);
+  table_.reject(key(isa, options));
+}
+
+BuiltinPchCache& builtinPchCache() {
+  static BuiltinPchCache cache;
+  return cache;
+}
+}  // namespace
+
 bool RTCCompileProgram::compile(const std::vector<std::string>& options, bool fgpu_rdc) {
   if (!addSource_impl()) {
     LogError("Error in hiprtc: unable to add source code");
@@ -299,18 +402,40 @@ bool RTCCompileProgram::compile(const std::vector<std::string>& options, bool fg
     return false;
   }
 
-  if (fgpu_rdc_) {
-    if (!compileToBitCode(compile_input_, isa_, compileOpts, build_log_, LLVMBitcode_)) {
-      LogError("Error in hiprtc: unable to compile source to bitcode");
-      return false;
+  auto compileSource = [this](std::vector<std::string>& compileOpts) {
+    if (fgpu_rdc_) {
+      return compileToBitCode(compile_input_, isa_, compileOpts, build_log_, LLVMBitcode_);
+    }
+    return compileToExecutable(compile_input_, isa_, compileOpts, link_options_, build_log_,
+                               executable_);
+  };
+
+  bool compiled = false;
+  std::string pch = HIPRTC_USE_PCH_CACHE ? builtinPchCache().get(isa_, compileOpts) : "";
+  if (!pch.empty()) {
+    // Replace the builtin header with its PCH
+    std::vector<std::string> pchOpts = pchCompileOptions(compileOpts, kBuiltinHeaderName, pch);
+    const size_t logSize = build_log_.size();
+    compiled = compileSource(pchOpts);
+    if (!compiled && isPchLoadError(build_log_.substr(logSize), pch)) {
+      // Compile again without the PCH only if clang couldn't load it. Errors in the user
+      // source are reported as they are, without the second compile
+      LogInfo("The builtin PCH failed to load, compiling without it");
+      build_log_.resize(logSize);
+      builtinPchCache().reject(isa_, compileOpts);
+      compiled = compileSource(compileOpts);
     }
   } else {
-    LogInfo("Using the new path of comgr");
-    if (!compileToExecutable(compile_input_, isa_, compileOpts, link_options_, build_log_,
-                             executable_)) {
+    compiled = compileSource(compileOpts);
+  }
+
+  if (!compiled) {
+    if (fgpu_rdc_) {
+      LogError("Error in hiprtc: unable to compile source to bitcode");
+    } else {
       LogError("Failing to compile to realloc");
-      return false;
     }
+    return false;
   }
 
   if (!mangled_names_.empty()) {
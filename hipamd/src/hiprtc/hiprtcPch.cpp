@@ -0,0 +1,163 @@
+/*
+Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "hiprtcPch.hpp"
+
+#include <iterator>
+
+namespace hiprtc {
+namespace helpers {
+
+std::string pchKey(const std::string& isa, const std::string& compilerVersion,
+                   const std::vector<std::string>& options) {
+  std::string key = isa + '\n' + compilerVersion;
+  for (const auto& option : options) {
+    key += '\n';
+    key += option;
+  }
+  return key;
+}
+
+std::vector<std::string> pchBuildOptions(const std::vector<std::string>& options,
+                                         const std::string& header) {
+  std::vector<std::string> pchOptions;
+  pchOptions.reserve(options.size() + 4);
+  for (size_t i = 0; i < options.size(); ++i) {
+    if (options[i] == "-include" && (i + 1) < options.size() && options[i + 1] == header) {
+      ++i;
+      continue;
+    }
+    pchOptions.push_back(options[i]);
+  }
+  pchOptions.push_back("-Xclang");
+  pchOptions.push_back("-emit-pch");
+  pchOptions.push_back("-Xclang");
+  pchOptions.push_back("-fno-pch-timestamp");
+  return pchOptions;
+}
+
+std::vector<std::string> pchCompileOptions(const std::vector<std::string>& options,
+                                           const std::string& header, const std::string& pch) {
+  std::vector<std::string> pchOptions;
+  pchOptions.reserve(options.size() + 2);
+  for (size_t i = 0; i < options.size(); ++i) {
+    if (options[i] == "-include" && (i + 1) < options.size() && options[i + 1] == header) {
+      pchOptions.push_back("-include-pch");
+      pchOptions.push_back(pch);
+      ++i;
+      continue;
+    }
+    pchOptions.push_back(options[i]);
+  }
+  pchOptions.push_back("-Xclang");
+  pchOptions.push_back("-fno-validate-pch");
+  return pchOptions;
+}
+
+bool isPchLoadError(const std::string& log, const std::string& pch) {
+  // Clang diagnostics of a missing, corrupted or mismatched PCH
+  static const char* kPchErrors[] = {"PCH file", "precompiled header", "AST file"};
+  if (!pch.empty() && log.find(pch) != std::string::npos) {
+    return true;
+  }
+  for (const char* error : kPchErrors) {
+    if (log.find(error) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::string PchTable::acquire(const std::string& key, bool* build) {
+  *build = false;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    // The first compile of the configuration, build the PCH only if it repeats
+    if (maxEntries_ == 0) {
+      return std::string();
+    }
+    if (entries_.size() >= maxEntries_) {
+      evict();
+    }
+    order_.push_back(key);
+    entries_[key].order_ = std::prev(order_.end());
+    return std::string();
+  }
+
+  Entry& entry = it->second;
+  if (entry.path_.empty() && !entry.building_ && !entry.failed_) {
+    entry.building_ = true;
+    *build = true;
+  }
+  return entry.path_;
+}
+
+void PchTable::insert(const std::string& key, const std::string& path) {
+  auto it = entries_.find(key);
+  if (it == entries_.end() || !it->second.path_.empty()) {
+    // The configuration was dropped during the build
+    if (!path.empty()) {
+      stale_.push_back(path);
+    }
+    return;
+  }
+  Entry& entry = it->second;
+  entry.building_ = false;
+  entry.path_ = path;
+  entry.failed_ = path.empty();
+}
+
+void PchTable::reject(const std::string& key) {
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return;
+  }
+  Entry& entry = it->second;
+  // Other programs may compile with the file at the moment, hence it's removed with the table
+  if (!entry.path_.empty()) {
+    stale_.push_back(entry.path_);
+    entry.path_.clear();
+  }
+  entry.failed_ = true;
+}
+
+std::vector<std::string> PchTable::files() const {
+  std::vector<std::string> files(stale_);
+  for (const auto& it : entries_) {
+    if (!it.second.path_.empty()) {
+      files.push_back(it.second.path_);
+    }
+  }
+  return files;
+}
+
+void PchTable::evict() {
+  auto it = entries_.find(order_.front());
+  if (!it->second.path_.empty()) {
+    stale_.push_back(it->second.path_);
+  }
+  entries_.erase(it);
+  order_.pop_front();
+}
+
+}  // namespace helpers
+}  // namespace hiprtc
@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2026 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hiprtc {
+namespace helpers {
+//! Returns the key of a builtin PCH. Clang accepts a PCH only for the configuration it was built
+//! with, hence the key has the target, the compiler version and all compile options
+std::string pchKey(const std::string& isa, const std::string& compilerVersion,
+                   const std::vector<std::string>& options);
+
+//! Returns the options for the PCH build of the header: its -include is removed, since the
+//! header is the source, and the PCH output is requested
+std::vector<std::string> pchBuildOptions(const std::vector<std::string>& options,
+                                         const std::string& header);
+
+//! Returns the compile options with the -include of the header replaced by the PCH. The PCH
+//! validation is skipped, because the header exists only in a compiler temp directory
+std::vector<std::string> pchCompileOptions(const std::vector<std::string>& options,
+                                           const std::string& header, const std::string& pch);
+
+//! Returns true if the compile log shows that clang failed to load the PCH, rather than an
+//! error in the compiled source
+bool isPchLoadError(const std::string& log, const std::string& pch);
+
+//! Bookkeeping of the builtin PCH files without locking or compilation. A PCH is built only when
+//! a configuration repeats, so one-off compiles don't pay for the PCH build. The number of
+//! configurations is bounded, the oldest one is dropped first
+class PchTable {
+ public:
+  explicit PchTable(size_t maxEntries) : maxEntries_(maxEntries) {}
+
+  //! Registers a compile of the configuration. Returns the PCH file if it's available, otherwise
+  //! an empty path and build is set to true if the caller must build the PCH now
+  std::string acquire(const std::string& key, bool* build);
+
+  //! Stores the PCH built for the configuration, an empty path marks a failed build
+  void insert(const std::string& key, const std::string& path);
+
+  //! Drops the PCH of the configuration after clang rejected it. The configuration isn't
+  //! built again
+  void reject(const std::string& key);
+
+  //! Returns all PCH files, which must be removed with the table
+  std::vector<std::string> files() const;
+
+  //! Returns the number of tracked configurations
+  size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    std::list<std::string>::iterator order_;  //!< Position in the insertion order
+    std::string path_;                        //!< PCH file, empty if it isn't available
+    bool building_ = false;                   //!< A thread builds the PCH
+    bool failed_ = false;                     //!< The PCH isn't usable, don't build it again
+  };
+
+  //! Drops the oldest configuration, its PCH file is removed with the table
+  void evict();
+
+  size_t maxEntries_;                               //!< Max number of configurations
+  std::unordered_map<std::string, Entry> entries_;  //!< Configurations by the PCH key
+  std::list<std::string> order_;                    //!< Keys in the insertion order
+  std::vector<std::string> stale_;                  //!< Dropped PCH files
+};
+}  // namespace helpers
+}  // namespace hiprtc
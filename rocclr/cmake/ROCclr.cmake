@@ -82,6 +82,7 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/platform/commandqueue.cpp
   ${ROCCLR_SRC_DIR}/platform/context.cpp
   ${ROCCLR_SRC_DIR}/platform/kernel.cpp
+  ${ROCCLR_SRC_DIR}/platform/kernelargarena.cpp
   ${ROCCLR_SRC_DIR}/platform/memory.cpp
   ${ROCCLR_SRC_DIR}/platform/ndrange.cpp
   ${ROCCLR_SRC_DIR}/platform/program.cpp
@@ -91,7 +92,8 @@ target_sources(rocclr PRIVATE
   ${ROCCLR_SRC_DIR}/thread/semaphore.cpp
   ${ROCCLR_SRC_DIR}/thread/thread.cpp
   ${ROCCLR_SRC_DIR}/utils/debug.cpp
-  ${ROCCLR_SRC_DIR}/utils/flags.cpp)
+  ${ROCCLR_SRC_DIR}/utils/flags.cpp
+  ${ROCCLR_SRC_DIR}/utils/parallel.cpp)
 
 if(WIN32)
   target_sources(rocclr PRIVATE
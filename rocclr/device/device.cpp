@@ -413,12 +413,37 @@ void MemObjMap::Purge(amd::Device* dev) {
   }
 }
 
+Monitor Device::BlitProgram::codeObjectsLock_("Blit code objects lock");
+std::unordered_map<std::string, std::vector<uint8_t>> Device::BlitProgram::codeObjects_;
+
 Device::BlitProgram::~BlitProgram() {
   if (program_ != nullptr) {
     program_->release();
   }
 }
 
+bool Device::BlitProgram::loadCodeObject(amd::Device* device, std::vector<uint8_t>* codeObject) {
+  if (GPU_BLIT_CODE_OBJECT_PATH[0] == '\0') {
+    return false;
+  }
+  // Target ID features are separated with ':', which isn't a valid file name symbol on all OS
+  std::string target(device->isa().targetId());
+  std::replace(target.begin(), target.end(), ':', '_');
+  std::string fileName = std::string(GPU_BLIT_CODE_OBJECT_PATH) + amd::Os::fileSeparator() +
+                         (amd::IS_HIP ? "hip_blit_" : "ocl_blit_") + target + ".co";
+
+  const void* image = nullptr;
+  size_t size = 0;
+  if (!amd::Os::MemoryMapFile(fileName.c_str(), &image, &size)) {
+    return false;
+  }
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(image);
+  codeObject->assign(data, data + size);
+  amd::Os::MemoryUnmapFile(image, size);
+  ClPrint(amd::LOG_INFO, amd::LOG_INIT, "Loaded prebuilt blit code object %s", fileName.c_str());
+  return true;
+}
+
 bool Device::BlitProgram::create(amd::Device* device, const std::string& extraKernels,
                                  const std::string& extraOptions) {
   std::vector<amd::Device*> devices;
@@ -435,14 +460,6 @@ bool Device::BlitProgram::create(amd::Device* device, const std::string& extraKe
     kernels += extraKernels;
   }
 
-  // Create a program with all blit kernels
-  program_ = new Program(*context_, kernels.c_str(), Program::OpenCL_C);
-  if (program_ == nullptr) {
-    DevLogPrintfError("Program creation for Kernel: %s failed\n",
-                      kernels.c_str());
-    return false;
-  }
-
   // Build all kernels
   std::string opt = "-cl-internal-kernel ";
   if (!device->settings().useLightning_) {
@@ -455,6 +472,43 @@ bool Device::BlitProgram::create(amd::Device* device, const std::string& extraKe
   if (!GPU_DUMP_BLIT_KERNELS) {
     opt += " -fno-enable-dump";
   }
+
+  // Blit kernels depend on the ISA, the kernel source and the options only. Hence devices
+  // with the same ISA share one code object and the compiler runs once per ISA
+  const std::string key = device->isa().isaName() + '\n' + opt + '\n' + kernels;
+  amd::ScopedLock lock(codeObjectsLock_);
+  auto& codeObject = codeObjects_[key];
+  if (codeObject.empty()) {
+    loadCodeObject(device, &codeObject);
+  }
+
+  if (!codeObject.empty()) {
+    program_ = new Program(*context_);
+    if ((program_ != nullptr) &&
+        (program_->addDeviceProgram(*device, codeObject.data(), codeObject.size()) ==
+         CL_SUCCESS) &&
+        (program_->build(devices, opt.c_str(), nullptr, nullptr, GPU_DUMP_BLIT_KERNELS) ==
+         CL_SUCCESS) &&
+        program_->load()) {
+      return true;
+    }
+    // The code object is incompatible with the device, so fall back to the compilation
+    DevLogPrintfError("Could not load blit code object for %s\n", device->isa().targetId());
+    if (program_ != nullptr) {
+      program_->release();
+      program_ = nullptr;
+    }
+    codeObject.clear();
+  }
+
+  // Create a program with all blit kernels
+  program_ = new Program(*context_, kernels.c_str(), Program::OpenCL_C);
+  if (program_ == nullptr) {
+    DevLogPrintfError("Program creation for Kernel: %s failed\n",
+                      kernels.c_str());
+    return false;
+  }
+
   if ((retval = program_->build(devices, opt.c_str(), nullptr, nullptr, GPU_DUMP_BLIT_KERNELS))
       != CL_SUCCESS) {
     DevLogPrintfError("Build failed for Kernel: %s with error code %d\n",
@@ -466,6 +520,16 @@ bool Device::BlitProgram::create(amd::Device* device, const std::string& extraKe
     return false;
   }
 
+  // Keep the code object for the other devices with the same ISA
+  const device::Program* devProgram = program_->getDeviceProgram(*device);
+  if (devProgram != nullptr) {
+    auto binary = devProgram->binary();
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(binary.first);
+    if (data != nullptr) {
+      codeObject.assign(data, data + binary.second);
+    }
+  }
+
   return true;
 }
 
@@ -475,6 +539,10 @@ bool Device::init() {
   devices_ = nullptr;
   appProfile_.init();
 
+  // Resolve the global flag defaults before the backends create devices concurrently
+  if (amd::IS_HIP && flagIsDefault(GPU_SINGLE_ALLOC_PERCENT)) {
+    GPU_SINGLE_ALLOC_PERCENT = 100;
+  }
 
 // IMPORTANT: Note that we are initialiing HSA stack first and then
 // GPU stack. The order of initialization is signiicant and if changed
@@ -934,12 +1002,6 @@ Settings::Settings() : value_(0) {
   waitCommand_ = AMD_OCL_WAIT_COMMAND;
   supportDepthsRGB_ = false;
   fenceScopeAgent_ = AMD_OPT_FLUSH;
-  if (amd::IS_HIP) {
-    if (flagIsDefault(GPU_SINGLE_ALLOC_PERCENT)) {
-      GPU_SINGLE_ALLOC_PERCENT = 100;
-    }
-
-  }
 }
 
 void Memory::saveMapInfo(const void* mapAddress, const amd::Coord3D origin,
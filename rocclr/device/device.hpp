@@ -45,6 +45,7 @@
 #endif
 #endif
 
+#include <atomic>
 #include <cassert>
 #include <cstdint>
 #include <cstdio>
@@ -70,6 +71,7 @@ class MapMemoryCommand;
 class UnmapMemoryCommand;
 class MigrateMemObjectsCommand;
 class NDRangeKernelCommand;
+class KernelBatchCommand;
 class NativeFnCommand;
 class FlushCommand;
 class FinishCommand;
@@ -673,7 +675,8 @@ class Settings : public amd::HeapObject {
       uint fenceScopeAgent_ : 1;      //!< Enable fence scope agent in AQL dispatch packet
       uint rocr_backend_ : 1;         //!< Device uses ROCr backend for submissions
       uint gwsInitSupported_:1;       //!< Check if GWS is supported on this machine.
-      uint reserved_ : 10;
+      uint hostHdpFlush_ : 1;         //!< Host writes to device memory need HDP flush
+      uint reserved_ : 9;
     };
     uint value_;
   };
@@ -1234,7 +1237,8 @@ class VirtualDevice : public amd::HeapObject {
     : device_(device)
     , blitMgr_(NULL)
     , execution_("Virtual device execution lock", true)
-    , index_(0) {}
+    , index_(0)
+    , queueGeneration_(0) {}
 
   //! Destroy this virtual device.
   virtual ~VirtualDevice() {}
@@ -1249,6 +1253,8 @@ class VirtualDevice : public amd::HeapObject {
   virtual void submitMapMemory(amd::MapMemoryCommand& cmd) = 0;
   virtual void submitUnmapMemory(amd::UnmapMemoryCommand& cmd) = 0;
   virtual void submitKernel(amd::NDRangeKernelCommand& command) = 0;
+  //! Submits a batch of captured kernel dispatches under the batch command's event
+  virtual void submitKernelBatch(amd::KernelBatchCommand& command) = 0;
   virtual void submitNativeFn(amd::NativeFnCommand& cmd) = 0;
   virtual void submitMarker(amd::Marker& cmd) = 0;
   virtual void submitAccumulate(amd::AccumulateCommand& cmd) = 0;
@@ -1286,6 +1292,10 @@ class VirtualDevice : public amd::HeapObject {
   //! Returns the virtual device unique index
   uint index() const { return index_; }
 
+  //! Returns the generation of the HW queue. It changes when the virtual device migrates to
+  //! another HW queue, which invalidates the AQL packets captured for the old queue
+  uint queueGeneration() const { return queueGeneration_.load(std::memory_order_acquire); }
+
   //! Returns true if device has active wait setting
   bool ActiveWait() const;
 
@@ -1313,6 +1323,7 @@ class VirtualDevice : public amd::HeapObject {
 
   amd::Monitor execution_;  //!< Lock to serialise access to all device objects
   uint index_;              //!< The virtual device unique index
+  std::atomic<uint> queueGeneration_;  //!< The generation of the HW queue in use
 };
 
 }  // namespace device
@@ -1620,6 +1631,14 @@ class Device : public RuntimeObject {
                 const std::string& extraKernel,  //!< Extra kernels from the device layer
                 const std::string& extraOptions  //!< Extra compilation options
     );
+
+   private:
+    //! Loads a prebuilt blit code object for the device ISA from GPU_BLIT_CODE_OBJECT_PATH
+    static bool loadCodeObject(Device* device, std::vector<uint8_t>* codeObject);
+
+    static Monitor codeObjectsLock_;  //!< Lock to serialise access to the code objects
+    //! Blit code objects, shared between the devices with the same ISA and kernels
+    static std::unordered_map<std::string, std::vector<uint8_t>> codeObjects_;
   };
 
 #if defined(WITH_COMPILER_LIB)
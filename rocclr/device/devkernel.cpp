@@ -30,9 +30,11 @@
 #endif
 #include "comgrctx.hpp"
 
+#include <charconv>
 #include <map>
 #include <string>
 #include <sstream>
+#include <unordered_map>
 
 #if defined(WITH_COMPILER_LIB)
 #include "hsailctx.hpp"
@@ -66,58 +68,122 @@ amd_comgr_status_t getMetaBuf(const amd_comgr_metadata_node_t meta,
 }
 
 // ================================================================================================
-static amd_comgr_status_t populateArgs(const amd_comgr_metadata_node_t key,
-                                       const amd_comgr_metadata_node_t value,
-                                       void *data) {
-  amd_comgr_status_t status;
-  amd_comgr_metadata_kind_t kind;
-  std::string buf;
+amd_comgr_status_t MetaString::get(const amd_comgr_metadata_node_t meta) {
+  size_t size = 0;
+  amd_comgr_status_t status = amd::Comgr::get_metadata_string(meta, &size, NULL);
+  if (status != AMD_COMGR_STATUS_SUCCESS || size == 0) {
+    return (status == AMD_COMGR_STATUS_SUCCESS) ? AMD_COMGR_STATUS_ERROR : status;
+  }
+
+  char* buf = local_;
+  if (size > sizeof(local_)) {
+    heap_.resize(size);
+    buf = &heap_[0];
+  }
+  // The size includes the null character
+  status = amd::Comgr::get_metadata_string(meta, &size, buf);
+  if (status == AMD_COMGR_STATUS_SUCCESS) {
+    data_ = buf;
+    size_ = size - 1;
+  }
+  return status;
+}
 
-  // get the key of the argument field
+// ================================================================================================
+int MetaString::toInt() const {
+  int value = 0;
+  std::from_chars(data_, data_ + size_, value);
+  return value;
+}
+
+// ================================================================================================
+//! Decodes the key of a metadata map entry and finds it in the table of the known keys
+//! A key, which isn't a string, fails the string query, so the kind isn't queried separately
+template <typename T>
+static const typename MetaKeyTable<T>::Entry* findMetaKey(const amd_comgr_metadata_node_t key,
+                                                         const MetaKeyTable<T>& table) {
+  MetaString buf;
+  if (buf.get(key) != AMD_COMGR_STATUS_SUCCESS) {
+    return nullptr;
+  }
+  return table.find(buf.view());
+}
+
+// ================================================================================================
+//! Returns true if the argument names and types must be decoded. OpenCL reports them in
+//! clGetKernelArgInfo, HIP prints them only in the kernel argument and memory logs
+static bool needArgNames() {
+  return !amd::IS_HIP || (AMD_LOG_LEVEL >= amd::LOG_INFO) || PAL_EMBED_KERNEL_MD;
+}
+
+// ================================================================================================
+//! Decodes a list of 3 workgroup dimensions. Returns false if the list has a different size
+static bool getMetaDims(const amd_comgr_metadata_node_t value, size_t dims[3],
+                        amd_comgr_status_t* status) {
   size_t size = 0;
-  status = amd::Comgr::get_metadata_kind(key, &kind);
-  if (kind == AMD_COMGR_METADATA_KIND_STRING && status == AMD_COMGR_STATUS_SUCCESS) {
-    status = getMetaBuf(key, &buf);
+  *status = amd::Comgr::get_metadata_list_size(value, &size);
+  if (size != 3 || *status != AMD_COMGR_STATUS_SUCCESS) {
+    return false;
+  }
+  size_t count = 0;
+  for (size_t i = 0; i < size && *status == AMD_COMGR_STATUS_SUCCESS; i++) {
+    amd_comgr_metadata_node_t dim;
+    *status = amd::Comgr::index_list_metadata(value, i, &dim);
+
+    MetaString buf;
+    if (*status == AMD_COMGR_STATUS_SUCCESS && buf.get(dim) == AMD_COMGR_STATUS_SUCCESS) {
+      dims[count++] = buf.toInt();
+    }
+    amd::Comgr::destroy_metadata(dim);
   }
+  return count == size;
+}
 
-  if (status != AMD_COMGR_STATUS_SUCCESS) {
+// ================================================================================================
+static amd_comgr_status_t populateArgs(const amd_comgr_metadata_node_t key,
+                                       const amd_comgr_metadata_node_t value,
+                                       void *data) {
+  auto itArgField = findMetaKey(key, ArgFieldMap);
+  if (itArgField == nullptr) {
     return AMD_COMGR_STATUS_ERROR;
   }
 
-  auto itArgField = ArgFieldMap.find(buf);
-  if (itArgField == ArgFieldMap.end()) {
-    return AMD_COMGR_STATUS_ERROR;
+  amd::KernelParameterDescriptor* lcArg = static_cast<amd::KernelParameterDescriptor*>(data);
+
+  // HIP uses the argument names and types only in the logs, hence skip the decoding otherwise
+  if (!needArgNames() &&
+      (itArgField->value_ == ArgField::Name || itArgField->value_ == ArgField::TypeName)) {
+    return AMD_COMGR_STATUS_SUCCESS;
   }
 
   // get the value of the argument field
-  status = getMetaBuf(value, &buf);
-
-  amd::KernelParameterDescriptor* lcArg = static_cast<amd::KernelParameterDescriptor*>(data);
+  MetaString buf;
+  buf.get(value);
 
-  switch (itArgField->second) {
+  switch (itArgField->value_) {
     case ArgField::Name:
-      lcArg->name_ = buf;
+      lcArg->name_ = buf.str();
       break;
     case ArgField::TypeName:
-      lcArg->typeName_ = buf;
+      lcArg->typeName_ = buf.str();
       break;
     case ArgField::Size:
-      lcArg->size_= atoi(buf.c_str());
+      lcArg->size_= buf.toInt();
       break;
     case ArgField::Align:
-      lcArg->alignment_ = atoi(buf.c_str());
+      lcArg->alignment_ = buf.toInt();
       break;
     case ArgField::ValueKind:
       {
-        auto itValueKind = ArgValueKind.find(buf);
-        if (itValueKind == ArgValueKind.end()) {
+        auto itValueKind = ArgValueKind.find(buf.view());
+        if (itValueKind == nullptr) {
           lcArg->info_.hidden_ = true;
           return AMD_COMGR_STATUS_ERROR;
         }
-        lcArg->info_.oclObject_ = itValueKind->second;
+        lcArg->info_.oclObject_ = itValueKind->value_;
         switch (lcArg->info_.oclObject_) {
           case amd::KernelParameterDescriptor::MemoryObject:
-            if (itValueKind->first.compare("DynamicSharedPointer") == 0) {
+            if (itValueKind->key_ == "DynamicSharedPointer") {
               lcArg->info_.shared_ = true;
             }
             break;
@@ -137,48 +203,48 @@ static amd_comgr_status_t populateArgs(const amd_comgr_metadata_node_t key,
       }
       break;
     case ArgField::PointeeAlign:
-      lcArg->info_.arrayIndex_ = atoi(buf.c_str());
+      lcArg->info_.arrayIndex_ = buf.toInt();
       break;
     case ArgField::AddrSpaceQual:
       {
-        auto itAddrSpaceQual = ArgAddrSpaceQual.find(buf);
-        if (itAddrSpaceQual == ArgAddrSpaceQual.end()) {
+        auto itAddrSpaceQual = ArgAddrSpaceQual.find(buf.view());
+        if (itAddrSpaceQual == nullptr) {
           return AMD_COMGR_STATUS_ERROR;
         }
-        lcArg->addressQualifier_ = itAddrSpaceQual->second;
+        lcArg->addressQualifier_ = itAddrSpaceQual->value_;
       }
       break;
     case ArgField::AccQual:
       {
-        auto itAccQual = ArgAccQual.find(buf);
-        if (itAccQual == ArgAccQual.end()) {
+        auto itAccQual = ArgAccQual.find(buf.view());
+        if (itAccQual == nullptr) {
           return AMD_COMGR_STATUS_ERROR;
         }
-        lcArg->accessQualifier_ = itAccQual->second;
+        lcArg->accessQualifier_ = itAccQual->value_;
         lcArg->info_.readOnly_ =
             (lcArg->accessQualifier_ == CL_KERNEL_ARG_ACCESS_READ_ONLY) ? true : false;
       }
       break;
     case ArgField::ActualAccQual:
       {
-        auto itAccQual = ArgAccQual.find(buf);
-        if (itAccQual == ArgAccQual.end()) {
+        auto itAccQual = ArgAccQual.find(buf.view());
+        if (itAccQual == nullptr) {
             return AMD_COMGR_STATUS_ERROR;
         }
-        // lcArg->mActualAccQual = itAccQual->second;
+        // lcArg->mActualAccQual = itAccQual->value_;
       }
       break;
     case ArgField::IsConst:
-      lcArg->typeQualifier_ |= (buf.compare("true") == 0) ? CL_KERNEL_ARG_TYPE_CONST : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "true") ? CL_KERNEL_ARG_TYPE_CONST : 0;
       break;
     case ArgField::IsRestrict:
-      lcArg->typeQualifier_ |= (buf.compare("true") == 0) ? CL_KERNEL_ARG_TYPE_RESTRICT : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "true") ? CL_KERNEL_ARG_TYPE_RESTRICT : 0;
       break;
     case ArgField::IsVolatile:
-      lcArg->typeQualifier_ |= (buf.compare("true") == 0) ? CL_KERNEL_ARG_TYPE_VOLATILE : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "true") ? CL_KERNEL_ARG_TYPE_VOLATILE : 0;
       break;
     case ArgField::IsPipe:
-      lcArg->typeQualifier_ |= (buf.compare("true") == 0) ? CL_KERNEL_ARG_TYPE_PIPE : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "true") ? CL_KERNEL_ARG_TYPE_PIPE : 0;
       break;
     default:
       return AMD_COMGR_STATUS_ERROR;
@@ -189,78 +255,34 @@ static amd_comgr_status_t populateArgs(const amd_comgr_metadata_node_t key,
 static amd_comgr_status_t populateAttrs(const amd_comgr_metadata_node_t key,
                                         const amd_comgr_metadata_node_t value,
                                         void *data) {
-  amd_comgr_status_t status;
-  amd_comgr_metadata_kind_t kind;
-  size_t size = 0;
-  std::string buf;
-
-  // get the key of the argument field
-  status = amd::Comgr::get_metadata_kind(key, &kind);
-  if (kind == AMD_COMGR_METADATA_KIND_STRING && status == AMD_COMGR_STATUS_SUCCESS) {
-    status = getMetaBuf(key, &buf);
-  }
-
-  if (status != AMD_COMGR_STATUS_SUCCESS) {
-    return AMD_COMGR_STATUS_ERROR;
-  }
-
-  auto itAttrField = AttrFieldMap.find(buf);
-  if (itAttrField == AttrFieldMap.end()) {
+  auto itAttrField = findMetaKey(key, AttrFieldMap);
+  if (itAttrField == nullptr) {
     return AMD_COMGR_STATUS_ERROR;
   }
 
+  amd_comgr_status_t status = AMD_COMGR_STATUS_SUCCESS;
+  MetaString buf;
+  size_t dims[3];
   device::Kernel* kernel = static_cast<device::Kernel*>(data);
-  switch (itAttrField->second) {
+  switch (itAttrField->value_) {
     case AttrField::ReqdWorkGroupSize:
-      {
-        status = amd::Comgr::get_metadata_list_size(value, &size);
-        if (size == 3 && status == AMD_COMGR_STATUS_SUCCESS) {
-          std::vector<size_t> wrkSize;
-          for (size_t i = 0; i < size && status == AMD_COMGR_STATUS_SUCCESS; i++) {
-            amd_comgr_metadata_node_t workgroupSize;
-            status = amd::Comgr::index_list_metadata(value, i, &workgroupSize);
-
-            if (status == AMD_COMGR_STATUS_SUCCESS &&
-                getMetaBuf(workgroupSize, &buf) == AMD_COMGR_STATUS_SUCCESS) {
-              wrkSize.push_back(atoi(buf.c_str()));
-            }
-            amd::Comgr::destroy_metadata(workgroupSize);
-          }
-          if (!wrkSize.empty()) {
-            kernel->setReqdWorkGroupSize(wrkSize[0], wrkSize[1], wrkSize[2]);
-          }
-        }
+      if (getMetaDims(value, dims, &status)) {
+        kernel->setReqdWorkGroupSize(dims[0], dims[1], dims[2]);
       }
       break;
     case AttrField::WorkGroupSizeHint:
-      {
-        status = amd::Comgr::get_metadata_list_size(value, &size);
-        if (status == AMD_COMGR_STATUS_SUCCESS && size == 3) {
-          std::vector<size_t> hintSize;
-          for (size_t i = 0; i < size && status == AMD_COMGR_STATUS_SUCCESS; i++) {
-            amd_comgr_metadata_node_t workgroupSizeHint;
-            status = amd::Comgr::index_list_metadata(value, i, &workgroupSizeHint);
-
-            if (status == AMD_COMGR_STATUS_SUCCESS &&
-                getMetaBuf(workgroupSizeHint, &buf) == AMD_COMGR_STATUS_SUCCESS) {
-              hintSize.push_back(atoi(buf.c_str()));
-            }
-            amd::Comgr::destroy_metadata(workgroupSizeHint);
-          }
-          if (!hintSize.empty()) {
-            kernel->setWorkGroupSizeHint(hintSize[0], hintSize[1], hintSize[2]);
-          }
-        }
+      if (getMetaDims(value, dims, &status)) {
+        kernel->setWorkGroupSizeHint(dims[0], dims[1], dims[2]);
       }
       break;
     case AttrField::VecTypeHint:
-      if (getMetaBuf(value,&buf) == AMD_COMGR_STATUS_SUCCESS) {
-        kernel->setVecTypeHint(buf);
+      if (buf.get(value) == AMD_COMGR_STATUS_SUCCESS) {
+        kernel->setVecTypeHint(buf.str());
       }
       break;
     case AttrField::RuntimeHandle:
-      if (getMetaBuf(value,&buf) == AMD_COMGR_STATUS_SUCCESS) {
-        kernel->setRuntimeHandle(buf);
+      if (buf.get(value) == AMD_COMGR_STATUS_SUCCESS) {
+        kernel->setRuntimeHandle(buf.str());
       }
       break;
     default:
@@ -273,71 +295,46 @@ static amd_comgr_status_t populateAttrs(const amd_comgr_metadata_node_t key,
 static amd_comgr_status_t populateCodeProps(const amd_comgr_metadata_node_t key,
                                             const amd_comgr_metadata_node_t value,
                                             void *data) {
-  amd_comgr_status_t status;
-  amd_comgr_metadata_kind_t kind;
-  std::string buf;
-
-  // get the key of the argument field
-  status = amd::Comgr::get_metadata_kind(key, &kind);
-  if (kind == AMD_COMGR_METADATA_KIND_STRING && status == AMD_COMGR_STATUS_SUCCESS) {
-    status = getMetaBuf(key, &buf);
-  }
-
-  if (status != AMD_COMGR_STATUS_SUCCESS) {
-    return AMD_COMGR_STATUS_ERROR;
-  }
-
-  auto itCodePropField = CodePropFieldMap.find(buf);
-  if (itCodePropField == CodePropFieldMap.end()) {
+  auto itCodePropField = findMetaKey(key, CodePropFieldMap);
+  if (itCodePropField == nullptr) {
     return AMD_COMGR_STATUS_ERROR;
   }
 
   // get the value of the argument field
-  if (status == AMD_COMGR_STATUS_SUCCESS) {
-    status = getMetaBuf(value, &buf);
-  }
+  MetaString buf;
+  buf.get(value);
 
   device::Kernel*  kernel = static_cast<device::Kernel*>(data);
-  switch (itCodePropField->second) {
+  switch (itCodePropField->value_) {
     case CodePropField::KernargSegmentSize:
-      kernel->SetKernargSegmentByteSize(atoi(buf.c_str()));
+      kernel->SetKernargSegmentByteSize(buf.toInt());
       break;
     case CodePropField::GroupSegmentFixedSize:
-      kernel->SetWorkgroupGroupSegmentByteSize(atoi(buf.c_str()));
+      kernel->SetWorkgroupGroupSegmentByteSize(buf.toInt());
       break;
     case CodePropField::PrivateSegmentFixedSize:
-      kernel->SetWorkitemPrivateSegmentByteSize(atoi(buf.c_str()));
+      kernel->SetWorkitemPrivateSegmentByteSize(buf.toInt());
       break;
     case CodePropField::KernargSegmentAlign:
-      kernel->SetKernargSegmentAlignment(atoi(buf.c_str()));
+      kernel->SetKernargSegmentAlignment(buf.toInt());
       break;
     case CodePropField::WavefrontSize:
-      kernel->workGroupInfo()->wavefrontSize_ = atoi(buf.c_str());
+      kernel->workGroupInfo()->wavefrontSize_ = buf.toInt();
       break;
     case CodePropField::NumSGPRs:
-      kernel->workGroupInfo()->usedSGPRs_ = atoi(buf.c_str());
+      kernel->workGroupInfo()->usedSGPRs_ = buf.toInt();
       break;
     case CodePropField::NumVGPRs:
-      kernel->workGroupInfo()->usedVGPRs_ = atoi(buf.c_str());
+      kernel->workGroupInfo()->usedVGPRs_ = buf.toInt();
       break;
     case CodePropField::MaxFlatWorkGroupSize:
-      kernel->workGroupInfo()->size_ = atoi(buf.c_str());
-      break;
-    case CodePropField::IsDynamicCallStack: {
-      size_t mIsDynamicCallStack = (buf.compare("true") == 0);
-      }
+      kernel->workGroupInfo()->size_ = buf.toInt();
       break;
-    case CodePropField::IsXNACKEnabled: {
-      size_t mIsXNACKEnabled = (buf.compare("true") == 0);
-      }
-      break;
-    case CodePropField::NumSpilledSGPRs: {
-      size_t mNumSpilledSGPRs = atoi(buf.c_str());
-      }
-      break;
-    case CodePropField::NumSpilledVGPRs: {
-      size_t mNumSpilledVGPRs = atoi(buf.c_str());
-      }
+    case CodePropField::IsDynamicCallStack:
+    case CodePropField::IsXNACKEnabled:
+    case CodePropField::NumSpilledSGPRs:
+    case CodePropField::NumSpilledVGPRs:
+      // Not used by the runtime
       break;
     default:
       return AMD_COMGR_STATUS_ERROR;
@@ -348,53 +345,45 @@ static amd_comgr_status_t populateCodeProps(const amd_comgr_metadata_node_t key,
 static amd_comgr_status_t populateArgsV3(const amd_comgr_metadata_node_t key,
                                          const amd_comgr_metadata_node_t value,
                                          void *data) {
-  amd_comgr_status_t status;
-  amd_comgr_metadata_kind_t kind;
-  std::string buf;
-
-  // get the key of the argument field
-  size_t size = 0;
-  status = amd::Comgr::get_metadata_kind(key, &kind);
-  if (kind == AMD_COMGR_METADATA_KIND_STRING && status == AMD_COMGR_STATUS_SUCCESS) {
-    status = getMetaBuf(key, &buf);
-  }
-
-  if (status != AMD_COMGR_STATUS_SUCCESS) {
+  auto itArgField = findMetaKey(key, ArgFieldMapV3);
+  if (itArgField == nullptr) {
     return AMD_COMGR_STATUS_ERROR;
   }
 
-  auto itArgField = ArgFieldMapV3.find(buf);
-  if (itArgField == ArgFieldMapV3.end()) {
-    return AMD_COMGR_STATUS_ERROR;
+  amd::KernelParameterDescriptor* lcArg = static_cast<amd::KernelParameterDescriptor*>(data);
+
+  // HIP uses the argument names and types only in the logs, hence skip the decoding otherwise
+  if (!needArgNames() &&
+      (itArgField->value_ == ArgField::Name || itArgField->value_ == ArgField::TypeName)) {
+    return AMD_COMGR_STATUS_SUCCESS;
   }
 
   // get the value of the argument field
-  status = getMetaBuf(value, &buf);
-
-  amd::KernelParameterDescriptor* lcArg = static_cast<amd::KernelParameterDescriptor*>(data);
+  MetaString buf;
+  buf.get(value);
 
-  switch (itArgField->second) {
+  switch (itArgField->value_) {
     case ArgField::Name:
-      lcArg->name_ = buf;
+      lcArg->name_ = buf.str();
       break;
     case ArgField::TypeName:
-      lcArg->typeName_ = buf;
+      lcArg->typeName_ = buf.str();
       break;
     case ArgField::Size:
-      lcArg->size_ = atoi(buf.c_str());
+      lcArg->size_ = buf.toInt();
       break;
     case ArgField::Offset:
-      lcArg->offset_ = atoi(buf.c_str());
+      lcArg->offset_ = buf.toInt();
       break;
     case ArgField::ValueKind:
       {
-        auto itValueKind = ArgValueKindV3.find(buf);
-        if (itValueKind == ArgValueKindV3.end()) {
+        auto itValueKind = ArgValueKindV3.find(buf.view());
+        if (itValueKind == nullptr) {
           return AMD_COMGR_STATUS_ERROR;
         }
-        lcArg->info_.oclObject_ = itValueKind->second;
+        lcArg->info_.oclObject_ = itValueKind->value_;
         if (lcArg->info_.oclObject_ == amd::KernelParameterDescriptor::MemoryObject) {
-          if (itValueKind->first.compare("dynamic_shared_pointer") == 0) {
+          if (itValueKind->key_ == "dynamic_shared_pointer") {
             lcArg->info_.shared_ = true;
           }
         } else if ((lcArg->info_.oclObject_ >= amd::KernelParameterDescriptor::HiddenNone) &&
@@ -404,24 +393,24 @@ static amd_comgr_status_t populateArgsV3(const amd_comgr_metadata_node_t key,
       }
       break;
     case ArgField::PointeeAlign:
-      lcArg->info_.arrayIndex_ = atoi(buf.c_str());
+      lcArg->info_.arrayIndex_ = buf.toInt();
       break;
     case ArgField::AddrSpaceQual:
       {
-        auto itAddrSpaceQual = ArgAddrSpaceQualV3.find(buf);
-        if (itAddrSpaceQual == ArgAddrSpaceQualV3.end()) {
+        auto itAddrSpaceQual = ArgAddrSpaceQualV3.find(buf.view());
+        if (itAddrSpaceQual == nullptr) {
           return AMD_COMGR_STATUS_ERROR;
         }
-        lcArg->addressQualifier_ = itAddrSpaceQual->second;
+        lcArg->addressQualifier_ = itAddrSpaceQual->value_;
       }
       break;
     case ArgField::AccQual:
       {
-        auto itAccQual = ArgAccQualV3.find(buf);
-        if (itAccQual == ArgAccQualV3.end()) {
+        auto itAccQual = ArgAccQualV3.find(buf.view());
+        if (itAccQual == nullptr) {
           return AMD_COMGR_STATUS_ERROR;
         }
-        lcArg->accessQualifier_ = itAccQual->second;
+        lcArg->accessQualifier_ = itAccQual->value_;
         if (!lcArg->info_.isReadOnlyByCompiler) {
           lcArg->info_.readOnly_ =
             (lcArg->accessQualifier_ == CL_KERNEL_ARG_ACCESS_READ_ONLY) ? true : false;
@@ -430,26 +419,26 @@ static amd_comgr_status_t populateArgsV3(const amd_comgr_metadata_node_t key,
       break;
     case ArgField::ActualAccQual:
       {
-        auto itAccQual = ArgAccQualV3.find(buf);
-        if (itAccQual == ArgAccQualV3.end()) {
+        auto itAccQual = ArgAccQualV3.find(buf.view());
+        if (itAccQual == nullptr) {
             return AMD_COMGR_STATUS_ERROR;
         }
         lcArg->info_.isReadOnlyByCompiler = true;
         lcArg->info_.readOnly_ =
-          (itAccQual->second == CL_KERNEL_ARG_ACCESS_READ_ONLY) ? true : false;
+          (itAccQual->value_ == CL_KERNEL_ARG_ACCESS_READ_ONLY) ? true : false;
       }
       break;
     case ArgField::IsConst:
-      lcArg->typeQualifier_ |= (buf.compare("1") == 0) ? CL_KERNEL_ARG_TYPE_CONST : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "1") ? CL_KERNEL_ARG_TYPE_CONST : 0;
       break;
     case ArgField::IsRestrict:
-      lcArg->typeQualifier_ |= (buf.compare("1") == 0) ? CL_KERNEL_ARG_TYPE_RESTRICT : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "1") ? CL_KERNEL_ARG_TYPE_RESTRICT : 0;
       break;
     case ArgField::IsVolatile:
-      lcArg->typeQualifier_ |= (buf.compare("1") == 0) ? CL_KERNEL_ARG_TYPE_VOLATILE : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "1") ? CL_KERNEL_ARG_TYPE_VOLATILE : 0;
       break;
     case ArgField::IsPipe:
-      lcArg->typeQualifier_ |= (buf.compare("1") == 0) ? CL_KERNEL_ARG_TYPE_PIPE : 0;
+      lcArg->typeQualifier_ |= (buf.view() == "1") ? CL_KERNEL_ARG_TYPE_PIPE : 0;
       break;
     default:
       return AMD_COMGR_STATUS_ERROR;
@@ -460,122 +449,79 @@ static amd_comgr_status_t populateArgsV3(const amd_comgr_metadata_node_t key,
 static amd_comgr_status_t populateKernelMetaV3(const amd_comgr_metadata_node_t key,
                                                const amd_comgr_metadata_node_t value,
                                                void *data) {
-  amd_comgr_status_t status;
-  amd_comgr_metadata_kind_t kind;
-  size_t size = 0;
-  std::string buf;
-  // get the key of the argument field
-  status = amd::Comgr::get_metadata_kind(key, &kind);
-  if (kind == AMD_COMGR_METADATA_KIND_STRING && status == AMD_COMGR_STATUS_SUCCESS) {
-    status = getMetaBuf(key, &buf);
-  }
-
-  if (status != AMD_COMGR_STATUS_SUCCESS) {
+  auto itKernelField = findMetaKey(key, KernelFieldMapV3);
+  if (itKernelField == nullptr) {
     return AMD_COMGR_STATUS_ERROR;
   }
 
-  auto itKernelField = KernelFieldMapV3.find(buf);
-  if (itKernelField == KernelFieldMapV3.end()) {
-    return AMD_COMGR_STATUS_ERROR;
-  }
-
-  if (itKernelField->second != KernelField::ReqdWorkGroupSize &&
-      itKernelField->second != KernelField::WorkGroupSizeHint) {
-      status = getMetaBuf(value,&buf);
+  amd_comgr_status_t status = AMD_COMGR_STATUS_SUCCESS;
+  MetaString buf;
+  if (itKernelField->value_ != KernelField::ReqdWorkGroupSize &&
+      itKernelField->value_ != KernelField::WorkGroupSizeHint) {
+      status = buf.get(value);
   }
   if (status != AMD_COMGR_STATUS_SUCCESS) {
     return AMD_COMGR_STATUS_ERROR;
   }
 
+  size_t dims[3];
   device::Kernel* kernel = static_cast<device::Kernel*>(data);
-  switch (itKernelField->second) {
+  switch (itKernelField->value_) {
     case KernelField::ReqdWorkGroupSize:
-      status = amd::Comgr::get_metadata_list_size(value, &size);
-      if (size == 3 && status == AMD_COMGR_STATUS_SUCCESS) {
-        std::vector<size_t> wrkSize;
-        for (size_t i = 0; i < size && status == AMD_COMGR_STATUS_SUCCESS; i++) {
-          amd_comgr_metadata_node_t workgroupSize;
-          status = amd::Comgr::index_list_metadata(value, i, &workgroupSize);
-
-          if (status == AMD_COMGR_STATUS_SUCCESS &&
-              getMetaBuf(workgroupSize, &buf) == AMD_COMGR_STATUS_SUCCESS) {
-            wrkSize.push_back(atoi(buf.c_str()));
-          }
-          amd::Comgr::destroy_metadata(workgroupSize);
-        }
-        if (!wrkSize.empty()) {
-          kernel->setReqdWorkGroupSize(wrkSize[0], wrkSize[1], wrkSize[2]);
-        }
+      if (getMetaDims(value, dims, &status)) {
+        kernel->setReqdWorkGroupSize(dims[0], dims[1], dims[2]);
       }
       break;
     case KernelField::WorkGroupSizeHint:
-      status = amd::Comgr::get_metadata_list_size(value, &size);
-      if (status == AMD_COMGR_STATUS_SUCCESS && size == 3) {
-        std::vector<size_t> hintSize;
-        for (size_t i = 0; i < size && status == AMD_COMGR_STATUS_SUCCESS; i++) {
-          amd_comgr_metadata_node_t workgroupSizeHint;
-          status = amd::Comgr::index_list_metadata(value, i, &workgroupSizeHint);
-
-          if (status == AMD_COMGR_STATUS_SUCCESS &&
-              getMetaBuf(workgroupSizeHint, &buf) == AMD_COMGR_STATUS_SUCCESS) {
-            hintSize.push_back(atoi(buf.c_str()));
-          }
-          amd::Comgr::destroy_metadata(workgroupSizeHint);
-        }
-        if (!hintSize.empty()) {
-          kernel->setWorkGroupSizeHint(hintSize[0], hintSize[1], hintSize[2]);
-        }
+      if (getMetaDims(value, dims, &status)) {
+        kernel->setWorkGroupSizeHint(dims[0], dims[1], dims[2]);
       }
       break;
     case KernelField::VecTypeHint:
-      kernel->setVecTypeHint(buf);
+      kernel->setVecTypeHint(buf.str());
       break;
     case KernelField::DeviceEnqueueSymbol:
-      kernel->setRuntimeHandle(buf);
+      kernel->setRuntimeHandle(buf.str());
       break;
     case KernelField::KernargSegmentSize:
-      kernel->SetKernargSegmentByteSize(atoi(buf.c_str()));
+      kernel->SetKernargSegmentByteSize(buf.toInt());
       break;
     case KernelField::GroupSegmentFixedSize:
-      kernel->SetWorkgroupGroupSegmentByteSize(atoi(buf.c_str()));
+      kernel->SetWorkgroupGroupSegmentByteSize(buf.toInt());
       break;
     case KernelField::PrivateSegmentFixedSize:
-      kernel->SetWorkitemPrivateSegmentByteSize(atoi(buf.c_str()));
+      kernel->SetWorkitemPrivateSegmentByteSize(buf.toInt());
       break;
     case KernelField::KernargSegmentAlign:
-      kernel->SetKernargSegmentAlignment(atoi(buf.c_str()));
+      kernel->SetKernargSegmentAlignment(buf.toInt());
       break;
     case KernelField::WavefrontSize:
-      kernel->workGroupInfo()->wavefrontSize_ = atoi(buf.c_str());
+      kernel->workGroupInfo()->wavefrontSize_ = buf.toInt();
       break;
     case KernelField::NumSGPRs:
-      kernel->workGroupInfo()->usedSGPRs_ = atoi(buf.c_str());
+      kernel->workGroupInfo()->usedSGPRs_ = buf.toInt();
       break;
     case KernelField::NumVGPRs:
-      kernel->workGroupInfo()->usedVGPRs_ = atoi(buf.c_str());
+      kernel->workGroupInfo()->usedVGPRs_ = buf.toInt();
       break;
     case KernelField::MaxFlatWorkGroupSize:
-      kernel->workGroupInfo()->size_ = atoi(buf.c_str());
-      break;
-    case KernelField::NumSpilledSGPRs: {
-      size_t mNumSpilledSGPRs = atoi(buf.c_str());
-      }
+      kernel->workGroupInfo()->size_ = buf.toInt();
       break;
-    case KernelField::NumSpilledVGPRs: {
-      size_t mNumSpilledVGPRs = atoi(buf.c_str());
-      }
+    case KernelField::NumSpilledSGPRs:
+    case KernelField::NumSpilledVGPRs:
+      // Not used by the runtime
       break;
     case KernelField::SymbolName:
-      kernel->SetSymbolName(buf);
+      kernel->SetSymbolName(buf.str());
       break;
     case KernelField::Kind:
-      kernel->SetKernelKind(buf);
+      kernel->SetKernelKind(buf.str());
       break;
     case KernelField::WgpMode:
-      kernel->SetWGPMode(buf.compare("true") == 0);
+      kernel->SetWGPMode(buf.view() == "true");
       break;
     case KernelField::UniformWrokGroupSize:
-      kernel->setUniformWorkGroupSize(buf.compare("true") == 0);
+      kernel->setUniformWorkGroupSize(buf.view() == "true");
       break;
     default:
       return AMD_COMGR_STATUS_ERROR;
@@ -684,6 +630,19 @@ void Kernel::FindLocalWorkSize(size_t workDim, const amd::NDRange& gblWorkSize,
   if (workGroupInfo()->compileSize_[0] == 0) {
     // Find the default local workgroup size, if it wasn't specified
     if (lclWorkSize[0] == 0) {
+      // Check if the default workgroup shape was already found for this global size
+      decltype(localSizeCache_)::Key key = {workDim, 0, 0, 0};
+      decltype(localSizeCache_)::Value value = {};
+      for (uint d = 0; d < workDim; ++d) {
+        key[d + 1] = gblWorkSize[d];
+      }
+      if (localSizeCache_.find(key, value)) {
+        for (uint d = 0; d < workDim; ++d) {
+          lclWorkSize[d] = value[d];
+        }
+        return;
+      }
+
       // Find threads per group
       size_t thrPerGrp = workGroupInfo()->size_;
 
@@ -760,6 +719,10 @@ void Kernel::FindLocalWorkSize(size_t workDim, const amd::NDRange& gblWorkSize,
           }
         }
       }
+      for (uint d = 0; d < workDim; ++d) {
+        value[d] = lclWorkSize[d];
+      }
+      localSizeCache_.insert(key, value);
     }
   }
   else {
@@ -769,6 +732,35 @@ void Kernel::FindLocalWorkSize(size_t workDim, const amd::NDRange& gblWorkSize,
   }
 }
 
+// ================================================================================================
+bool Kernel::FindCachedOccupancy(int blockSize, size_t dynamicLdsSize, bool potentialBlockSize,
+                                 Occupancy* occupancy) const {
+  const decltype(occupancyCache_)::Key key = {
+      (static_cast<uint64_t>(potentialBlockSize) << 32) | static_cast<uint32_t>(blockSize),
+      dynamicLdsSize};
+  decltype(occupancyCache_)::Value value;
+  if (!occupancyCache_.find(key, value)) {
+    return false;
+  }
+  occupancy->maxBlocksPerCU_ = static_cast<int>(static_cast<uint32_t>(value[0]));
+  occupancy->bestBlockSize_ = static_cast<int>(static_cast<uint32_t>(value[0] >> 32));
+  occupancy->numBlocksPerGrid_ = static_cast<int>(value[1]);
+  return true;
+}
+
+// ================================================================================================
+void Kernel::CacheOccupancy(int blockSize, size_t dynamicLdsSize, bool potentialBlockSize,
+                            const Occupancy& occupancy) const {
+  const decltype(occupancyCache_)::Key key = {
+      (static_cast<uint64_t>(potentialBlockSize) << 32) | static_cast<uint32_t>(blockSize),
+      dynamicLdsSize};
+  const decltype(occupancyCache_)::Value value = {
+      (static_cast<uint64_t>(static_cast<uint32_t>(occupancy.bestBlockSize_)) << 32) |
+          static_cast<uint32_t>(occupancy.maxBlocksPerCU_),
+      static_cast<uint32_t>(occupancy.numBlocksPerGrid_)};
+  occupancyCache_.insert(key, value);
+}
+
 // ================================================================================================
 #if defined(WITH_COMPILER_LIB)
 static inline uint32_t GetOclArgumentTypeOCL(const aclArgData* argInfo, bool* isHidden) {
@@ -1142,6 +1134,20 @@ bool Kernel::GetAttrCodePropMetadata() {
 }
 
 bool Kernel::SetAvailableSgprVgpr() {
+  // The addressable register counts depend on the ISA only, hence decode them once per ISA
+  static amd::Monitor gprLock("Addressable GPRs lock");
+  static std::unordered_map<const amd::Isa*, std::pair<uint32_t, uint32_t>> gprCache;
+  const amd::Isa* isa = &prog().device().isa();
+  {
+    amd::ScopedLock lock(gprLock);
+    auto it = gprCache.find(isa);
+    if (it != gprCache.end()) {
+      workGroupInfo_.availableSGPRs_ = it->second.first;
+      workGroupInfo_.availableVGPRs_ = it->second.second;
+      return true;
+    }
+  }
+
   std::string buf;
 
   amd_comgr_metadata_node_t isaMeta;
@@ -1188,48 +1194,17 @@ bool Kernel::SetAvailableSgprVgpr() {
     amd::Comgr::destroy_metadata(isaMeta);
   }
 
-  return (status == AMD_COMGR_STATUS_SUCCESS);
-}
-
-bool Kernel::GetPrintfStr(std::vector<std::string>* printfStr) {
-  const amd_comgr_metadata_node_t programMD = prog().metadata();
-  amd_comgr_metadata_node_t printfMeta;
-
-  amd_comgr_status_t status = amd::Comgr::metadata_lookup(programMD,
-                                codeObjectVer() == 2 ? "Printf" : "amdhsa.printf", &printfMeta);
-  if (status != AMD_COMGR_STATUS_SUCCESS) {
-    return true;   // printf string metadata is not provided so just exit
-  }
-
-  // handle the printf string
-  size_t printfSize = 0;
-  status = amd::Comgr::get_metadata_list_size(printfMeta, &printfSize);
-
   if (status == AMD_COMGR_STATUS_SUCCESS) {
-    std::string buf;
-    for (size_t i = 0; i < printfSize; ++i) {
-      amd_comgr_metadata_node_t str;
-      status = amd::Comgr::index_list_metadata(printfMeta, i, &str);
-
-      if (status == AMD_COMGR_STATUS_SUCCESS) {
-        status = getMetaBuf(str, &buf);
-        amd::Comgr::destroy_metadata(str);
-      }
-
-      if (status != AMD_COMGR_STATUS_SUCCESS) {
-        DevLogPrintfError("Comgr API failed with status: %d \n", status);
-        amd::Comgr::destroy_metadata(printfMeta);
-        return false;
-      }
-
-      printfStr->push_back(buf);
-    }
+    amd::ScopedLock lock(gprLock);
+    gprCache[isa] = {workGroupInfo_.availableSGPRs_, workGroupInfo_.availableVGPRs_};
   }
-
-  amd::Comgr::destroy_metadata(printfMeta);
   return (status == AMD_COMGR_STATUS_SUCCESS);
 }
 
+bool Kernel::GetPrintfStr(const std::vector<std::string>** printfStr) {
+  return prog().getPrintfStrings(printfStr);
+}
+
 void Kernel::InitParameters(const amd_comgr_metadata_node_t kernelMD) {
   // Iterate through the arguments and insert into parameterList
   device::Kernel::parameters_t params;
@@ -26,6 +26,7 @@
 #include "platform/context.hpp"
 #include "platform/object.hpp"
 #include "platform/memory.hpp"
+#include "utils/concurrent.hpp"
 
 namespace amd {
 class Device;
@@ -107,6 +108,8 @@ struct RuntimeHandle {
 
 #include "amd_comgr/amd_comgr.h"
 
+#include "device/devmetakey.hpp"
+
 //  for Code Object V3
 enum class ArgField : uint8_t {
   Name          = 0,
@@ -148,7 +151,7 @@ enum class CodePropField : uint8_t {
 };
 
 
-static const std::map<std::string, ArgField> ArgFieldMap =
+static const MetaKeyTable<ArgField> ArgFieldMap =
 {
   {"Name",          ArgField::Name},
   {"TypeName",      ArgField::TypeName},
@@ -165,7 +168,7 @@ static const std::map<std::string, ArgField> ArgFieldMap =
   {"IsPipe",        ArgField::IsPipe}
 };
 
-static const std::map<std::string, uint32_t> ArgValueKind = {
+static const MetaKeyTable<uint32_t> ArgValueKind = {
   {"ByValue",                 amd::KernelParameterDescriptor::ValueObject},
   {"GlobalBuffer",            amd::KernelParameterDescriptor::MemoryObject},
   {"DynamicSharedPointer",    amd::KernelParameterDescriptor::MemoryObject},
@@ -184,14 +187,14 @@ static const std::map<std::string, uint32_t> ArgValueKind = {
   {"HiddenHostcallBuffer",    amd::KernelParameterDescriptor::HiddenHostcallBuffer}
 };
 
-static const std::map<std::string, cl_kernel_arg_access_qualifier> ArgAccQual = {
+static const MetaKeyTable<cl_kernel_arg_access_qualifier> ArgAccQual = {
   {"Default",   CL_KERNEL_ARG_ACCESS_NONE},
   {"ReadOnly",  CL_KERNEL_ARG_ACCESS_READ_ONLY},
   {"WriteOnly", CL_KERNEL_ARG_ACCESS_WRITE_ONLY},
   {"ReadWrite", CL_KERNEL_ARG_ACCESS_READ_WRITE}
 };
 
-static const std::map<std::string, cl_kernel_arg_address_qualifier> ArgAddrSpaceQual = {
+static const MetaKeyTable<cl_kernel_arg_address_qualifier> ArgAddrSpaceQual = {
   {"Private",   CL_KERNEL_ARG_ADDRESS_PRIVATE},
   {"Global",    CL_KERNEL_ARG_ADDRESS_GLOBAL},
   {"Constant",  CL_KERNEL_ARG_ADDRESS_CONSTANT},
@@ -200,7 +203,7 @@ static const std::map<std::string, cl_kernel_arg_address_qualifier> ArgAddrSpace
   {"Region",    CL_KERNEL_ARG_ADDRESS_PRIVATE}
 };
 
-static const std::map<std::string,AttrField> AttrFieldMap =
+static const MetaKeyTable<AttrField> AttrFieldMap =
 {
   {"ReqdWorkGroupSize",   AttrField::ReqdWorkGroupSize},
   {"WorkGroupSizeHint",   AttrField::WorkGroupSizeHint},
@@ -208,7 +211,7 @@ static const std::map<std::string,AttrField> AttrFieldMap =
   {"RuntimeHandle",       AttrField::RuntimeHandle}
 };
 
-static const std::map<std::string,CodePropField> CodePropFieldMap =
+static const MetaKeyTable<CodePropField> CodePropFieldMap =
 {
   {"KernargSegmentSize",      CodePropField::KernargSegmentSize},
   {"GroupSegmentFixedSize",   CodePropField::GroupSegmentFixedSize},
@@ -246,7 +249,7 @@ enum class KernelField : uint8_t {
   UniformWrokGroupSize    = 17
 };
 
-static const std::map<std::string,ArgField> ArgFieldMapV3 =
+static const MetaKeyTable<ArgField> ArgFieldMapV3 =
 {
   {".name",           ArgField::Name},
   {".type_name",      ArgField::TypeName},
@@ -263,7 +266,7 @@ static const std::map<std::string,ArgField> ArgFieldMapV3 =
   {".is_pipe",        ArgField::IsPipe}
 };
 
-static const std::map<std::string, uint32_t> ArgValueKindV3 = {
+static const MetaKeyTable<uint32_t> ArgValueKindV3 = {
   {"by_value",                  amd::KernelParameterDescriptor::ValueObject},
   {"global_buffer",             amd::KernelParameterDescriptor::MemoryObject},
   {"dynamic_shared_pointer",    amd::KernelParameterDescriptor::MemoryObject},
@@ -297,14 +300,14 @@ static const std::map<std::string, uint32_t> ArgValueKindV3 = {
   {"hidden_dynamic_lds_size",   amd::KernelParameterDescriptor::HiddenDynamicLdsSize}
 };
 
-static const std::map<std::string, cl_kernel_arg_access_qualifier> ArgAccQualV3 = {
+static const MetaKeyTable<cl_kernel_arg_access_qualifier> ArgAccQualV3 = {
   {"default",    CL_KERNEL_ARG_ACCESS_NONE},
   {"read_only",  CL_KERNEL_ARG_ACCESS_READ_ONLY},
   {"write_only", CL_KERNEL_ARG_ACCESS_WRITE_ONLY},
   {"read_write", CL_KERNEL_ARG_ACCESS_READ_WRITE}
 };
 
-static const std::map<std::string, cl_kernel_arg_address_qualifier> ArgAddrSpaceQualV3 = {
+static const MetaKeyTable<cl_kernel_arg_address_qualifier> ArgAddrSpaceQualV3 = {
   {"private",   CL_KERNEL_ARG_ADDRESS_PRIVATE},
   {"global",    CL_KERNEL_ARG_ADDRESS_GLOBAL},
   {"constant",  CL_KERNEL_ARG_ADDRESS_CONSTANT},
@@ -313,7 +316,7 @@ static const std::map<std::string, cl_kernel_arg_address_qualifier> ArgAddrSpace
   {"region",    CL_KERNEL_ARG_ADDRESS_PRIVATE}
 };
 
-static const std::map<std::string,KernelField> KernelFieldMapV3 = {
+static const MetaKeyTable<KernelField> KernelFieldMapV3 = {
   {".symbol",                     KernelField::SymbolName},
   {".reqd_workgroup_size",        KernelField::ReqdWorkGroupSize},
   {".workgroup_size_hint",        KernelField::WorkGroupSizeHint},
@@ -488,6 +491,25 @@ class Kernel : public amd::HeapObject {
     amd::NDRange& lclWorkSize         //!< Calculated local work size
   ) const;
 
+  //! Occupancy of the kernel for a launch configuration
+  struct Occupancy {
+    int maxBlocksPerCU_;    //!< The max number of blocks per CU
+    int numBlocksPerGrid_;  //!< The number of blocks per grid for the max occupancy
+    int bestBlockSize_;     //!< The block size, which gives the max occupancy
+  };
+
+  //! Finds the occupancy for the launch configuration in the cache
+  bool FindCachedOccupancy(
+    int blockSize,            //!< Block size limit or requested block size
+    size_t dynamicLdsSize,    //!< Dynamic LDS size
+    bool potentialBlockSize,  //!< TRUE if the potential block size was requested
+    Occupancy* occupancy      //!< Cached occupancy
+  ) const;
+
+  //! Saves the occupancy for the launch configuration in the cache
+  void CacheOccupancy(int blockSize, size_t dynamicLdsSize, bool potentialBlockSize,
+                      const Occupancy& occupancy) const;
+
   const uint64_t KernelCodeHandle() const { return kernelCodeHandle_; }
 
   const uint32_t WorkgroupGroupSegmentByteSize() const { return workgroupGroupSegmentByteSize_; }
@@ -529,7 +551,7 @@ class Kernel : public amd::HeapObject {
   bool SetAvailableSgprVgpr();
 
   //! Retrieve the printf string metadata
-  bool GetPrintfStr(std::vector<std::string>* printfStr);
+  bool GetPrintfStr(const std::vector<std::string>** printfStr);
 
   //! Returns the kernel symbol name
   const std::string& symbolName() const { return symbolName_; }
@@ -589,6 +611,11 @@ class Kernel : public amd::HeapObject {
 
   std::unordered_map<size_t, size_t> patchReferences_;  //!< Patch table for references
 
+  //! The cache of the default workgroup shapes. Key: work dimension and global size
+  mutable amd::ConcurrentCache<4, 3> localSizeCache_;
+  //! The cache of the occupancy results. Key: block size, request type and dynamic LDS
+  mutable amd::ConcurrentCache<2, 2> occupancyCache_;
+
   enum KernelKind{
     Normal = 0,
     Init   = 1,
@@ -600,5 +627,33 @@ class Kernel : public amd::HeapObject {
 
 #if defined(USE_COMGR_LIBRARY)
 amd_comgr_status_t getMetaBuf(const amd_comgr_metadata_node_t meta, std::string* str);
+
+//! Metadata string, decoded into a local buffer to avoid heap allocations for short strings
+class MetaString {
+ public:
+  MetaString() : data_(local_), size_(0) { local_[0] = '\0'; }
+
+  //! Decodes the string value of the metadata node
+  amd_comgr_status_t get(const amd_comgr_metadata_node_t meta);
+
+  std::string_view view() const { return std::string_view(data_, size_); }
+  std::string str() const { return std::string(data_, size_); }
+  const char* c_str() const { return data_; }
+
+  //! Returns the decimal value of the string, 0 if the string isn't a number
+  int toInt() const;
+
+ private:
+  //! Disable copy constructor
+  MetaString(const MetaString&);
+
+  //! Disable operator=
+  MetaString& operator=(const MetaString&);
+
+  char local_[64];    //!< Buffer for short strings
+  std::string heap_;  //!< Buffer for long strings
+  const char* data_;  //!< The decoded string, null terminated
+  size_t size_;       //!< The string size without the null character
+};
 #endif // defined(USE_COMGR_LIBRARY)
 } // namespace device
@@ -0,0 +1,82 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <vector>
+
+//! Static lookup table of the metadata keys and values. The keys are hashed into an open
+//! addressing table at construction, so a lookup is one hash and, usually, one compare
+//! without any string allocation
+template <typename T>
+class MetaKeyTable {
+ public:
+  struct Entry {
+    std::string_view key_;  //!< Metadata key
+    T value_;               //!< Decoded value
+  };
+
+  MetaKeyTable(std::initializer_list<Entry> entries) : entries_(entries) {
+    size_t size = 1;
+    while (size < 2 * entries_.size()) {
+      size <<= 1;
+    }
+    slots_.assign(size, kEmpty);
+    mask_ = size - 1;
+    for (size_t i = 0; i < entries_.size(); ++i) {
+      size_t slot = Hash(entries_[i].key_) & mask_;
+      while (slots_[slot] != kEmpty) {
+        slot = (slot + 1) & mask_;
+      }
+      slots_[slot] = static_cast<uint16_t>(i);
+    }
+  }
+
+  //! Returns the entry of the key or nullptr if the key is unknown
+  const Entry* find(std::string_view key) const {
+    for (size_t slot = Hash(key) & mask_; slots_[slot] != kEmpty; slot = (slot + 1) & mask_) {
+      const Entry& entry = entries_[slots_[slot]];
+      if (entry.key_ == key) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  static constexpr uint16_t kEmpty = 0xffff;
+
+  //! FNV-1a hash of the key
+  static size_t Hash(std::string_view key) {
+    uint32_t hash = 2166136261u;
+    for (const char c : key) {
+      hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+    }
+    return hash;
+  }
+
+  std::vector<Entry> entries_;   //!< Table entries in the declaration order
+  std::vector<uint16_t> slots_;  //!< Hash slots with the entry indices
+  size_t mask_;                  //!< Mask of the slot index
+};
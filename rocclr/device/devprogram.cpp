@@ -2696,6 +2696,7 @@ bool Program::createKernelMetadataMap(void* binary, size_t binSize) {
 
   if (status == AMD_COMGR_STATUS_SUCCESS) {
     status = amd::Comgr::get_metadata_list_size(kernelsMD, &size);
+    kernelMetadataMap_.reserve(size);
   } else if (amd::IS_HIP) {
     // Assume an empty binary. HIP may have binaries with just global variables
     return true;
@@ -2749,6 +2750,47 @@ bool Program::createKernelMetadataMap(void* binary, size_t binSize) {
 }
 #endif
 
+#if defined(USE_COMGR_LIBRARY)
+// ================================================================================================
+bool Program::getPrintfStrings(const std::vector<std::string>** strings) const {
+  // The printf metadata is shared by all kernels of the program
+  std::call_once(printfOnce_, [this]() {
+    amd_comgr_metadata_node_t printfMeta;
+    amd_comgr_status_t status = amd::Comgr::metadata_lookup(metadata_,
+        codeObjectVer() == 2 ? "Printf" : "amdhsa.printf", &printfMeta);
+    if (status != AMD_COMGR_STATUS_SUCCESS) {
+      printfValid_ = true;   // printf string metadata is not provided so just exit
+      return;
+    }
+
+    size_t printfSize = 0;
+    status = amd::Comgr::get_metadata_list_size(printfMeta, &printfSize);
+    if (status == AMD_COMGR_STATUS_SUCCESS) {
+      printfStrings_.reserve(printfSize);
+    }
+    for (size_t i = 0; i < printfSize && status == AMD_COMGR_STATUS_SUCCESS; ++i) {
+      amd_comgr_metadata_node_t str;
+      status = amd::Comgr::index_list_metadata(printfMeta, i, &str);
+
+      if (status == AMD_COMGR_STATUS_SUCCESS) {
+        printfStrings_.emplace_back();
+        status = getMetaBuf(str, &printfStrings_.back());
+        amd::Comgr::destroy_metadata(str);
+      }
+    }
+    if (status != AMD_COMGR_STATUS_SUCCESS) {
+      DevLogPrintfError("Comgr API failed with status: %d \n", status);
+      printfStrings_.clear();
+    }
+    amd::Comgr::destroy_metadata(printfMeta);
+    printfValid_ = (status == AMD_COMGR_STATUS_SUCCESS);
+  });
+
+  *strings = &printfStrings_;
+  return printfValid_;
+}
+#endif
+
 bool Program::FindGlobalVarSize(void* binary, size_t binSize) {
 #if defined(USE_COMGR_LIBRARY)
   // HIP doesn't need information about global variable size.
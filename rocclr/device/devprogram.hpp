@@ -31,6 +31,9 @@
 #include "amd_comgr/amd_comgr.h"
 #endif  // defined(USE_COMGR_LIBRARY)
 
+#include <mutex>
+#include <unordered_map>
+
 namespace amd {
   namespace hsa {
     namespace loader {
@@ -162,7 +165,11 @@ class Program : public amd::HeapObject {
 #if defined(USE_COMGR_LIBRARY)
   amd_comgr_metadata_node_t metadata_ = {}; //!< COMgr metadata
   uint32_t codeObjectVer_;                  //!< version of code object
-  std::map<std::string, amd_comgr_metadata_node_t> kernelMetadataMap_; //!< Map of kernel metadata
+  //! Map of kernel metadata
+  std::unordered_map<std::string, amd_comgr_metadata_node_t> kernelMetadataMap_;
+  mutable std::once_flag printfOnce_;               //!< Decodes the printf metadata once
+  mutable std::vector<std::string> printfStrings_;  //!< Printf strings of all kernels
+  mutable bool printfValid_ = false;                //!< The printf metadata is valid
 #endif
   //! Sanitizer lock - lock when launching init/fini kernels
   static amd::Monitor initFiniLock_;
@@ -213,6 +220,9 @@ class Program : public amd::HeapObject {
   //! Return the build log.
   const std::string& buildLog() const { return buildLog_; }
 
+  //! Replace the build log, i.e. with the log of the build, which produced the code object
+  void setBuildLog(const std::string& log) { buildLog_ = log; }
+
   //! Return the build status.
   cl_build_status buildStatus() const { return buildStatus_; }
 
@@ -267,7 +277,7 @@ class Program : public amd::HeapObject {
   amd_comgr_metadata_node_t metadata() const { return metadata_; }
 
   //! Get the kernel metadata
-  const bool getKernelMetadata(const std::string name, amd_comgr_metadata_node_t* meta) const {
+  const bool getKernelMetadata(const std::string& name, amd_comgr_metadata_node_t* meta) const {
     auto it = kernelMetadataMap_.find(name);
     if (it != kernelMetadataMap_.end()) {
       *meta = it->second;
@@ -277,6 +287,9 @@ class Program : public amd::HeapObject {
   }
 
   const uint32_t codeObjectVer() const { return codeObjectVer_; }
+
+  //! Get the printf strings of the program, decoded from the metadata on the first call
+  bool getPrintfStrings(const std::vector<std::string>** strings) const;
 #endif
 
   //! Check if program is HIP based
@@ -558,13 +558,13 @@ bool LightningKernel::postLoad() {
   }
 
   // handle the printf metadata if any
-  std::vector<std::string> printfStr;
+  const std::vector<std::string>* printfStr = nullptr;
   if (!GetPrintfStr(&printfStr)) {
     return false;
   }
 
-  if (!printfStr.empty()) {
-    InitPrintf(printfStr);
+  if (!printfStr->empty()) {
+    InitPrintf(*printfStr);
   }
 
   return true;
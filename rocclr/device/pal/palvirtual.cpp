@@ -2511,6 +2511,25 @@ void VirtualGPU::submitKernel(amd::NDRangeKernelCommand& vcmd) {
   }
 }
 
+// ================================================================================================
+void VirtualGPU::submitKernelBatch(amd::KernelBatchCommand& vcmd) {
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+
+  profilingBegin(vcmd);
+
+  // The captured dispatches are tracked with the batch command, since they were never enqueued
+  for (const auto& cmd : vcmd.commands()) {
+    if (!submitKernelInternal(cmd->sizes(), cmd->kernel(), cmd->parameters(), false,
+                              cmd->sharedMemBytes(), cmd->getAnyOrderLaunchFlag())) {
+      vcmd.setStatus(CL_INVALID_OPERATION);
+      break;
+    }
+  }
+
+  profilingEnd(vcmd);
+}
+
 // ================================================================================================
 bool VirtualGPU::submitKernelInternal(const amd::NDRangeContainer& sizes,
                                       const amd::Kernel& kernel, const_address parameters,
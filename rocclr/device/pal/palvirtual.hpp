@@ -309,6 +309,7 @@ class VirtualGPU : public device::VirtualDevice {
   void submitMapMemory(amd::MapMemoryCommand& vcmd);
   void submitUnmapMemory(amd::UnmapMemoryCommand& vcmd);
   void submitKernel(amd::NDRangeKernelCommand& vcmd);
+  void submitKernelBatch(amd::KernelBatchCommand& vcmd);
   bool submitKernelInternal(
       const amd::NDRangeContainer& sizes,  //!< Workload sizes
       const amd::Kernel& kernel,           //!< Kernel for execution
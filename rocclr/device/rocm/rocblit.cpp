@@ -136,22 +136,31 @@ bool DmaBlitManager::readBuffer(device::Memory& srcMemory, void* dstHost,
     }
 
     if (0 != srcSize) {
-      Memory& xferBuf = dev().xferRead().acquire();
-
       // Read memory using a staging resource
-      if (!readMemoryStaged(gpuMem(srcMemory), dstHost, xferBuf, origin[0], offset, srcSize,
-                            srcSize)) {
-        LogError("DmaBlitManager::readBuffer failed!");
-        return false;
-      }
-
-      dev().xferRead().release(gpu(), xferBuf);
+      return readBufferStaged(gpuMem(srcMemory), dstHost, origin[0], offset, srcSize);
     }
   }
 
   return true;
 }
 
+// ================================================================================================
+bool DmaBlitManager::readBufferStaged(Memory& srcMemory, void* dstHost, size_t origin,
+                                      size_t offset, size_t size) const {
+  Memory* xferBuf = dev().xferRead().acquire();
+  if (xferBuf == nullptr) {
+    return false;
+  }
+
+  bool result = readMemoryStaged(srcMemory, dstHost, *xferBuf, origin, offset, size, size);
+  if (!result) {
+    LogError("DmaBlitManager::readBuffer failed!");
+  }
+
+  dev().xferRead().release(gpu(), *xferBuf);
+  return result;
+}
+
 // ================================================================================================
 bool DmaBlitManager::readBufferRect(device::Memory& srcMemory, void* dstHost,
                                     const amd::BufferRect& bufRect,
@@ -170,8 +179,11 @@ bool DmaBlitManager::readBufferRect(device::Memory& srcMemory, void* dstHost,
     return HostBlitManager::readBufferRect(srcMemory, dstHost, bufRect, hostRect, size,
                                            entire, copyMetadata);
   } else {
-    Memory& xferBuf = dev().xferRead().acquire();
-    address staging = xferBuf.getDeviceMemory();
+    Memory* xferBuf = dev().xferRead().acquire();
+    if (xferBuf == nullptr) {
+      return false;
+    }
+    address staging = xferBuf->getDeviceMemory();
     const_address src = gpuMem(srcMemory).getDeviceMemory();
 
     size_t srcOffset;
@@ -186,11 +198,12 @@ bool DmaBlitManager::readBufferRect(device::Memory& srcMemory, void* dstHost,
         address dst = reinterpret_cast<address>(dstHost) + dstOffset;
         bool retval = hsaCopyStaged(src + srcOffset, dst, size[0], staging, false);
         if (!retval) {
+          dev().xferRead().release(gpu(), *xferBuf);
           return retval;
         }
       }
     }
-    dev().xferRead().release(gpu(), xferBuf);
+    dev().xferRead().release(gpu(), *xferBuf);
   }
 
   return true;
@@ -308,22 +321,32 @@ bool DmaBlitManager::writeBuffer(const void* srcHost, device::Memory& dstMemory,
     }
 
     if (dstSize != 0) {
-      Memory& xferBuf = dev().xferWrite().acquire();
-
       // Write memory using a staging resource
-      if (!writeMemoryStaged(srcHost, gpuMem(dstMemory), xferBuf, origin[0], offset, dstSize,
-                             dstSize)) {
-        LogError("DmaBlitManager::writeBuffer failed!");
-        return false;
-      }
-
-      gpu().addXferWrite(xferBuf);
+      return writeBufferStaged(srcHost, gpuMem(dstMemory), origin[0], offset, dstSize);
     }
   }
 
   return true;
 }
 
+// ================================================================================================
+bool DmaBlitManager::writeBufferStaged(const void* srcHost, Memory& dstMemory, size_t origin,
+                                       size_t offset, size_t size) const {
+  Memory* xferBuf = dev().xferWrite().acquire();
+  if (xferBuf == nullptr) {
+    return false;
+  }
+
+  if (!writeMemoryStaged(srcHost, dstMemory, *xferBuf, origin, offset, size, size)) {
+    LogError("DmaBlitManager::writeBuffer failed!");
+    gpu().addXferWrite(*xferBuf);
+    return false;
+  }
+
+  gpu().addXferWrite(*xferBuf);
+  return true;
+}
+
 // ================================================================================================
 bool DmaBlitManager::writeBufferRect(const void* srcHost, device::Memory& dstMemory,
                                      const amd::BufferRect& hostRect,
@@ -338,8 +361,11 @@ bool DmaBlitManager::writeBufferRect(const void* srcHost, device::Memory& dstMem
     return HostBlitManager::writeBufferRect(srcHost, dstMemory, hostRect, bufRect, size, entire,
                                             copyMetadata);
   } else {
-    Memory& xferBuf = dev().xferWrite().acquire();
-    address staging = xferBuf.getDeviceMemory();
+    Memory* xferBuf = dev().xferWrite().acquire();
+    if (xferBuf == nullptr) {
+      return false;
+    }
+    address staging = xferBuf->getDeviceMemory();
     address dst = static_cast<roc::Memory&>(dstMemory).getDeviceMemory();
 
     size_t srcOffset;
@@ -354,11 +380,12 @@ bool DmaBlitManager::writeBufferRect(const void* srcHost, device::Memory& dstMem
         const_address src = reinterpret_cast<const_address>(srcHost) + srcOffset;
         bool retval = hsaCopyStaged(src, dst + dstOffset, size[0], staging, true);
         if (!retval) {
+          gpu().addXferWrite(*xferBuf);
           return retval;
         }
       }
     }
-    gpu().addXferWrite(xferBuf);
+    gpu().addXferWrite(*xferBuf);
   }
 
   return true;
@@ -1832,8 +1859,17 @@ bool KernelBlitManager::readBuffer(device::Memory& srcMemory, void* dstHost,
     return result;
   } else {
     size_t pinSize = size[0];
+    Device::XferPathTable* pathTable = dev().xferPathTable();
+    bool pinned = (pinSize > MinSizeForPinnedTransfer);
+    uint64_t start = 0;
+    if (pathTable != nullptr) {
+      pinned = (pathTable->select(Device::XferPathTable::Read, pinSize) ==
+                Device::XferPathTable::Pinned);
+      // Only synchronized copies are complete on return and can be measured
+      start = (pathTable->calibrate() && syncOperation_) ? amd::Os::timeNanos() : 0;
+    }
     // Check if a pinned transfer can be executed with a single pin
-    if ((pinSize <= dev().settings().pinnedXferSize_) && (pinSize > MinSizeForPinnedTransfer)) {
+    if (pinned && (pinSize <= dev().settings().pinnedXferSize_)) {
       size_t partial;
       amd::Memory* amdMemory = pinHostMemory(dstHost, pinSize, partial);
 
@@ -1856,8 +1892,20 @@ bool KernelBlitManager::readBuffer(device::Memory& srcMemory, void* dstHost,
 
       // Add pinned memory for a later release
       gpu().addPinnedMem(amdMemory);
-    } else {
+    } else if (pinned || (pathTable == nullptr)) {
       result = DmaBlitManager::readBuffer(srcMemory, dstHost, origin, size, entire, copyMetadata);
+    } else {
+      gpu().releaseGpuMemoryFence(kSkipCpuWait);
+      result = readBufferStaged(gpuMem(srcMemory), dstHost, origin[0], 0, pinSize);
+    }
+
+    if (start != 0) {
+      synchronize();
+      if (result) {
+        pathTable->record(Device::XferPathTable::Read, pinned ? Device::XferPathTable::Pinned
+                          : Device::XferPathTable::Staged, pinSize, amd::Os::timeNanos() - start);
+      }
+      return result;
     }
   }
 
@@ -1936,9 +1984,18 @@ bool KernelBlitManager::writeBuffer(const void* srcHost, device::Memory& dstMemo
     return result;
   } else {
     size_t pinSize = size[0];
+    Device::XferPathTable* pathTable = dev().xferPathTable();
+    bool pinned = (pinSize > MinSizeForPinnedTransfer);
+    uint64_t start = 0;
+    if (pathTable != nullptr) {
+      pinned = (pathTable->select(Device::XferPathTable::Write, pinSize) ==
+                Device::XferPathTable::Pinned);
+      // Only synchronized copies are complete on return and can be measured
+      start = (pathTable->calibrate() && syncOperation_) ? amd::Os::timeNanos() : 0;
+    }
 
     // Check if a pinned transfer can be executed with a single pin
-    if ((pinSize <= dev().settings().pinnedXferSize_) && (pinSize > MinSizeForPinnedTransfer)) {
+    if (pinned && (pinSize <= dev().settings().pinnedXferSize_)) {
       size_t partial;
       amd::Memory* amdMemory = pinHostMemory(srcHost, pinSize, partial);
 
@@ -1960,8 +2017,20 @@ bool KernelBlitManager::writeBuffer(const void* srcHost, device::Memory& dstMemo
 
       // Add pinned memory for a later release
       gpu().addPinnedMem(amdMemory);
-    } else {
+    } else if (pinned || (pathTable == nullptr)) {
       result = DmaBlitManager::writeBuffer(srcHost, dstMemory, origin, size, entire, copyMetadata);
+    } else {
+      gpu().releaseGpuMemoryFence(kSkipCpuWait);
+      result = writeBufferStaged(srcHost, gpuMem(dstMemory), origin[0], 0, pinSize);
+    }
+
+    if (start != 0) {
+      synchronize();
+      if (result) {
+        pathTable->record(Device::XferPathTable::Write, pinned ? Device::XferPathTable::Pinned
+                          : Device::XferPathTable::Staged, pinSize, amd::Os::timeNanos() - start);
+      }
+      return result;
     }
   }
 
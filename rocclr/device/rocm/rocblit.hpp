@@ -233,6 +233,22 @@ class DmaBlitManager : public device::HostBlitManager {
                const amd::Coord3D& dstOrigin, const amd::Coord3D& size,
                amd::CopyMetadata copyMetadata) const;
 
+  //! Reads a buffer object into system memory, using the staged buffers only
+  bool readBufferStaged(Memory& srcMemory,  //!< Source memory object
+                        void* dstHost,      //!< Destination host memory
+                        size_t origin,      //!< Original offset in the source memory
+                        size_t offset,      //!< Offset for the current copy pointer
+                        size_t size         //!< Size of the copy region
+                        ) const;
+
+  //! Writes system memory into a buffer object, using the staged buffers only
+  bool writeBufferStaged(const void* srcHost,  //!< Source host memory
+                         Memory& dstMemory,    //!< Destination memory object
+                         size_t origin,        //!< Original offset in the destination memory
+                         size_t offset,        //!< Offset for the current copy pointer
+                         size_t size           //!< Size of the copy region
+                         ) const;
+
   const size_t MinSizeForPinnedTransfer;
   bool completeOperation_;                    //!< DMA blit manager must complete operation
   amd::Context* context_;                     //!< A dummy context
@@ -26,6 +26,7 @@
 #include "utils/debug.hpp"
 #include "utils/flags.hpp"
 #include "utils/options.hpp"
+#include "utils/parallel.hpp"
 #include "utils/versions.hpp"
 #include "thread/monitor.hpp"
 #include "CL/cl_ext.h"
@@ -49,6 +50,7 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fstream>
 #include <iostream>
@@ -183,10 +185,13 @@ Device::Device(hsa_agent_t bkendDevice)
     , xferQueue_(nullptr)
     , xferRead_(nullptr)
     , xferWrite_(nullptr)
+    , memoryCache_(nullptr)
+    , xferPathTable_(nullptr)
     , freeMem_(0)
     , vgpusAccess_("Virtual GPU List Ops Lock", true)
     , hsa_exclusive_gpu_access_(false)
     , queuePool_(QueuePriority::Total)
+    , queuePoolAccess_("HSA Queue Pool Lock")
     , coopHostcallBuffer_(nullptr)
     , queueWithCUMaskPool_(QueuePriority::Total)
     , numOfVgpus_(0)
@@ -284,6 +289,17 @@ Device::~Device() {
   }
   queuePool_.clear();
 
+  if (xferPathTable_ != nullptr) {
+    // Persist the calibrated transfer paths for the next run
+    if (xferPathTable_->calibrate() && !flagIsDefault(ROC_XFER_PATH_TABLE)) {
+      const std::string fileName = std::string(ROC_XFER_PATH_TABLE) + "." + info().name_;
+      if (!xferPathTable_->save(fileName)) {
+        LogPrintfError("Couldn't save the transfer path table %s", fileName.c_str());
+      }
+    }
+    delete xferPathTable_;
+  }
+
   // Destroy temporary buffers for read/write
   delete xferRead_;
   delete xferWrite_;
@@ -308,6 +324,9 @@ Device::~Device() {
   if (0 != prefetch_signal_.handle) {
     hsa_signal_destroy(prefetch_signal_);
   }
+
+  // Release the cached memory after all device objects were destroyed
+  delete memoryCache_;
 }
 
 bool NullDevice::initCompiler(bool isOffline) {
@@ -395,10 +414,163 @@ hsa_status_t Device::loaderQueryHostAddress(const void* device, const void** hos
 
 Device::XferBuffers::~XferBuffers() {
   // Destroy temporary buffer for reads
-  for (const auto& buf : freeBuffers_) {
-    delete buf;
+  trim(0);
+}
+
+// ================================================================================================
+void* Device::MemoryCache::find(size_t size, size_t* p2pDevices) {
+  amd::ScopedLock l(lock_);
+  for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+    if (it->size_ == size) {
+      void* ptr = it->ptr_;
+      *p2pDevices = it->p2pDevices_;
+      cacheSize_ -= size;
+      blocks_.erase(it);
+      return ptr;
+    }
+  }
+  return nullptr;
+}
+
+// ================================================================================================
+bool Device::MemoryCache::add(void* ptr, size_t size, size_t p2pDevices) {
+  // Make sure current allocation isn't bigger than the cache
+  if (size > cacheSizeLimit_) {
+    return false;
+  }
+  // Validate the cache size limit, so the new block fits into the cache
+  trim(cacheSizeLimit_ - size);
+
+  amd::ScopedLock l(lock_);
+  blocks_.push_front({ptr, size, p2pDevices});
+  cacheSize_ += size;
+  return true;
+}
+
+// ================================================================================================
+bool Device::MemoryCache::trim(size_t limit) {
+  std::list<Block> released;
+  {
+    amd::ScopedLock l(lock_);
+    // Release the oldest blocks first
+    while (cacheSize_ > limit) {
+      cacheSize_ -= blocks_.back().size_;
+      released.splice(released.begin(), blocks_, std::prev(blocks_.end()));
+    }
+  }
+  for (const auto& it : released) {
+    gpuDevice_.memFree(it.ptr_, it.size_);
+  }
+  return !released.empty();
+}
+
+// ================================================================================================
+Device::XferPathTable::XferPathTable(size_t minPinnedSize, bool calibrate)
+    : lock_("ROC transfer path table", true), calibrate_(calibrate) {
+  for (uint32_t dir = 0; dir < TotalDirections; ++dir) {
+    for (uint32_t idx = 0; idx < TotalBuckets; ++idx) {
+      Bucket& bucket = buckets_[dir][idx];
+      bucket.stats_[Staged] = {0, 0.0};
+      bucket.stats_[Pinned] = {0, 0.0};
+      // Follow the static threshold until the bucket is calibrated
+      bucket.path_ = ((size_t(1) << (MinBucketShift + idx)) > minPinnedSize) ? Pinned : Staged;
+      bucket.fixed_ = false;
+    }
+  }
+}
+
+// ================================================================================================
+uint32_t Device::XferPathTable::bucket(size_t size) {
+  uint32_t idx = 0;
+  while ((idx < (TotalBuckets - 1)) && ((size_t(1) << (MinBucketShift + idx)) < size)) {
+    ++idx;
+  }
+  return idx;
+}
+
+// ================================================================================================
+Device::XferPathTable::Path Device::XferPathTable::select(Direction dir, size_t size) {
+  amd::ScopedLock l(lock_);
+  const Bucket& bucket = buckets_[dir][XferPathTable::bucket(size)];
+  if (calibrate_ && !bucket.fixed_) {
+    // Measure both paths before the choice, starting with the least sampled one
+    const Path path = (bucket.stats_[Pinned].samples_ < bucket.stats_[Staged].samples_) ?
+        Pinned : Staged;
+    if (bucket.stats_[path].samples_ < MinSamples) {
+      return path;
+    }
   }
-  freeBuffers_.clear();
+  return bucket.path_;
+}
+
+// ================================================================================================
+void Device::XferPathTable::record(Direction dir, Path path, size_t size, uint64_t time) {
+  if (size == 0) {
+    return;
+  }
+  const double timePerByte = static_cast<double>(time) / size;
+  const uint32_t idx = XferPathTable::bucket(size);
+  amd::ScopedLock l(lock_);
+  Bucket& bucket = buckets_[dir][idx];
+  if (bucket.fixed_) {
+    return;
+  }
+  Stats& stats = bucket.stats_[path];
+  stats.samples_++;
+  // Running average over the last samples, so the table follows the changes in the system load
+  stats.timePerByte_ += (timePerByte - stats.timePerByte_) / std::min(stats.samples_, MaxWindow);
+
+  if ((bucket.stats_[Staged].samples_ >= MinSamples) &&
+      (bucket.stats_[Pinned].samples_ >= MinSamples)) {
+    const Path best = (bucket.stats_[Pinned].timePerByte_ < bucket.stats_[Staged].timePerByte_) ?
+        Pinned : Staged;
+    if (best != bucket.path_) {
+      ClPrint(amd::LOG_INFO, amd::LOG_COPY, "%s transfers up to %zu bytes switched to %s path",
+              (dir == Read) ? "Read" : "Write", size_t(1) << (MinBucketShift + idx),
+              (best == Pinned) ? "pinned" : "staged");
+      bucket.path_ = best;
+    }
+  }
+}
+
+// ================================================================================================
+bool Device::XferPathTable::load(const std::string& fileName) {
+  std::ifstream file(fileName);
+  if (!file.is_open()) {
+    return false;
+  }
+  // Every line has the format: <read|write> <max transfer size in bytes> <staged|pinned>
+  std::string dirName, pathName;
+  size_t size;
+  amd::ScopedLock l(lock_);
+  while (file >> dirName >> size >> pathName) {
+    if (((dirName != "read") && (dirName != "write")) ||
+        ((pathName != "staged") && (pathName != "pinned"))) {
+      LogPrintfError("Invalid transfer path entry: %s %zu %s", dirName.c_str(), size,
+                     pathName.c_str());
+      return false;
+    }
+    Bucket& bucket = buckets_[(dirName == "read") ? Read : Write][XferPathTable::bucket(size)];
+    bucket.path_ = (pathName == "pinned") ? Pinned : Staged;
+    bucket.fixed_ = true;
+  }
+  return true;
+}
+
+// ================================================================================================
+bool Device::XferPathTable::save(const std::string& fileName) const {
+  std::ofstream file(fileName, std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  amd::ScopedLock l(lock_);
+  for (uint32_t dir = 0; dir < TotalDirections; ++dir) {
+    for (uint32_t idx = 0; idx < TotalBuckets; ++idx) {
+      file << ((dir == Read) ? "read " : "write ") << (size_t(1) << (MinBucketShift + idx))
+           << ((buckets_[dir][idx].path_ == Pinned) ? " pinned" : " staged") << std::endl;
+    }
+  }
+  return file.good();
 }
 
 bool Device::XferBuffers::create() {
@@ -415,52 +587,129 @@ bool Device::XferBuffers::create() {
     LogError("Couldn't allocate a transfer buffer!");
   } else {
     result = true;
-    freeBuffers_.push_back(xferBuf);
+    freeBuffers_[0].store(xferBuf, std::memory_order_release);
   }
 
   return result;
 }
 
-Memory& Device::XferBuffers::acquire() {
-  Memory* xferBuf = nullptr;
-  size_t listSize;
+size_t Device::XferBuffers::slotHint() {
+  static std::atomic<size_t> threadCount(0);
+  thread_local size_t hint = threadCount++ % MaxXferBufListSize;
+  return hint;
+}
 
-  // Lock the operations with the staged buffer list
-  amd::ScopedLock l(lock_);
-  listSize = freeBuffers_.size();
-
-  // If the list is empty, then attempt to allocate a staged buffer
-  if (listSize == 0) {
-    // Allocate memory
-    xferBuf = new Buffer(dev(), bufSize_);
-
-    // Allocate memory for the transfer buffer
-    if ((nullptr == xferBuf) || !xferBuf->create()) {
-      delete xferBuf;
-      xferBuf = nullptr;
-      LogError("Couldn't allocate a transfer buffer!");
-    } else {
-      ++acquiredCnt_;
+Memory* Device::XferBuffers::takeFree() {
+  const size_t hint = slotHint();
+  for (size_t i = 0; i < MaxXferBufListSize; ++i) {
+    std::atomic<Memory*>& slot = freeBuffers_[(hint + i) % MaxXferBufListSize];
+    if (slot.load(std::memory_order_relaxed) != nullptr) {
+      Memory* xferBuf = slot.exchange(nullptr, std::memory_order_acquire);
+      if (xferBuf != nullptr) {
+        return xferBuf;
+      }
+    }
+  }
+  return nullptr;
+}
+
+Memory* Device::XferBuffers::acquire() {
+  ++acquiredCnt_;
+  Memory* xferBuf = takeFree();
+  if (xferBuf != nullptr) {
+    return xferBuf;
+  }
+
+  if (hasOverflow_.load(std::memory_order_acquire)) {
+    amd::ScopedLock l(lock_);
+    if (!overflowBuffers_.empty()) {
+      xferBuf = overflowBuffers_.front();
+      overflowBuffers_.pop_front();
+      hasOverflow_.store(!overflowBuffers_.empty(), std::memory_order_release);
+      return xferBuf;
     }
   }
 
-  if (xferBuf == nullptr) {
-    xferBuf = *(freeBuffers_.begin());
-    freeBuffers_.erase(freeBuffers_.begin());
-    ++acquiredCnt_;
+  // The pool is empty, hence allocate a new buffer. No lock is held during the allocation,
+  // so the transfers on the other threads are not blocked
+  lastMissTime_.store(amd::Os::timeNanos(), std::memory_order_relaxed);
+  xferBuf = new Buffer(dev(), bufSize_);
+  if ((nullptr == xferBuf) || !xferBuf->create()) {
+    delete xferBuf;
+    xferBuf = nullptr;
+    --acquiredCnt_;
+    LogError("Couldn't allocate a transfer buffer!");
   }
 
-  return *xferBuf;
+  return xferBuf;
 }
 
 void Device::XferBuffers::release(VirtualGPU& gpu, Memory& buffer) {
   // Make sure buffer isn't busy on the current VirtualGPU, because
   // the next aquire can come from different queue
   //    buffer.wait(gpu);
-  // Lock the operations with the staged buffer list
-  amd::ScopedLock l(lock_);
-  freeBuffers_.push_back(&buffer);
   --acquiredCnt_;
+  const size_t hint = slotHint();
+  bool cached = false;
+  for (size_t i = 0; i < MaxXferBufListSize; ++i) {
+    Memory* empty = nullptr;
+    if (freeBuffers_[(hint + i) % MaxXferBufListSize].compare_exchange_strong(
+            empty, &buffer, std::memory_order_release, std::memory_order_relaxed)) {
+      cached = true;
+      break;
+    }
+  }
+
+  if (!cached) {
+    // All slots are taken, hence keep the buffer in the overflow list up to its limit, so
+    // a burst of transfers doesn't reallocate pinned memory
+    amd::ScopedLock l(lock_);
+    if (overflowBuffers_.size() < MaxXferBufOverflowSize) {
+      overflowBuffers_.push_back(&buffer);
+      hasOverflow_.store(true, std::memory_order_release);
+    } else {
+      // The buffer exceeds the pool limit
+      delete &buffer;
+    }
+  }
+
+  if ((amd::Os::timeNanos() - lastMissTime_.load(std::memory_order_relaxed)) > IdleTrimTime) {
+    // The pool had enough buffers for a while, hence release the extra buffers from a burst
+    trim(1);
+  }
+}
+
+void Device::XferBuffers::trim(size_t limit) {
+  if (hasOverflow_.load(std::memory_order_acquire)) {
+    amd::ScopedLock l(lock_);
+    for (const auto& buf : overflowBuffers_) {
+      delete buf;
+    }
+    overflowBuffers_.clear();
+    hasOverflow_.store(false, std::memory_order_release);
+  }
+
+  size_t kept = 0;
+  for (auto& slot : freeBuffers_) {
+    if (slot.load(std::memory_order_relaxed) != nullptr) {
+      if (kept < limit) {
+        ++kept;
+        continue;
+      }
+      delete slot.exchange(nullptr, std::memory_order_acquire);
+    }
+  }
+}
+
+size_t Device::XferBuffers::freeCount() {
+  size_t count = 0;
+  for (const auto& slot : freeBuffers_) {
+    if (slot.load(std::memory_order_relaxed) != nullptr) {
+      ++count;
+    }
+  }
+  amd::ScopedLock l(lock_);
+  return count + overflowBuffers_.size();
 }
 
 // ================================================================================================
@@ -527,35 +776,23 @@ bool Device::init() {
 
   LogPrintfInfo("Enumerated GPU agents = %lu", gpu_agents_.size());
 
-  for (auto agent : gpu_agents_) {
-    std::unique_ptr<Device> roc_device(new Device(agent));
-    if (!roc_device) {
-      LogError("Error creating new instance of Device on then heap.");
-      continue;
-    }
-
-    if (!roc_device->create()) {
-      LogError("Error creating new instance of Device.");
-      continue;
-    }
-
-    // Setup System Memory to be Non-Coherent per user
-    // request via environment variable. By default the
-    // System Memory is setup to be Coherent
-    if (roc_device->settings().enableNCMode_) {
-      hsa_status_t err = hsa_amd_coherency_set_type(agent, HSA_AMD_COHERENCY_TYPE_NONCOHERENT);
-      if (err != HSA_STATUS_SUCCESS) {
-        LogError("Unable to set NC memory policy!");
-        continue;
-      }
-    }
+  // Device creation is independent per agent, hence run it concurrently on multi-GPU systems
+  std::vector<std::unique_ptr<Device>> roc_devices = amd::parallelCreate<Device>(
+      gpu_agents_.size(), ROC_DEVICE_INIT_THREADS,
+      [](size_t idx) { return createDevice(gpu_agents_[idx]); });
 
-    // Check to see if a global CU mask is requested
-    if (amd::IS_HIP && ROC_GLOBAL_CU_MASK[0] != '\0') {
-      roc_device->getGlobalCUMask(ROC_GLOBAL_CU_MASK);
+  // Register the devices serially in the agent order, so the device indices stay the same
+  size_t failed_devices = 0;
+  for (auto& roc_device : roc_devices) {
+    if (roc_device) {
+      roc_device.release()->registerDevice();
+    } else {
+      ++failed_devices;
     }
-
-    roc_device.release()->registerDevice();
+  }
+  if (failed_devices != 0) {
+    LogPrintfError("Failed to create %zu out of %zu devices", failed_devices,
+                   gpu_agents_.size());
   }
 
   // Query active devices only
@@ -614,6 +851,38 @@ bool Device::init() {
   return true;
 }
 
+// ================================================================================================
+Device* Device::createDevice(hsa_agent_t agent) {
+  std::unique_ptr<Device> roc_device(new Device(agent));
+  if (!roc_device) {
+    LogError("Error creating new instance of Device on then heap.");
+    return nullptr;
+  }
+
+  if (!roc_device->create()) {
+    LogError("Error creating new instance of Device.");
+    return nullptr;
+  }
+
+  // Setup System Memory to be Non-Coherent per user
+  // request via environment variable. By default the
+  // System Memory is setup to be Coherent
+  if (roc_device->settings().enableNCMode_) {
+    hsa_status_t err = hsa_amd_coherency_set_type(agent, HSA_AMD_COHERENCY_TYPE_NONCOHERENT);
+    if (err != HSA_STATUS_SUCCESS) {
+      LogError("Unable to set NC memory policy!");
+      return nullptr;
+    }
+  }
+
+  // Check to see if a global CU mask is requested
+  if (amd::IS_HIP && ROC_GLOBAL_CU_MASK[0] != '\0') {
+    roc_device->getGlobalCUMask(ROC_GLOBAL_CU_MASK);
+  }
+
+  return roc_device.release();
+}
+
 extern const char* SchedulerSourceCode;
 
 void Device::tearDown() {
@@ -795,6 +1064,14 @@ bool Device::create() {
   // Use just 1 entry by default for the map cache
   mapCache_->push_back(nullptr);
 
+  if (settings().resourceCacheSize_ != 0) {
+    memoryCache_ = new MemoryCache(*this, settings().resourceCacheSize_);
+    if (memoryCache_ == nullptr) {
+      LogError("Couldn't allocate the device memory cache");
+      return false;
+    }
+  }
+
   if (settings().stagedXferSize_ != 0) {
     // Initialize staged write buffers
     if (settings().stagedXferWrite_) {
@@ -815,6 +1092,24 @@ bool Device::create() {
     }
   }
 
+  // The transfer path table selects between the staged and pinned paths, hence both must exist
+  if ((ROC_XFER_PATH_CALIBRATION || !flagIsDefault(ROC_XFER_PATH_TABLE)) &&
+      (settings().pinnedXferSize_ != 0) && (xferRead_ != nullptr) && (xferWrite_ != nullptr)) {
+    xferPathTable_ = new XferPathTable(settings().pinnedMinXferSize_, ROC_XFER_PATH_CALIBRATION);
+    if (xferPathTable_ == nullptr) {
+      LogError("Couldn't allocate the transfer path table");
+      return false;
+    }
+    if (!flagIsDefault(ROC_XFER_PATH_TABLE)) {
+      // The table is stored per device target, since the crossover points differ between them
+      const std::string fileName = std::string(ROC_XFER_PATH_TABLE) + "." + info().name_;
+      if (!xferPathTable_->load(fileName)) {
+        ClPrint(amd::LOG_INFO, amd::LOG_INIT, "Transfer path table %s isn't loaded",
+                fileName.c_str());
+      }
+    }
+  }
+
   // Create signal for HMM prefetch operation on device
   if (HSA_STATUS_SUCCESS != hsa_signal_create(kInitSignalValueOne, 0, nullptr, &prefetch_signal_)) {
     return false;
@@ -1322,6 +1617,9 @@ bool Device::populateOCLDeviceConstants() {
 
   info_.maxWorkItemDimensions_ = 3;
 
+  // Device creation runs concurrently, hence adjust a per-device copy of the global flag
+  uint single_alloc_percent = GPU_SINGLE_ALLOC_PERCENT;
+
   if (settings().enableLocalMemory_ && gpuvm_segment_.handle != 0) {
     size_t global_segment_size = 0;
     if (HSA_STATUS_SUCCESS != hsa_amd_memory_pool_get_info(gpuvm_segment_,
@@ -1337,20 +1635,20 @@ bool Device::populateOCLDeviceConstants() {
     // For APU with vram size <= 512MiB, use a smaller single alloc percentage
     if (info_.globalMemSize_ <= 536870912) {
       if (flagIsDefault(GPU_SINGLE_ALLOC_PERCENT)) {
-        GPU_SINGLE_ALLOC_PERCENT = 75;
+        single_alloc_percent = 75;
       }
     }
     // Limit gpu single allocation percentage on MI300
     if ((isa().versionMajor() == 9) && (isa().versionMinor() == 4)) {
       if (gpu_agents_.size() == 1 || p2p_agents_.size() == 0) {
         if (flagIsDefault(GPU_SINGLE_ALLOC_PERCENT)) {
-            GPU_SINGLE_ALLOC_PERCENT = 60;
+            single_alloc_percent = 60;
         }
       }
     }
 
     gpuvm_segment_max_alloc_ =
-        uint64_t(info_.globalMemSize_ * std::min(GPU_SINGLE_ALLOC_PERCENT, 100u) / 100u);
+        uint64_t(info_.globalMemSize_ * std::min(single_alloc_percent, 100u) / 100u);
     assert(gpuvm_segment_max_alloc_ > 0);
 
     info_.maxMemAllocSize_ = static_cast<uint64_t>(gpuvm_segment_max_alloc_);
@@ -1371,7 +1669,7 @@ bool Device::populateOCLDeviceConstants() {
                             static_cast<uint64_t>(info_.globalMemSize_)) / 100u;
 
     info_.maxMemAllocSize_ =
-        uint64_t(info_.globalMemSize_ * std::min(GPU_SINGLE_ALLOC_PERCENT, 100u) / 100u);
+        uint64_t(info_.globalMemSize_ * std::min(single_alloc_percent, 100u) / 100u);
 
     if (HSA_STATUS_SUCCESS !=
         hsa_amd_memory_pool_get_info(
@@ -2310,7 +2608,31 @@ void* Device::deviceLocalAlloc(size_t size, bool atomics, bool pseudo_fine_grain
   }
 
   void* ptr = nullptr;
+  const bool cacheable = (memoryCache_ != nullptr) && !atomics && !pseudo_fine_grain;
+  if (cacheable) {
+    // ROCr allocates with the pool granularity anyway, so the size class doesn't waste memory
+    size = amd::alignUp(size, alloc_granularity_);
+    size_t p2pDevices = 0;
+    ptr = memoryCache_->find(size, &p2pDevices);
+    if (ptr != nullptr) {
+      ClPrint(amd::LOG_DEBUG, amd::LOG_MEM, "Reuse cached device memory %p, size 0x%zx", ptr,
+              size);
+      // Peer access could be enabled after the block was allocated
+      if ((p2pDevices != enabled_p2p_devices_.size()) && isP2pEnabled() &&
+          (deviceAllowAccess(ptr) == false)) {
+        LogError("Allow p2p access for memory allocation");
+        memFree(ptr, size);
+        return nullptr;
+      }
+      return ptr;
+    }
+  }
+
   hsa_status_t stat = hsa_amd_memory_pool_allocate(pool, size, 0, &ptr);
+  if ((stat != HSA_STATUS_SUCCESS) && (memoryCache_ != nullptr) && memoryCache_->trim()) {
+    // Release the cached memory under memory pressure and try again
+    stat = hsa_amd_memory_pool_allocate(pool, size, 0, &ptr);
+  }
   ClPrint(amd::LOG_DEBUG, amd::LOG_MEM, "Allocate hsa device memory %p, size 0x%zx", ptr, size);
   if (stat != HSA_STATUS_SUCCESS) {
     LogError("Fail allocation local memory");
@@ -2325,6 +2647,17 @@ void* Device::deviceLocalAlloc(size_t size, bool atomics, bool pseudo_fine_grain
   return ptr;
 }
 
+void Device::deviceLocalFree(void* ptr, size_t size, bool atomics,
+                             bool pseudo_fine_grain) const {
+  if ((memoryCache_ != nullptr) && !atomics && !pseudo_fine_grain &&
+      memoryCache_->add(ptr, amd::alignUp(size, alloc_granularity_),
+                        enabled_p2p_devices_.size())) {
+    ClPrint(amd::LOG_DEBUG, amd::LOG_MEM, "Cache hsa device memory %p, size 0x%zx", ptr, size);
+    return;
+  }
+  memFree(ptr, size);
+}
+
 void Device::memFree(void* ptr, size_t size) const {
   hsa_status_t stat = hsa_amd_memory_pool_free(ptr);
   ClPrint(amd::LOG_DEBUG, amd::LOG_MEM, "Free hsa memory %p", ptr);
@@ -2902,22 +3235,40 @@ hsa_queue_t* Device::getQueueFromPool(const uint qIndex) {
     }
   } else {
     if (qIndex < QueuePriority::Total && queuePool_[qIndex].size() > 0) {
-      typedef decltype(queuePool_)::value_type::const_reference PoolRef;
-      auto lowest = std::min_element(
-          queuePool_[qIndex].begin(), queuePool_[qIndex].end(),
-          [](PoolRef A, PoolRef B) { return A.second.refCount < B.second.refCount; });
+      auto lowest = leastLoadedQueue(queuePool_[qIndex]);
       lowest->second.refCount++;
-      ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "selected queue refCount: %p (%d)", lowest->first,
-              lowest->second.refCount);
+      ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "selected queue refCount: %p (%d), load: %lu",
+              lowest->first, lowest->second.refCount, lowest->second.load_);
       return lowest->first;
     }
   }
   return nullptr;
 }
 
+// ================================================================================================
+hsa_queue_t* Device::rebalanceQueue(hsa_queue_t* queue, uint64_t old_load, uint64_t new_load) {
+  amd::ScopedLock lock(queuePoolAccess_);
+  for (auto& pool : queuePool_) {
+    auto current = pool.find(queue);
+    if (current == pool.end()) {
+      continue;
+    }
+    auto target = rebalanceQueueLoad(pool, current, old_load, new_load);
+    if (target != current) {
+      ClPrint(amd::LOG_INFO, amd::LOG_QUEUE,
+              "Migrate stream with load %lu from queue %p (%d, %lu) to queue %p (%d, %lu)",
+              new_load, current->first, current->second.refCount, current->second.load_,
+              target->first, target->second.refCount, target->second.load_);
+    }
+    return target->first;
+  }
+  return queue;
+}
+
 hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
                                   const std::vector<uint32_t>& cuMask,
                                   amd::CommandQueue::Priority priority) {
+  amd::ScopedLock lock(queuePoolAccess_);
   assert(queuePool_[QueuePriority::Low].size() <= GPU_MAX_HW_QUEUES ||
          queuePool_[QueuePriority::Normal].size() <= GPU_MAX_HW_QUEUES ||
          queuePool_[QueuePriority::High].size() <= GPU_MAX_HW_QUEUES);
@@ -3097,13 +3448,17 @@ hsa_queue_t* Device::acquireQueue(uint32_t queue_size_hint, bool coop_queue,
   return queue;
 }
 
-void Device::releaseQueue(hsa_queue_t* queue, const std::vector<uint32_t>& cuMask) {
+void Device::releaseQueue(hsa_queue_t* queue, const std::vector<uint32_t>& cuMask,
+                          uint64_t load) {
+  amd::ScopedLock lock(queuePoolAccess_);
   for (auto& it : cuMask.size() == 0 ? queuePool_ : queueWithCUMaskPool_) {
     auto qIter = it.find(queue);
     if (qIter != it.end()) {
       auto &qInfo = qIter->second;
       assert(qInfo.refCount > 0);
       qInfo.refCount--;
+      assert(qInfo.load_ >= load && "Queue load is out of sync");
+      qInfo.load_ -= load;
       ClPrint(amd::LOG_INFO, amd::LOG_QUEUE, "releaseQueue refCount:%p (%d)", qIter->first,
               qIter->second.refCount);
     }
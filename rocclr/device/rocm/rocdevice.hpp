@@ -39,6 +39,7 @@
 #include "device/rocm/rocdefs.hpp"
 #include "device/rocm/rocprintf.hpp"
 #include "device/rocm/rocglinterop.hpp"
+#include "device/rocm/rocqueuepool.hpp"
 
 #include "hsa/hsa.h"
 #include "hsa/hsa_ext_image.h"
@@ -319,14 +320,23 @@ struct AgentInfo {
 //! A HSA device ordinal (physical HSA device)
 class Device : public NullDevice {
  public:
-  //! Transfer buffers
+  //! Transfer buffers. The free buffers are kept in a fixed set of slots, which are accessed
+  //! without a lock, hence a staged transfer doesn't wait for the other threads. The buffers,
+  //! released when all slots are taken, go to an overflow list under a lock
   class XferBuffers : public amd::HeapObject {
    public:
-    static const size_t MaxXferBufListSize = 8;
+    static constexpr size_t MaxXferBufListSize = 8;
+    static constexpr size_t MaxXferBufOverflowSize = 8;  //!< Free buffers above the slots
+    static constexpr uint64_t IdleTrimTime = 5000000000ull;  //!< Time without pool misses in ns,
+                                                             //!< after which the pool is trimmed
 
     //! Default constructor
     XferBuffers(const Device& device, size_t bufSize)
-        : bufSize_(bufSize), acquiredCnt_(0), gpuDevice_(device) {}
+        : bufSize_(bufSize), acquiredCnt_(0), lastMissTime_(0), gpuDevice_(device) {
+      for (auto& slot : freeBuffers_) {
+        slot.store(nullptr, std::memory_order_relaxed);
+      }
+    }
 
     //! Default destructor
     ~XferBuffers();
@@ -334,17 +344,26 @@ class Device : public NullDevice {
     //! Creates the xfer buffers object
     bool create();
 
-    //! Acquires an instance of the transfer buffers
-    Memory& acquire();
+    //! Acquires an instance of the transfer buffers, returns nullptr if allocation failed
+    Memory* acquire();
 
     //! Releases transfer buffer
     void release(VirtualGPU& gpu,  //!< Virual GPU object used with the buffer
                  Memory& buffer    //!< Transfer buffer for release
                  );
 
+    //! Destroys the free buffers above the limit. The overflow buffers are destroyed first
+    void trim(size_t limit);
+
     //! Returns the buffer's size for transfer
     size_t bufSize() const { return bufSize_; }
 
+    //! Returns the number of acquired buffers
+    uint acquiredCount() const { return acquiredCnt_.load(std::memory_order_relaxed); }
+
+    //! Returns the number of free buffers in the pool
+    size_t freeCount();
+
    private:
     //! Disable copy constructor
     XferBuffers(const XferBuffers&);
@@ -355,17 +374,133 @@ class Device : public NullDevice {
     //! Get device object
     const Device& dev() const { return gpuDevice_; }
 
-    size_t bufSize_;                  //!< Staged buffer size
-    std::list<Memory*> freeBuffers_;  //!< The list of free buffers
-    std::atomic_uint acquiredCnt_;   //!< The total number of acquired buffers
-    amd::Monitor lock_;               //!< Stgaed buffer acquire/release lock
-    const Device& gpuDevice_;         //!< GPU device object
+    //! Returns the first slot for the calling thread, so the threads don't contend on one slot
+    static size_t slotHint();
+
+    //! Takes a free buffer from the slots or returns nullptr
+    Memory* takeFree();
+
+    size_t bufSize_;                                        //!< Staged buffer size
+    std::atomic<Memory*> freeBuffers_[MaxXferBufListSize];  //!< Free buffers, nullptr - empty
+    std::list<Memory*> overflowBuffers_;    //!< Free buffers, which didn't fit into the slots
+    std::atomic_bool hasOverflow_{false};   //!< The overflow list isn't empty
+    std::atomic_uint acquiredCnt_;          //!< The total number of acquired buffers
+    std::atomic<uint64_t> lastMissTime_;    //!< The time of the last acquire without a free buffer
+    amd::Monitor lock_;                     //!< Overflow list lock
+    const Device& gpuDevice_;               //!< GPU device object
+  };
+
+  //! Cache of freed device local memory. The blocks are kept in FILO order and reused by
+  //! the allocations of the same size class (the size aligned to the allocation granularity)
+  class MemoryCache : public amd::HeapObject {
+   public:
+    //! Default constructor
+    MemoryCache(const Device& device, size_t cacheSizeLimit)
+        : lock_("ROC memory cache", true),
+          cacheSize_(0),
+          cacheSizeLimit_(cacheSizeLimit),
+          gpuDevice_(device) {}
+
+    //! Default destructor
+    ~MemoryCache() { trim(); }
+
+    //! Returns a cached block of the size class or nullptr. p2pDevices returns the number of
+    //! P2P devices, which had access to the block at the allocation time
+    void* find(size_t size, size_t* p2pDevices);
+
+    //! Adds a freed block to the cache. Returns false if the block can't be cached
+    bool add(void* ptr, size_t size, size_t p2pDevices);
+
+    //! Releases the cached blocks until the cache size drops to the limit.
+    //! Returns true if any memory was released
+    bool trim(size_t limit = 0);
+
+    //! Returns the size of all memory, stored in the cache
+    size_t cacheSize() const { return cacheSize_; }
+
+   private:
+    //! Disable copy constructor
+    MemoryCache(const MemoryCache&);
+
+    //! Disable assignment operator
+    MemoryCache& operator=(const MemoryCache&);
+
+    struct Block {
+      void* ptr_;           //!< Device memory
+      size_t size_;         //!< Size class of the block
+      size_t p2pDevices_;   //!< The number of P2P devices with access to the block
+    };
+
+    amd::Monitor lock_;           //!< Lock to serialise cache access
+    std::list<Block> blocks_;     //!< Cached blocks, the most recently freed first
+    size_t cacheSize_;            //!< Current cache size in bytes
+    const size_t cacheSizeLimit_; //!< Cache size limit in bytes
+    const Device& gpuDevice_;     //!< GPU device object
+  };
+
+  //! Selection of the host<->device transfer path per direction and size bucket. The path of
+  //! each bucket is calibrated with the measured copy times or loaded from a persisted table
+  class XferPathTable : public amd::HeapObject {
+   public:
+    enum Path : uint32_t { Staged = 0, Pinned, TotalPaths };
+    enum Direction : uint32_t { Read = 0, Write, TotalDirections };
+
+    //! Default constructor. The initial paths follow the static pinned transfer threshold
+    XferPathTable(size_t minPinnedSize, bool calibrate);
+
+    //! Returns the transfer path for a copy of the specified size
+    Path select(Direction dir, size_t size);
+
+    //! Accounts the measured time in ns of a copy, executed with the specified path
+    void record(Direction dir, Path path, size_t size, uint64_t time);
+
+    //! Returns true if the copy times must be measured
+    bool calibrate() const { return calibrate_; }
+
+    //! Loads the persisted table. The loaded buckets are fixed and not calibrated
+    bool load(const std::string& fileName);
+
+    //! Saves the current table
+    bool save(const std::string& fileName) const;
+
+    //! Returns the size bucket of a copy
+    static uint32_t bucket(size_t size);
+
+    static constexpr uint32_t MinBucketShift = 12;  //!< The first bucket covers up to 4KB
+    static constexpr uint32_t TotalBuckets = 20;    //!< The last bucket covers 2GB and above
+    static constexpr uint32_t MinSamples = 4;       //!< Samples of each path before the choice
+    static constexpr uint32_t MaxWindow = 16;       //!< Window of the running average
+
+   private:
+    //! Disable copy constructor
+    XferPathTable(const XferPathTable&);
+
+    //! Disable assignment operator
+    XferPathTable& operator=(const XferPathTable&);
+
+    struct Stats {
+      uint32_t samples_;    //!< The number of measured copies
+      double timePerByte_;  //!< Running average of the copy time per byte in ns
+    };
+
+    struct Bucket {
+      Stats stats_[TotalPaths]; //!< Measurements of each path
+      Path path_;               //!< Selected path
+      bool fixed_;              //!< The path was loaded from the table and isn't calibrated
+    };
+
+    mutable amd::Monitor lock_;                       //!< Lock to serialise table access
+    Bucket buckets_[TotalDirections][TotalBuckets];   //!< Table of the transfer paths
+    const bool calibrate_;                            //!< Measure the copies and update the paths
   };
 
   //! Initialise the whole HSA device subsystem (CAL init, device enumeration, etc).
   static bool init();
   static void tearDown();
 
+  //! Creates and initializes a device for the agent. Returns nullptr on failure
+  static Device* createDevice(hsa_agent_t agent);
+
   //! Lookup all AMD HSA devices and memory regions.
   static hsa_status_t iterateAgentCallback(hsa_agent_t agent, void* data);
   static hsa_status_t iterateGpuMemoryPoolCallback(hsa_amd_memory_pool_t region, void* data);
@@ -453,6 +588,11 @@ class Device : public NullDevice {
   uint64_t deviceVmemAlloc(size_t size, uint64_t flags) const;
   void* deviceLocalAlloc(size_t size, bool atomics = false, bool pseudo_fine_grain=false) const;
 
+  //! Frees memory, allocated with deviceLocalAlloc(). Coarse grained memory can be kept in
+  //! the memory cache for reuse
+  void deviceLocalFree(void* ptr, size_t size, bool atomics = false,
+                       bool pseudo_fine_grain = false) const;
+
   void memFree(void* ptr, size_t size) const;
 
   virtual void* svmAlloc(amd::Context& context, size_t size, size_t alignment,
@@ -504,6 +644,9 @@ class Device : public NullDevice {
   //! Returns transfer buffer object
   XferBuffers& xferRead() const { return *xferRead_; }
 
+  //! Returns the transfer path table or nullptr if the static thresholds are used
+  XferPathTable* xferPathTable() const { return xferPathTable_; }
+
   //! Returns a ROC memory object from AMD memory object
   roc::Memory* getRocMemory(amd::Memory* mem  //!< Pointer to AMD memory object
                             ) const;
@@ -547,7 +690,11 @@ class Device : public NullDevice {
                             amd::CommandQueue::Priority priority = amd::CommandQueue::Priority::Normal);
 
   //! Release HSA queue
-  void releaseQueue(hsa_queue_t*, const std::vector<uint32_t>& cuMask = {});
+  void releaseQueue(hsa_queue_t*, const std::vector<uint32_t>& cuMask = {}, uint64_t load = 0);
+
+  //! Updates the load of a shared HSA queue and returns a less loaded queue from the pool
+  //! if the caller should migrate to it. The caller must be idle on the current queue.
+  hsa_queue_t* rebalanceQueue(hsa_queue_t* queue, uint64_t old_load, uint64_t new_load);
 
   //! For the given HSA queue, return an existing hostcall buffer or create a
   //! new one. queuePool_ keeps a mapping from HSA queue to hostcall buffer.
@@ -630,6 +777,8 @@ class Device : public NullDevice {
 
   XferBuffers* xferRead_;   //!< Transfer buffers read
   XferBuffers* xferWrite_;  //!< Transfer buffers write
+  MemoryCache* memoryCache_;  //!< Cache of freed device memory, optional
+  XferPathTable* xferPathTable_;  //!< Transfer path selection, optional
   std::atomic<size_t> freeMem_;   //!< Total of free memory available
   mutable amd::Monitor vgpusAccess_;     //!< Lock to serialise virtual gpu list access
   bool hsa_exclusive_gpu_access_;  //!< TRUE if current device was moved into exclusive GPU access mode
@@ -638,12 +787,16 @@ class Device : public NullDevice {
   struct QueueInfo {
     int refCount;
     void* hostcallBuffer_;
+    uint64_t load_;     //!< Sum of the submission rates of all streams mapped to the queue
   };
+  typedef std::map<hsa_queue_t*, QueueInfo> QueuePool;
 
   //! a vector for keeping Pool of HSA queues with low, normal and high priorities for recycling
-  std::vector<std::map<hsa_queue_t*, QueueInfo>> queuePool_;
+  std::vector<QueuePool> queuePool_;
+  amd::Monitor queuePoolAccess_;  //!< Lock to serialise queue pool updates (innermost lock)
 
-  //! returns a hsa queue from queuePool with least refCount and updates the refCount as well
+  //! returns a hsa queue from queuePool with the least load and refCount and updates
+  //! the refCount as well
   hsa_queue_t* getQueueFromPool(const uint qIndex);
 
   void* coopHostcallBuffer_;
@@ -652,7 +805,7 @@ class Device : public NullDevice {
                             std::vector<LinkAttrType>* link_attr);
 
   //! Pool of HSA queues with custom CU masks
-  std::vector<std::map<hsa_queue_t*, QueueInfo>> queueWithCUMaskPool_;
+  std::vector<QueuePool> queueWithCUMaskPool_;
 
   //! Read and Write mask for device<->host
   uint32_t maxSdmaReadMask_;
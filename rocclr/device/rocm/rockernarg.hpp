@@ -0,0 +1,100 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include "top.hpp"
+#include "utils/util.hpp"
+#include "utils/debug.hpp"
+
+namespace roc {
+
+//! Offsets of the kernel arguments pool. The pool is split into chunks and GPU progress is
+//! tracked per chunk, so runtime reuses a chunk as soon as GPU passes all dispatches, which
+//! reference it. The pool memory and the chunk tracking belong to the backend, see
+//! VirtualGPU::allocKernArg()
+class KernArgRing {
+ public:
+  static constexpr uint32_t NumChunks = 16;  //!< The number of chunks in the pool
+
+  //! Starts a new pool from the first chunk
+  void reset(address base, uint32_t size) {
+    base_ = base;
+    size_ = size;
+    activeChunk_ = 0;
+    curOffset_ = 0;
+    chunkEnd_ = chunkSize();
+  }
+
+  //! Allocates the kernel arguments. The backend provides:
+  //!   void fence(uint32_t chunk) - the chunk stays busy until GPU passes the current dispatches
+  //!   bool busy(uint32_t chunk)  - GPU still references the chunk
+  //!   bool grow(size_t minChunk) - replaces the pool with a bigger one, calls reset()
+  //!   void wait(uint32_t chunk)  - waits until GPU releases the chunk
+  template <typename Backend> address alloc(Backend& backend, size_t size, size_t alignment) {
+    assert(alignment != 0);
+    address result = amd::alignUp(base_ + curOffset_, alignment);
+    const size_t usage = (result + size) - base_;
+    if (usage <= chunkEnd_) {
+      curOffset_ = static_cast<uint32_t>(usage);
+      return result;
+    }
+
+    // The current chunk is full, hence runtime can reclaim it after GPU passes it
+    backend.fence(activeChunk_);
+
+    uint32_t nextChunk = (activeChunk_ + 1) % NumChunks;
+    const bool fits = (size + alignment) <= chunkSize();
+    if (!fits || backend.busy(nextChunk)) {
+      // The next chunk is still in use by GPU. Grow the pool, instead of a stall
+      if (backend.grow(size + alignment)) {
+        nextChunk = 0;
+      } else {
+        //! That means the app didn't call clFlush/clFinish for very long time.
+        // Make sure the new active chunk is free
+        backend.wait(nextChunk);
+        guarantee(fits, "Kernel arguments don't fit into the kernarg pool!");
+      }
+    }
+    activeChunk_ = nextChunk;
+
+    // Make sure the current offset matches the new chunk to avoid possible overlaps
+    // between chunks and issues during recycle
+    curOffset_ = activeChunk_ * chunkSize();
+    chunkEnd_ = curOffset_ + chunkSize();
+    result = amd::alignUp(base_ + curOffset_, alignment);
+    curOffset_ = static_cast<uint32_t>((result + size) - base_);
+    return result;
+  }
+
+  address base() const { return base_; }
+  uint32_t size() const { return size_; }
+  uint32_t chunkSize() const { return size_ / NumChunks; }
+  uint32_t activeChunk() const { return activeChunk_; }
+
+ private:
+  address base_ = nullptr;   //!< The base address of the pool
+  uint32_t size_ = 0;        //!< The size of the pool
+  uint32_t chunkEnd_ = 0;    //!< The end offset of the current chunk
+  uint32_t activeChunk_ = 0; //!< The index of the current active chunk
+  uint32_t curOffset_ = 0;   //!< The current offset in the pool
+};
+
+}  // namespace roc
@@ -668,8 +668,11 @@ void Buffer::destroy() {
         } else {
           dev().hostFree(deviceMemory_, size());
         }
-      } else {
+      } else if (ipcExported_) {
         dev().memFree(deviceMemory_, size());
+      } else {
+        dev().deviceLocalFree(deviceMemory_, size(), (memFlags & CL_MEM_SVM_ATOMICS) != 0,
+                              (memFlags & ROCCLR_MEM_HSA_UNCACHED) != 0);
       }
     }
 
@@ -689,7 +692,11 @@ void Buffer::destroy() {
       if (isHostMemDirectAccess()) {
         needUnlockHostMem = true;
       } else {
-        dev().memFree(deviceMemory_, size());
+        if (ipcExported_) {
+          dev().memFree(deviceMemory_, size());
+        } else {
+          dev().deviceLocalFree(deviceMemory_, size());
+        }
         const_cast<Device&>(dev()).updateFreeMemory(size(), true);
       }
     }
@@ -1022,6 +1029,7 @@ bool Buffer::ExportHandle(void* handle) const {
     LogPrintfError("Failed to create memory for IPC, failed with hsa_status: %d \n", hsa_status);
     return false;
   }
+  ipcExported_ = true;
   return true;
 }
 
@@ -183,6 +183,9 @@ class Buffer : public roc::Memory {
   // signal object used when ROCCLR_MEM_HSA_SIGNAL_MEMORY is set
   hsa_signal_t signal_;
 
+  // The memory was exported for IPC and can't be recycled in the memory cache
+  mutable bool ipcExported_ = false;
+
   // Disable copy constructor
   Buffer(const Buffer&);
 
@@ -0,0 +1,91 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+//! Load balancing policy of the pooled HW queues. The pool is a map from a queue to its info
+//! with the refCount and load_ fields, hence the policy doesn't depend on HSA
+namespace roc {
+
+//! Returns the averaged load of a stream after a synchronization point. It's an exponential
+//! moving average of the packets submitted since the previous point, so a single burst doesn't
+//! trigger a migration
+inline uint64_t averageQueueLoad(uint64_t load, uint64_t submittedPackets) {
+  return (load * 3 + submittedPackets) / 4;
+}
+
+//! Returns the queue for a new stream. A new stream has no history, so the queue with the least
+//! outstanding work is preferred with a fallback to the number of users when the loads are equal
+template <typename Pool> typename Pool::iterator leastLoadedQueue(Pool& pool) {
+  typedef typename Pool::const_reference PoolRef;
+  return std::min_element(pool.begin(), pool.end(), [](PoolRef A, PoolRef B) {
+    return (A.second.load_ < B.second.load_) ||
+           ((A.second.load_ == B.second.load_) && (A.second.refCount < B.second.refCount));
+  });
+}
+
+//! Selects a queue in the pool for a stream with the given load, currently mapped to
+//! the queue at iterator current. Returns pool.end() if the stream should stay
+template <typename Pool>
+typename Pool::iterator selectQueue(Pool& pool, typename Pool::iterator current,
+                                    uint64_t load) {
+  if ((load == 0) || (current->second.refCount < 2)) {
+    // An idle stream or a stream, which owns the queue, gains nothing from a migration
+    return pool.end();
+  }
+  auto target = pool.end();
+  for (auto it = pool.begin(); it != pool.end(); ++it) {
+    if ((it != current) &&
+        ((target == pool.end()) || (it->second.load_ < target->second.load_))) {
+      target = it;
+    }
+  }
+  // Migrate only if the target queue stays noticeably less loaded than the current one
+  // after the move. The margin gives hysteresis, so streams don't bounce between queues.
+  if ((target != pool.end()) && ((target->second.load_ + load) * 4 < current->second.load_ * 3)) {
+    return target;
+  }
+  return pool.end();
+}
+
+//! Updates the load of a stream on the queue at iterator current from old_load to new_load and
+//! moves the stream to a less loaded queue, if selectQueue() finds one. Returns the queue of the
+//! stream after the update
+template <typename Pool>
+typename Pool::iterator rebalanceQueueLoad(Pool& pool, typename Pool::iterator current,
+                                           uint64_t old_load, uint64_t new_load) {
+  assert(current->second.load_ >= old_load && "Queue load is out of sync");
+  current->second.load_ = current->second.load_ - old_load + new_load;
+  auto target = selectQueue(pool, current, new_load);
+  if (target == pool.end()) {
+    return current;
+  }
+  current->second.refCount--;
+  current->second.load_ -= new_load;
+  target->second.refCount++;
+  target->second.load_ += new_load;
+  return target;
+}
+
+}  // namespace roc
@@ -41,6 +41,7 @@ Settings::Settings() {
   preferredWorkGroupSize_ = 256;
 
   kernargPoolSize_ = HSA_KERNARG_POOL_SIZE;
+  kernargPoolMaxSize_ = std::max(HSA_KERNARG_POOL_MAX_SIZE, HSA_KERNARG_POOL_SIZE);
 
   // Determine if user is requesting Non-Coherent mode
   // for system memory. By default system memory is
@@ -65,6 +66,10 @@ Settings::Settings() {
   pinnedMinXferSize_ = flagIsDefault(GPU_PINNED_MIN_XFER_SIZE)
     ? 1 * Mi : GPU_PINNED_MIN_XFER_SIZE * Mi;
 
+  // Device memory cache is optional and enabled with an explicit size only
+  resourceCacheSize_ = flagIsDefault(GPU_RESOURCE_CACHE_SIZE)
+      ? 0 : GPU_RESOURCE_CACHE_SIZE * Mi;
+
   sdmaCopyThreshold_ = GPU_FORCE_BLIT_COPY_SIZE * Ki;
 
   // Don't support Denormals for single precision by default
@@ -95,7 +100,7 @@ Settings::Settings() {
   fgs_kernel_arg_ = false;
   barrier_value_packet_ = false;
 
-  host_hdp_flush_ = true;
+  hostHdpFlush_ = true;
   gwsInitSupported_ = true;
   limit_blit_wg_ = 16;
 }
@@ -164,7 +169,7 @@ bool Settings::create(bool fullProfile, uint32_t gfxipMajor, uint32_t gfxipMinor
     // Enable Barrier Value packet is only for MI2XX/300
     barrier_value_packet_ = true;
     // On MI200 and MI300, the HDP will not cache RO=0 writes, so no flush is needed
-    host_hdp_flush_ = false;
+    hostHdpFlush_ = false;
   }
 
   if (gfxipMajor >= 10) {
@@ -52,8 +52,7 @@ class Settings : public device::Settings {
       uint system_scope_signal_ : 1;    //!< HSA signal is visibile to the entire system
       uint fgs_kernel_arg_ : 1;         //!< Use fine grain kernel arg segment
       uint barrier_value_packet_ : 1;   //!< Barrier value packet functionality
-      uint host_hdp_flush_ : 1;         //!< Host HDP flush needed
-      uint reserved_ : 20;
+      uint reserved_ : 21;
     };
     uint value_;
   };
@@ -65,6 +64,7 @@ class Settings : public device::Settings {
   uint preferredWorkGroupSize_;
 
   uint kernargPoolSize_;
+  uint kernargPoolMaxSize_;   //!< The max size the kernarg pool can grow to
   uint numDeviceEvents_;      //!< The number of device events
   uint numWaitEvents_;        //!< The number of wait events for device enqueue
 
@@ -73,6 +73,8 @@ class Settings : public device::Settings {
   size_t pinnedXferSize_;     //!< Pinned buffer size for transfer
   size_t pinnedMinXferSize_;  //!< Minimal buffer size for pinned transfer
 
+  size_t resourceCacheSize_;  //!< Device memory cache size, 0 disables the cache
+
   size_t sdmaCopyThreshold_;  //!< Use SDMA to copy above this size
   size_t sdma_p2p_threshold_; //!< Use SDMA in P2P above this size
 
@@ -141,7 +141,8 @@ void Timestamp::checkGpuTime() {
       // Avoid profiling data for the sync barrier, in tiny performance tests the first call
       // to ROCr is very slow and that also affects the overall performance of the callback thread
       if (command().GetBatchHead() == nullptr || command().profilingInfo().marker_ts_
-          || command().type() == CL_COMMAND_TASK) {
+          || command().type() == CL_COMMAND_TASK
+          || command().type() == ROCCLR_COMMAND_KERNEL_BATCH) {
         hsa_amd_profiling_dispatch_time_t time = {};
         if (it->engine_ == HwQueueEngine::Compute) {
           hsa_amd_profiling_get_dispatch_time(gpu()->gpu_device(), it->signal_, &time);
@@ -157,6 +158,10 @@ void Timestamp::checkGpuTime() {
 
         if (command().type() == CL_COMMAND_TASK) {
           static_cast<amd::AccumulateCommand&>(command()).addTimestamps(time.start, time.end);
+        } else if (command().type() == ROCCLR_COMMAND_KERNEL_BATCH) {
+          static_cast<amd::KernelBatchCommand&>(command()).addTimestamps(
+              static_cast<uint64_t>(time.start * ticksToTime_),
+              static_cast<uint64_t>(time.end * ticksToTime_));
         }
 
         ClPrint(amd::LOG_INFO, amd::LOG_SIG, "Signal = (0x%lx), start = %ld, "
@@ -837,6 +842,8 @@ bool VirtualGPU::dispatchGenericAqlPacket(
   const uint32_t queueMask = queueSize - 1;
   const uint32_t sw_queue_size = queueMask;
 
+  submittedPackets_ += size;
+
   // Check for queue full and wait if needed.
   uint64_t index = hsa_queue_add_write_index_screlease(gpu_queue_, size);
   uint64_t read = hsa_queue_load_read_index_relaxed(gpu_queue_);
@@ -873,6 +880,7 @@ bool VirtualGPU::dispatchGenericAqlPacket(
   }
 
   // Make sure the slot is free for usage
+  ringPendingDoorbell(index);
   while ((index - hsa_queue_load_read_index_scacquire(gpu_queue_)) >= sw_queue_size) {
     amd::Os::yield();
   }
@@ -922,7 +930,13 @@ bool VirtualGPU::dispatchGenericAqlPacket(
             reinterpret_cast<hsa_kernel_dispatch_packet_t*>(packet)->completion_signal);
   }
 
-  hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index - 1);
+  if (batchDispatch_ && !blocking) {
+    // The doorbell is rung once, after the last packet of the batch
+    doorbellPending_ = true;
+  } else {
+    hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index - 1);
+    doorbellPending_ = false;
+  }
 
   // Mark the flag indicating if a dispatch is outstanding.
   // We are not waiting after every dispatch.
@@ -1021,6 +1035,17 @@ bool VirtualGPU::dispatchCounterAqlPacket(hsa_ext_amd_aql_pm4_packet_t* packet,
   return false;
 }
 
+// ================================================================================================
+void VirtualGPU::ringPendingDoorbell(uint64_t index) {
+  // HW can't drain the batched packets without a doorbell, hence ring it before the wait for
+  // a free slot. Otherwise a full queue never makes progress
+  if (doorbellPending_ &&
+      ((index - hsa_queue_load_read_index_scacquire(gpu_queue_)) >= (gpu_queue_->size - 1))) {
+    hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index - 1);
+    doorbellPending_ = false;
+  }
+}
+
 // ================================================================================================
 void VirtualGPU::dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal,
                                        hsa_signal_t signal) {
@@ -1062,6 +1087,7 @@ void VirtualGPU::dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal,
     addSystemScope_ = false;
   }
 
+  ringPendingDoorbell(index);
   while ((index - hsa_queue_load_read_index_scacquire(gpu_queue_)) >= queueMask);
   hsa_barrier_and_packet_t* aql_loc =
     &(reinterpret_cast<hsa_barrier_and_packet_t*>(gpu_queue_->base_address))[index & queueMask];
@@ -1069,6 +1095,7 @@ void VirtualGPU::dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal,
   __atomic_store_n(reinterpret_cast<uint32_t*>(aql_loc), packetHeader, __ATOMIC_RELEASE);
 
   hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index);
+  doorbellPending_ = false;
   ClPrint(amd::LOG_DEBUG, amd::LOG_AQL,
           "HWq=0x%zx, BarrierAND Header = 0x%x (type=%d, barrier=%d, acquire=%d,"
           " release=%d), "
@@ -1140,6 +1167,7 @@ void VirtualGPU::dispatchBarrierValuePacket(uint16_t packetHeader, bool resolveD
   }
 
   uint64_t index = hsa_queue_add_write_index_screlease(gpu_queue_, 1);
+  ringPendingDoorbell(index);
   while ((index - hsa_queue_load_read_index_scacquire(gpu_queue_)) >= queueMask);
   hsa_amd_barrier_value_packet_t* aql_loc = &(reinterpret_cast<hsa_amd_barrier_value_packet_t*>(
       gpu_queue_->base_address))[index & queueMask];
@@ -1147,6 +1175,7 @@ void VirtualGPU::dispatchBarrierValuePacket(uint16_t packetHeader, bool resolveD
   packet_store_release(reinterpret_cast<uint32_t*>(aql_loc), packetHeader, rest);
 
   hsa_signal_store_screlease(gpu_queue_->doorbell_signal, index);
+  doorbellPending_ = false;
 
   ClPrint(amd::LOG_DEBUG, amd::LOG_AQL,
           "HWq=0x%zx, BarrierValue Header = 0x%x AmdFormat = 0x%x "
@@ -1231,10 +1260,6 @@ VirtualGPU::VirtualGPU(Device& device, bool profiling, bool cooperative,
   profiling_ = profiling;
   cooperative_ = cooperative;
 
-  kernarg_pool_base_ = nullptr;
-  kernarg_pool_size_ = 0;
-  kernarg_pool_cur_offset_ = 0;
-
   if (device.settings().fenceScopeAgent_) {
     dispatchPacketHeaderNoSync_ =
       (HSA_PACKET_TYPE_KERNEL_DISPATCH << HSA_PACKET_HEADER_TYPE) |
@@ -1312,7 +1337,7 @@ VirtualGPU::~VirtualGPU() {
   }
 
   if (gpu_queue_) {
-    roc_device_.releaseQueue(gpu_queue_, cuMask_);
+    roc_device_.releaseQueue(gpu_queue_, cuMask_, queueLoad_);
   }
 }
 
@@ -1372,20 +1397,63 @@ bool VirtualGPU::create() {
 
 // ================================================================================================
 bool VirtualGPU::initPool(size_t kernarg_pool_size) {
-  kernarg_pool_size_ = kernarg_pool_size;
-  kernarg_pool_chunk_end_ = kernarg_pool_size_ / KernelArgPoolNumSignal;
-  active_chunk_ = 0;
-  if (HIP_FORCE_DEV_KERNARG && roc_device_.info().largeBar_) {
-    kernarg_pool_base_ = reinterpret_cast<address>(roc_device_.deviceLocalAlloc(kernarg_pool_size_));
+  address base = allocKernArgPoolMemory(kernarg_pool_size, &kernarg_pool_device_local_);
+  if (base == nullptr) {
+    return false;
+  }
+  kernarg_ring_.reset(base, static_cast<uint32_t>(kernarg_pool_size));
+  return createKernArgSignals(kernarg_pool_signal_);
+}
+
+// ================================================================================================
+void VirtualGPU::destroyPool() {
+  releaseRetiredKernArgPools(true);
+  for (auto& it : kernarg_pool_signal_) {
+    if (it.handle != 0) {
+      hsa_signal_destroy(it);
+    }
+  }
+  if (kernarg_ring_.base() != nullptr) {
+    freeKernArgPoolMemory(kernarg_ring_.base(), kernarg_ring_.size(),
+                          kernarg_pool_device_local_);
+  }
+  if (kernarg_pool_grows_ != 0 || kernarg_pool_stalls_ != 0) {
+    ClPrint(amd::LOG_INFO, amd::LOG_RESOURCE, "Kernarg pool: size=%u, grows=%lu, stalls=%lu",
+            kernarg_ring_.size(), kernarg_pool_grows_, kernarg_pool_stalls_);
+  }
+}
+
+// ================================================================================================
+void VirtualGPU::resetKernArgPool() {
+  kernarg_ring_.reset(kernarg_ring_.base(), kernarg_ring_.size());
+  // The queue is idle, hence GPU can't reference the retired pools
+  releaseRetiredKernArgPools(true);
+}
+
+// ================================================================================================
+address VirtualGPU::allocKernArgPoolMemory(size_t size, bool* device_local) {
+  *device_local = HIP_FORCE_DEV_KERNARG && roc_device_.info().largeBar_;
+  if (*device_local) {
+    return reinterpret_cast<address>(roc_device_.deviceLocalAlloc(size));
   } else {
-    kernarg_pool_base_ = reinterpret_cast<address>(roc_device_.hostAlloc(kernarg_pool_size_, 0,
-                                                   Device::MemorySegment::kKernArg));
+    return reinterpret_cast<address>(roc_device_.hostAlloc(size, 0,
+                                     Device::MemorySegment::kKernArg));
   }
-  if (kernarg_pool_base_ == nullptr) {
-    return false;
+}
+
+// ================================================================================================
+void VirtualGPU::freeKernArgPoolMemory(address base, size_t size, bool device_local) {
+  if (device_local) {
+    roc_device_.memFree(base, size);
+  } else {
+    roc_device_.hostFree(base, size);
   }
+}
+
+// ================================================================================================
+bool VirtualGPU::createKernArgSignals(std::vector<hsa_signal_t>& signals) {
   hsa_agent_t agent = gpu_device();
-  for (auto& it : kernarg_pool_signal_) {
+  for (auto& it : signals) {
     if (HSA_STATUS_SUCCESS != hsa_signal_create(0, 1, &agent, &it)) {
       return false;
     }
@@ -1394,47 +1462,92 @@ bool VirtualGPU::initPool(size_t kernarg_pool_size) {
 }
 
 // ================================================================================================
-void VirtualGPU::destroyPool() {
-  for (auto& it : kernarg_pool_signal_) {
-    if (it.handle != 0) {
-      hsa_signal_destroy(it);
+bool VirtualGPU::growKernArgPool(size_t min_chunk_size) {
+  size_t new_size = 2 * static_cast<size_t>(kernarg_ring_.size());
+  while ((new_size / KernelArgPoolNumSignal) < min_chunk_size) {
+    new_size *= 2;
+  }
+  if (new_size > dev().settings().kernargPoolMaxSize_) {
+    return false;
+  }
+
+  std::vector<hsa_signal_t> signals(KernelArgPoolNumSignal, hsa_signal_t{0});
+  address base = nullptr;
+  bool device_local = false;
+  if (createKernArgSignals(signals)) {
+    base = allocKernArgPoolMemory(new_size, &device_local);
+  }
+  if (base == nullptr) {
+    for (auto& it : signals) {
+      if (it.handle != 0) {
+        hsa_signal_destroy(it);
+      }
     }
+    return false;
   }
-  if (kernarg_pool_base_ != nullptr) {
-    roc_device_.hostFree(kernarg_pool_base_, kernarg_pool_size_);
+
+  // Keep the old pool alive until GPU passes all dispatches, which reference it
+  retired_kernarg_pools_.push_back({kernarg_ring_.base(), kernarg_ring_.size(),
+                                    kernarg_pool_device_local_,
+                                    std::move(kernarg_pool_signal_)});
+  kernarg_ring_.reset(base, static_cast<uint32_t>(new_size));
+  kernarg_pool_device_local_ = device_local;
+  kernarg_pool_signal_ = std::move(signals);
+  ++kernarg_pool_grows_;
+  ClPrint(amd::LOG_INFO, amd::LOG_RESOURCE, "Kernarg pool grew to %zu bytes", new_size);
+  return true;
+}
+
+// ================================================================================================
+void VirtualGPU::releaseRetiredKernArgPools(bool force) {
+  for (auto it = retired_kernarg_pools_.begin(); it != retired_kernarg_pools_.end();) {
+    bool busy = false;
+    if (!force) {
+      for (const auto& signal : it->signals_) {
+        if (hsa_signal_load_scacquire(signal) > 0) {
+          busy = true;
+          break;
+        }
+      }
+    }
+    if (busy) {
+      // Pools retire in order, hence the newer pools can't be idle either
+      break;
+    }
+    for (auto& signal : it->signals_) {
+      hsa_signal_destroy(signal);
+    }
+    freeKernArgPoolMemory(it->base_, it->size_, it->deviceLocal_);
+    it = retired_kernarg_pools_.erase(it);
   }
 }
 
 // ================================================================================================
 void* VirtualGPU::allocKernArg(size_t size, size_t alignment) {
-  assert(alignment != 0);
-  address result = nullptr;
-  result = amd::alignUp(kernarg_pool_base_ + kernarg_pool_cur_offset_, alignment);
-  const size_t pool_new_usage = (result + size) - kernarg_pool_base_;
-  if (pool_new_usage <= kernarg_pool_chunk_end_) {
-    kernarg_pool_cur_offset_ = pool_new_usage;
-    return result;
-  } else {
-    //! That means the app didn't call clFlush/clFinish for very long time.
-    // Reset the signal for the barrier packet
-    hsa_signal_silent_store_relaxed(kernarg_pool_signal_[active_chunk_], kInitSignalValueOne);
-    // Dispatch a barrier packet into the queue
-    dispatchBarrierPacket(kBarrierPacketHeader, true, kernarg_pool_signal_[active_chunk_]);
-    // Get the next chunk
-    active_chunk_ = ++active_chunk_ % KernelArgPoolNumSignal;
-    // Make sure the new active chunk is free
-    bool test = WaitForSignal(kernarg_pool_signal_[active_chunk_], ActiveWait());
-    assert(test && "Runtime can't fail a wait for chunk!");
-    // Make sure the current offset matches the new chunk to avoid possible overlaps
-    // between chunks and issues during recycle
-    kernarg_pool_cur_offset_ = (active_chunk_ == 0) ? 0 : kernarg_pool_chunk_end_;
-    kernarg_pool_chunk_end_ = kernarg_pool_cur_offset_ +
-                              kernarg_pool_size_ / KernelArgPoolNumSignal;
-    result = amd::alignUp(kernarg_pool_base_ + kernarg_pool_cur_offset_, alignment);
-    kernarg_pool_cur_offset_ = (result + size) - kernarg_pool_base_;
-  }
+  //! Tracks the chunks of the kernarg pool with HSA signals and barrier packets
+  struct Backend {
+    VirtualGPU& gpu_;
 
-  return result;
+    void fence(uint32_t chunk) {
+      hsa_signal_silent_store_relaxed(gpu_.kernarg_pool_signal_[chunk], kInitSignalValueOne);
+      gpu_.dispatchBarrierPacket(kBarrierPacketHeader, true, gpu_.kernarg_pool_signal_[chunk]);
+      // Reclaim the older pools, which GPU has already retired
+      if (!gpu_.retired_kernarg_pools_.empty()) {
+        gpu_.releaseRetiredKernArgPools(false);
+      }
+    }
+    bool busy(uint32_t chunk) {
+      return hsa_signal_load_scacquire(gpu_.kernarg_pool_signal_[chunk]) > 0;
+    }
+    bool grow(size_t min_chunk_size) { return gpu_.growKernArgPool(min_chunk_size); }
+    void wait(uint32_t chunk) {
+      ++gpu_.kernarg_pool_stalls_;
+      bool test = WaitForSignal(gpu_.kernarg_pool_signal_[chunk], gpu_.ActiveWait());
+      assert(test && "Runtime can't fail a wait for chunk!");
+    }
+  } backend{*this};
+
+  return kernarg_ring_.alloc(backend, size, alignment);
 }
 
 // ================================================================================================
@@ -3229,7 +3342,7 @@ bool VirtualGPU::submitKernelInternal(const amd::NDRangeContainer& sizes,
       if (pcieKernargs) {
         nontemporalMemcpy(argBuffer + gpuKernel.KernargSegmentByteSize(),
                           &kSentinel, sizeof(kSentinel));
-        if (dev().settings().host_hdp_flush_) {
+        if (dev().settings().hostHdpFlush_) {
           *dev().info().hdpMemFlushCntl = 1u;
         }
       }
@@ -3417,6 +3530,34 @@ void VirtualGPU::submitKernel(amd::NDRangeKernelCommand& vcmd) {
   }
 }
 
+// ================================================================================================
+void VirtualGPU::submitKernelBatch(amd::KernelBatchCommand& vcmd) {
+  // Make sure VirtualGPU has an exclusive access to the resources
+  amd::ScopedLock lock(execution());
+
+  profilingBegin(vcmd);
+
+  // Write all AQL packets first and ring the doorbell once for the whole batch
+  batchDispatch_ = true;
+  for (const auto& cmd : vcmd.commands()) {
+    if (!submitKernelInternal(cmd->sizes(), cmd->kernel(), cmd->parameters(),
+        static_cast<void*>(as_cl(&vcmd.event())), cmd->sharedMemBytes(), cmd)) {
+      LogError("AQL dispatch failed!");
+      vcmd.setStatus(CL_INVALID_OPERATION);
+      break;
+    }
+  }
+  batchDispatch_ = false;
+
+  if (doorbellPending_) {
+    hsa_signal_store_screlease(gpu_queue_->doorbell_signal,
+                               hsa_queue_load_write_index_relaxed(gpu_queue_) - 1);
+    doorbellPending_ = false;
+  }
+
+  profilingEnd(vcmd);
+}
+
 // ================================================================================================
 void VirtualGPU::submitNativeFn(amd::NativeFnCommand& cmd) {
 }
@@ -3513,6 +3654,31 @@ void VirtualGPU::flush(amd::Command* list, bool wait) {
 
   // Release all pinned memory
   releasePinnedMem();
+
+  // The queue is idle at this point, hence it's safe to move the stream to another HW queue
+  updateQueueLoad();
+}
+
+// ================================================================================================
+void VirtualGPU::updateQueueLoad() {
+  // Queues with a CU mask and the cooperative queue aren't shared through the pool
+  if (!ROC_QUEUE_LOAD_BALANCE || cooperative_ || (cuMask_.size() != 0)) {
+    return;
+  }
+  uint64_t load = averageQueueLoad(queueLoad_, submittedPackets_);
+  submittedPackets_ = 0;
+  if (load == queueLoad_) {
+    return;
+  }
+  amd::ScopedLock lock(execution());
+  hsa_queue_t* queue = roc_device_.rebalanceQueue(gpu_queue_, queueLoad_, load);
+  queueLoad_ = load;
+  if (queue != gpu_queue_) {
+    assert(!doorbellPending_ && "Migrate with unsubmitted packets");
+    gpu_queue_ = queue;
+    // The packets, captured for the old queue, refer to it in the hidden kernel arguments
+    queueGeneration_.fetch_add(1, std::memory_order_release);
+  }
 }
 
 // ================================================================================================
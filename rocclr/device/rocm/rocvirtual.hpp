@@ -30,6 +30,7 @@
 #include "rocprintf.hpp"
 #include "hsa/hsa_ven_amd_aqlprofile.h"
 #include "rocsched.hpp"
+#include "rockernarg.hpp"
 
 namespace roc {
 class Device;
@@ -318,6 +319,7 @@ class VirtualGPU : public device::VirtualDevice {
   void submitMapMemory(amd::MapMemoryCommand& cmd);
   void submitUnmapMemory(amd::UnmapMemoryCommand& cmd);
   void submitKernel(amd::NDRangeKernelCommand& cmd);
+  void submitKernelBatch(amd::KernelBatchCommand& cmd);
   bool submitKernelInternal(const amd::NDRangeContainer& sizes,  //!< Workload sizes
                             const amd::Kernel& kernel,           //!< Kernel for execution
                             const_address parameters,            //!< Parameters for the kernel
@@ -436,6 +438,8 @@ class VirtualGPU : public device::VirtualDevice {
                                                               uint16_t rest, bool blocking,
                                                               size_t size = 1);
 
+  //! Rings the deferred doorbell of a batch if the packet at index has to wait for a free slot
+  void ringPendingDoorbell(uint64_t index);
   void dispatchBarrierPacket(uint16_t packetHeader, bool skipSignal = false,
                              hsa_signal_t signal = hsa_signal_t{0});
   bool dispatchCounterAqlPacket(hsa_ext_amd_aql_pm4_packet_t* packet, const uint32_t gfxVersion,
@@ -454,11 +458,23 @@ class VirtualGPU : public device::VirtualDevice {
   bool initPool(size_t kernarg_pool_size);
   void destroyPool();
 
-  void resetKernArgPool() {
-    kernarg_pool_cur_offset_ = 0;
-    kernarg_pool_chunk_end_ = kernarg_pool_size_ / KernelArgPoolNumSignal;
-    active_chunk_ = 0;
-  }
+  //! Resets the kernarg pool. Note: should be called after AQL queue becomes idle
+  void resetKernArgPool();
+
+  //! Allocates the memory for the kernarg pool
+  address allocKernArgPoolMemory(size_t size, bool* device_local);
+
+  //! Frees the memory of a kernarg pool with the call, which matches the allocation
+  void freeKernArgPoolMemory(address base, size_t size, bool device_local);
+
+  //! Creates the signals, which track the chunks of the kernarg pool
+  bool createKernArgSignals(std::vector<hsa_signal_t>& signals);
+
+  //! Replaces the current kernarg pool with a bigger one. The old pool is retired
+  bool growKernArgPool(size_t min_chunk_size);
+
+  //! Releases the retired pools, which aren't referenced by GPU anymore
+  void releaseRetiredKernArgPools(bool force);
 
   uint64_t getVQVirtualAddress();
 
@@ -498,6 +514,10 @@ class VirtualGPU : public device::VirtualDevice {
   //! Resets the current queue state. Note: should be called after AQL queue becomes idle
   void ResetQueueStates();
 
+  //! Updates the stream load on the HW queue and migrates to a less loaded queue if needed.
+  //! Note: should be called after AQL queue becomes idle
+  void updateQueueLoad();
+
   std::vector<Memory*> xferWriteBuffers_;  //!< Stage write buffers
   std::vector<amd::Memory*> pinnedMems_;   //!< Pinned memory list
 
@@ -510,6 +530,8 @@ class VirtualGPU : public device::VirtualDevice {
       uint32_t addSystemScope_        : 1; //!< Insert a system scope to the next aql
       uint32_t tracking_created_      : 1; //!< Enabled if tracking object was properly initialized
       uint32_t retainExternalSignals_ : 1; //!< Indicate to retain external signal array
+      uint32_t batchDispatch_         : 1; //!< Defer the doorbell until the batch is written
+      uint32_t doorbellPending_       : 1; //!< Packets were written without a doorbell ring
     };
     uint32_t  state_;
   };
@@ -538,15 +560,26 @@ class VirtualGPU : public device::VirtualDevice {
 
   HwQueueTracker  barriers_;      //!< Tracks active barriers in ROCr
 
+  //! Kernarg pool, which was replaced with a bigger one, but still can be referenced by GPU
+  struct KernArgPool {
+    address   base_;                      //!< The base address of the pool
+    uint32_t  size_;                      //!< The size of the pool
+    bool      deviceLocal_;               //!< The pool is in device local memory
+    std::vector<hsa_signal_t> signals_;   //!< HSA signals of the pool chunks
+  };
+
   //!< The number of chunks the kernel arg pool will be divided
-  static constexpr uint32_t KernelArgPoolNumSignal = 4;
-  address   kernarg_pool_base_;
-  uint32_t  kernarg_pool_size_;
-  uint32_t  kernarg_pool_chunk_end_;    //!< The end offset of the current chunck
-  uint32_t  active_chunk_;              //!< The index of the current active chunk
-  uint32_t  kernarg_pool_cur_offset_;
+  static constexpr uint32_t KernelArgPoolNumSignal = KernArgRing::NumChunks;
+  KernArgRing kernarg_ring_;            //!< Offsets of the current kernarg pool
+  bool      kernarg_pool_device_local_ = false; //!< The current pool is in device local memory
   std::vector<hsa_signal_t> kernarg_pool_signal_; //!< Pool of HSA signals to manage
                                                   //!< multiple chunks
+  std::vector<KernArgPool> retired_kernarg_pools_;  //!< Pools, which wait for GPU to retire
+  uint64_t  kernarg_pool_grows_ = 0;    //!< The number of times the pool was grown
+  uint64_t  kernarg_pool_stalls_ = 0;   //!< The number of times runtime waited for a chunk
+
+  uint64_t  submittedPackets_ = 0;      //!< AQL packets submitted since the last flush
+  uint64_t  queueLoad_ = 0;             //!< Averaged stream load, accounted on gpu_queue_
 
   friend class Timestamp;
 
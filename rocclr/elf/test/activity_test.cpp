@@ -0,0 +1,187 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "stub_device.hpp"
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <platform/activity.hpp>
+#include <platform/kernel.hpp>
+#include <platform/program.hpp>
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+// The number of dispatch records, delivered to the dummy tool
+static std::atomic<uint64_t> dispatchRecords{0};
+
+// Dummy tool, which enables all operations and counts the delivered kernel records
+static int dummyTool(activity_domain_t domain, uint32_t operation_id, void* data) {
+  if ((data != nullptr) && (operation_id == OP_ID_DISPATCH)) {
+    dispatchRecords++;
+  }
+  return 0;
+}
+
+// Enqueues kernels and completes them with a marker
+static void launchKernels(amd::HostQueue& queue, amd::Kernel& kernel, size_t count) {
+  const size_t globalSize[1] = {64};
+  const size_t localSize[1] = {64};
+  amd::NDRangeContainer sizes(1, nullptr, globalSize, localSize);
+  for (size_t i = 0; i < count; ++i) {
+    auto command =
+        new amd::NDRangeKernelCommand(queue, amd::Command::EventWaitList{}, kernel, sizes);
+    command->captureAndValidate();
+    command->enqueue();
+    command->release();
+  }
+  amd::Command* marker = new amd::Marker(queue, false);
+  marker->enqueue();
+  marker->release();
+}
+
+bool testSyncDelivery(amd::HostQueue& queue, amd::Kernel& kernel) {
+  constexpr size_t kKernels = 10;
+  activity_prof::RegisterReportActivity(dummyTool);
+  dispatchRecords = 0;
+
+  // The records of the completed kernels are buffered and must reach the tool on the finish
+  launchKernels(queue, kernel, kKernels);
+  queue.finish();
+  if (dispatchRecords != kKernels) {
+    LogPrintfError("%lu records after the finish, expected %zu",
+                   static_cast<unsigned long>(dispatchRecords.load()), kKernels);
+    return false;
+  }
+
+  // A thread completes kernels and goes idle. The finish of another thread delivers its records
+  std::mutex lock;
+  std::condition_variable cv;
+  bool launched = false;
+  bool done = false;
+  std::thread worker([&]() {
+    amd::Thread* thread = amd::Thread::current();
+    if (!VDI_CHECK_THREAD(thread)) {
+      return;
+    }
+    launchKernels(queue, kernel, kKernels);
+    std::unique_lock<std::mutex> l(lock);
+    launched = true;
+    cv.notify_all();
+    cv.wait(l, [&]() { return done; });
+  });
+  {
+    std::unique_lock<std::mutex> l(lock);
+    cv.wait(l, [&]() { return launched; });
+  }
+  queue.finish();
+  const uint64_t delivered = dispatchRecords;
+  {
+    std::unique_lock<std::mutex> l(lock);
+    done = true;
+    cv.notify_all();
+  }
+  worker.join();
+  activity_prof::RegisterReportActivity(nullptr);
+  if (delivered != 2 * kKernels) {
+    LogPrintfError("%lu records after the finish, the idle thread's records are stuck",
+                   static_cast<unsigned long>(delivered));
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Measures the host cost of the activity queries and of the kernel launches with the records
+// delivered to the dummy tool
+void benchmark(amd::HostQueue& queue, amd::Kernel& kernel) {
+  constexpr size_t kQueries = 10000000;
+  constexpr size_t kGroups = 20000;
+  constexpr size_t kKernels = 16;
+  for (bool tool : {false, true}) {
+    activity_prof::RegisterReportActivity(tool ? dummyTool : nullptr);
+    uint64_t start = amd::Os::timeNanos();
+    size_t enabled = 0;
+    for (size_t i = 0; i < kQueries; ++i) {
+      enabled += activity_prof::IsEnabled(OP_ID_DISPATCH) ? 1 : 0;
+    }
+    double query = static_cast<double>(amd::Os::timeNanos() - start) / kQueries;
+
+    start = amd::Os::timeNanos();
+    for (size_t g = 0; g < kGroups; ++g) {
+      launchKernels(queue, kernel, kKernels);
+      queue.finish();
+    }
+    double launch = static_cast<double>(amd::Os::timeNanos() - start) / (kGroups * kKernels);
+    printf("%s: %s tool, IsEnabled %.2f ns (%zu enabled), %.1f ns per kernel with a finish "
+           "per %zu kernels\n", __func__, tool ? "dummy" : "no", query, enabled, launch,
+           kKernels);
+  }
+  activity_prof::RegisterReportActivity(nullptr);
+}
+
+int main(int argc, char** argv) {
+  amd::Flag::init();
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread)) {
+    printf("%s: Couldn't create the host thread!\n", __func__);
+    return 1;
+  }
+  // HIP submits from the caller's thread and reports the activity before the status update
+  AMD_DIRECT_DISPATCH = true;
+  amd::IS_HIP = true;
+
+  StubDevice* dev = new StubDevice();
+  if (!dev->create()) {
+    printf("%s: Couldn't create the stub device!\n", __func__);
+    return 1;
+  }
+  amd::Context* context = new amd::Context({dev}, amd::Context::Info());
+  amd::HostQueue* queue = new amd::HostQueue(*context, *dev, 0);
+  if (queue->vdev() == nullptr) {
+    printf("%s: Couldn't create the queue!\n", __func__);
+    return 1;
+  }
+  // The kernel has no arguments, since the stub device never executes it
+  amd::Program* program = new amd::Program(*context);
+  StubProgram devProgram(*dev, *program);
+  StubKernel devKernel(*dev, devProgram);
+  amd::Symbol symbol;
+  symbol.setDeviceKernel(*dev, &devKernel);
+  amd::Kernel* kernel = new amd::Kernel(*program, symbol, "stub");
+
+  bool ret = true;
+  if ((argc > 1) && (strcmp(argv[1], "--benchmark") == 0)) {
+    benchmark(*queue, *kernel);
+  } else {
+    ret = testSyncDelivery(*queue, *kernel);
+    printf("%s: testSyncDelivery() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+
+  kernel->release();
+  program->release();
+  queue->release();
+  context->release();
+  dev->release();
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,156 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <utils/concurrent.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+// The value words of every key are derived from the key, so a torn entry is detected
+typedef amd::ConcurrentCache<2, 3, 8> TestCache;
+
+static void makeKey(uint64_t id, TestCache::Key& key) {
+  key[0] = id;
+  key[1] = ~id;
+}
+
+static void makeValue(uint64_t id, uint64_t version, TestCache::Value& value) {
+  value[0] = id * 3;
+  value[1] = version;
+  value[2] = id ^ version;
+}
+
+static bool isConsistent(uint64_t id, const TestCache::Value& value) {
+  return (value[0] == id * 3) && (value[2] == (id ^ value[1]));
+}
+
+bool testFindInsert() {
+  TestCache cache;
+  TestCache::Key key;
+  TestCache::Value value;
+
+  makeKey(1, key);
+  if (cache.find(key, value)) {
+    LogError("An empty cache reported a hit");
+    return false;
+  }
+
+  makeValue(1, 7, value);
+  cache.insert(key, value);
+  TestCache::Value found = {};
+  if (!cache.find(key, found) || (found[1] != 7) || !isConsistent(1, found)) {
+    LogError("The inserted value wasn't found");
+    return false;
+  }
+
+  // Replace the value of the same key
+  makeValue(1, 8, value);
+  cache.insert(key, value);
+  if (!cache.find(key, found) || (found[1] != 8)) {
+    LogError("The replaced value wasn't found");
+    return false;
+  }
+
+  // A different key must never return the value of another key
+  for (uint64_t id = 2; id < 64; ++id) {
+    TestCache::Key other;
+    makeKey(id, other);
+    if (cache.find(other, found)) {
+      LogPrintfError("Key %llu hit the value of key 1", static_cast<unsigned long long>(id));
+      return false;
+    }
+  }
+
+  // More keys than entries evict each other, but the hits stay exact
+  for (uint64_t id = 0; id < 64; ++id) {
+    makeKey(id, key);
+    makeValue(id, 0, value);
+    cache.insert(key, value);
+  }
+  uint hits = 0;
+  for (uint64_t id = 0; id < 64; ++id) {
+    makeKey(id, key);
+    if (cache.find(key, found)) {
+      if (!isConsistent(id, found)) {
+        LogPrintfError("Key %llu returned a wrong value", static_cast<unsigned long long>(id));
+        return false;
+      }
+      ++hits;
+    }
+  }
+  if ((hits == 0) || (hits > 8)) {
+    LogPrintfError("Unexpected number of hits %u with 8 entries", hits);
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testConcurrentAccess() {
+  constexpr uint kNumThreads = 8;
+  constexpr uint kNumKeys = 32;
+  constexpr uint kIterations = 200000;
+
+  TestCache cache;
+  std::atomic<bool> torn(false);
+  std::vector<std::thread> threads;
+  for (uint t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&cache, &torn, t]() {
+      TestCache::Key key;
+      TestCache::Value value;
+      for (uint i = 0; i < kIterations; ++i) {
+        const uint64_t id = (i * 7 + t) % kNumKeys;
+        makeKey(id, key);
+        if ((i + t) & 1) {
+          makeValue(id, i, value);
+          cache.insert(key, value);
+        } else if (cache.find(key, value) && !isConsistent(id, value)) {
+          torn = true;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (torn) {
+    LogError("A lookup returned a torn or foreign value");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  bool ret = testFindInsert();
+  printf("%s: testFindInsert() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testConcurrentAccess();
+    printf("%s: testConcurrentAccess() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
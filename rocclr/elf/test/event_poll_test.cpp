@@ -0,0 +1,138 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "stub_device.hpp"
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Counts the heap allocations of the threads, which enabled the counting
+static std::atomic<uint64_t> numHeapAllocs(0);
+static thread_local bool countHeapAllocs = false;
+
+void* operator new(size_t size) {
+  if (countHeapAllocs) {
+    ++numHeapAllocs;
+  }
+  void* ptr = malloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+constexpr size_t kPolls = 1000000;
+
+// The status poll of hipEventQuery, as hip::Event::ready() does it
+static bool pollEvent(amd::Event& event) {
+  if (event.status() != CL_COMPLETE) {
+    event.notifyCmdQueue();
+  }
+  return event.status() == CL_COMPLETE;
+}
+
+// Polls the event and returns the number of the heap allocations
+static uint64_t countPollAllocs(amd::Event& event, bool expected) {
+  numHeapAllocs = 0;
+  countHeapAllocs = true;
+  size_t mismatches = 0;
+  for (size_t i = 0; i < kPolls; ++i) {
+    mismatches += (pollEvent(event) != expected) ? 1 : 0;
+  }
+  countHeapAllocs = false;
+  if (mismatches != 0) {
+    LogPrintfError("%zu polls returned a wrong status", mismatches);
+  }
+  return numHeapAllocs;
+}
+
+// The polls of a completed event don't allocate
+bool testCompletedPolls(amd::HostQueue& queue) {
+  amd::Command* marker = new amd::Marker(queue, false);
+  marker->enqueue();
+  queue.finish();
+  const uint64_t allocs = countPollAllocs(marker->event(), true);
+  marker->release();
+  if (allocs != 0) {
+    LogPrintfError("%s: %lu allocations in %zu polls", __func__,
+                   static_cast<unsigned long>(allocs), kPolls);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// The polls of a pending event notify the queue once, with a single marker
+bool testPendingPolls(amd::HostQueue& queue) {
+  // A command, which was never submitted, stays pending
+  amd::Command* pending = new amd::Marker(queue, false);
+  const uint64_t allocs = countPollAllocs(pending->event(), false);
+  queue.finish();
+  pending->release();
+  if (allocs > 1) {
+    LogPrintfError("%s: %lu allocations in %zu polls", __func__,
+                   static_cast<unsigned long>(allocs), kPolls);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread)) {
+    printf("%s: Couldn't create the host thread!\n", __func__);
+    return 1;
+  }
+  // HIP submits from the caller's thread
+  AMD_DIRECT_DISPATCH = true;
+
+  StubDevice* dev = new StubDevice();
+  if (!dev->create()) {
+    printf("%s: Couldn't create the stub device!\n", __func__);
+    return 1;
+  }
+  amd::Context* context = new amd::Context({dev}, amd::Context::Info());
+  amd::HostQueue* queue = new amd::HostQueue(*context, *dev, 0);
+  if (queue->vdev() == nullptr) {
+    printf("%s: Couldn't create the queue!\n", __func__);
+    return 1;
+  }
+
+  bool ret = testCompletedPolls(*queue);
+  printf("%s: testCompletedPolls() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testPendingPolls(*queue);
+    printf("%s: testPendingPolls() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+
+  queue->release();
+  context->release();
+  dev->release();
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,320 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <hip_graph_kernarg.hpp>
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <utils/util.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+
+using hip::GraphKernargSlots;
+
+constexpr size_t kChunkSize = 128 * Ki;
+constexpr size_t kArgSize = 256;
+constexpr size_t kArgAlignment = 16;
+
+//! CPU simulation of a captured graph. Every launch reads the slots of all nodes until the
+//! simulated GPU completes it. The verification tracks the slots of every launch in flight
+class SimGraph {
+ public:
+  SimGraph(size_t nodes, bool verify) : slots_(kChunkSize), nodes_(nodes), verify_(verify) {
+    for (auto& node : nodes_) {
+      node = slots_.Replace({}, kArgSize, kArgAlignment, 0, 0, chunkAlloc_);
+    }
+  }
+  ~SimGraph() {
+    for (auto& chunk : slots_.Chunks()) {
+      free(chunk.ptr);
+    }
+  }
+
+  //! Updates the node and checks, that no launch in flight reads the new slot
+  bool update(size_t node) {
+    GraphKernargSlots::Slot slot =
+        slots_.Replace(nodes_[node], kArgSize, kArgAlignment, launches_, completed(), chunkAlloc_);
+    if ((slot.ptr == nullptr) || ((reinterpret_cast<uintptr_t>(slot.ptr) % kArgAlignment) != 0)) {
+      LogError("The slot allocation failed");
+      return false;
+    }
+    if (!verify_) {
+      nodes_[node] = slot;
+      return true;
+    }
+    for (const auto& launch : inFlight_) {
+      for (const auto& used : launch) {
+        if ((slot.ptr < used.ptr + used.size) && (used.ptr < slot.ptr + kArgSize)) {
+          LogError("The new arguments overlap the arguments of a launch in flight");
+          return false;
+        }
+      }
+    }
+    if ((completed() == launches_) && (slot.ptr != nodes_[node].ptr)) {
+      LogError("The arguments weren't patched in place without launches in flight");
+      return false;
+    }
+    nodes_[node] = slot;
+    return true;
+  }
+
+  void launch() {
+    ++launches_;
+    inFlight_.push_back(verify_ ? nodes_ : std::vector<GraphKernargSlots::Slot>());
+  }
+  //! GPU completes the oldest launch
+  void complete() { inFlight_.pop_front(); }
+  uint64_t completed() const { return launches_ - inFlight_.size(); }
+
+  const GraphKernargSlots& slots() const { return slots_; }
+  size_t chunkBytes() const {
+    size_t bytes = 0;
+    for (auto& chunk : slots_.Chunks()) {
+      bytes += chunk.size;
+    }
+    return bytes;
+  }
+
+ private:
+  GraphKernargSlots::ChunkAlloc chunkAlloc_ = [](size_t size) {
+    return reinterpret_cast<uint8_t*>(aligned_alloc(4 * Ki, amd::alignUp(size, 4 * Ki)));
+  };
+  GraphKernargSlots slots_;
+  std::vector<GraphKernargSlots::Slot> nodes_;
+  std::deque<std::vector<GraphKernargSlots::Slot>> inFlight_;
+  uint64_t launches_ = 0;
+  bool verify_;
+};
+
+// Updates without launches in flight patch the arguments in place
+bool testInPlace() {
+  SimGraph graph(64, true);
+  const size_t bytes = graph.chunkBytes();
+  for (int i = 0; i < 10000; ++i) {
+    graph.launch();
+    graph.complete();
+    if (!graph.update(i % 64)) {
+      return false;
+    }
+  }
+  if ((graph.chunkBytes() != bytes) || (graph.slots().NumFree() != 0)) {
+    LogError("In place updates allocated new slots");
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Updates with launches in flight move the arguments. The old slots are reused after the
+// launches complete, so the memory stays bounded
+bool testInFlight() {
+  constexpr size_t kNodes = 1000;
+  constexpr size_t kDepth = 3;
+  SimGraph graph(kNodes, true);
+  std::mt19937 gen(1);
+  size_t peakBytes = 0;
+  for (int cycle = 0; cycle < 5000; ++cycle) {
+    for (int i = 0; i < 10; ++i) {
+      if (!graph.update(gen() % kNodes)) {
+        return false;
+      }
+    }
+    graph.launch();
+    if (cycle > kDepth) {
+      graph.complete();
+    }
+    if (cycle == 100) {
+      peakBytes = graph.chunkBytes();
+    }
+  }
+  // The slots of the launches in flight and a chunk of the free slots at most
+  const size_t maxBytes = kNodes * kArgSize + (kDepth + 1) * 10 * kArgSize + 2 * kChunkSize;
+  if ((graph.chunkBytes() != peakBytes) || (graph.chunkBytes() > maxBytes)) {
+    LogPrintfError("%s: %zu bytes of the kernel arguments, %zu bytes after 100 cycles",
+                   __func__, graph.chunkBytes(), peakBytes);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// The copied arguments share one allocation with the pointer array. Copies of the same
+// arguments compare bytewise, even with garbage after the argument values
+bool testCopyParams() {
+  const std::vector<size_t> sizes = {4, 8, 1, 24, 16, 2};
+  std::vector<std::vector<uint8_t>> values;
+  std::vector<void*> params;
+  std::mt19937 gen(2);
+  for (size_t size : sizes) {
+    values.emplace_back(size + 32);
+    for (auto& byte : values.back()) {
+      byte = gen();
+    }
+    params.push_back(values.back().data());
+  }
+  auto sizeOf = [&sizes](uint32_t i) { return sizes[i]; };
+  size_t size = 0, otherSize = 0;
+  void** copy = hip::CopyKernelParams(params.data(), sizes.size(), sizeOf, &size);
+  for (auto& value : values) {
+    std::fill(value.begin() + 32, value.end(), 0xff);
+  }
+  void** other = hip::CopyKernelParams(params.data(), sizes.size(), sizeOf, &otherSize);
+  bool ret = (copy != nullptr) && (other != nullptr) && (size == otherSize);
+  const size_t offset = hip::KernelParamsDataOffset(sizes.size());
+  for (size_t i = 0; ret && (i < sizes.size()); ++i) {
+    const uint8_t* arg = reinterpret_cast<uint8_t*>(copy[i]);
+    const uint8_t* begin = reinterpret_cast<uint8_t*>(copy);
+    ret = (arg >= begin + offset) && (arg + sizes[i] <= begin + size) &&
+          ((reinterpret_cast<uintptr_t>(arg) % hip::kKernelParamAlignment) == 0) &&
+          (memcmp(arg, values[i].data(), sizes[i]) == 0);
+  }
+  if (!ret || (memcmp(reinterpret_cast<uint8_t*>(copy) + offset,
+                      reinterpret_cast<uint8_t*>(other) + offset, size - offset) != 0)) {
+    LogPrintfError("%s: the copied arguments don't match", __func__);
+    ret = false;
+  }
+  free(copy);
+  free(other);
+  // A kernel without arguments
+  void** empty = hip::CopyKernelParams(nullptr, 0, sizeOf, &size);
+  if ((empty == nullptr) || (size != 0)) {
+    LogPrintfError("%s: %zu bytes for a kernel without arguments", __func__, size);
+    ret = false;
+  }
+  free(empty);
+  if (ret) {
+    LogPrintfInfo("%s: Succeeded", __func__);
+  }
+  return ret;
+}
+
+// The 'extra' struct keeps the tags, and the kernargs and their size are in the same allocation
+bool testCopyExtra() {
+  uint8_t kernargs[40];
+  for (size_t i = 0; i < sizeof(kernargs); ++i) {
+    kernargs[i] = i;
+  }
+  size_t kernargsSize = sizeof(kernargs);
+  int tags[3];
+  void* extra[] = {&tags[0], kernargs, &tags[1], &kernargsSize, &tags[2]};
+  size_t size = 0;
+  void** copy = hip::CopyKernelExtra(extra, &size);
+  const uint8_t* begin = reinterpret_cast<uint8_t*>(copy);
+  bool ret = (copy != nullptr) && (copy[0] == &tags[0]) && (copy[2] == &tags[1]) &&
+             (copy[4] == &tags[2]);
+  ret = ret && (copy[1] >= begin) && (copy[1] < begin + size) && (copy[3] >= begin) &&
+        (copy[3] < begin + size) && (*reinterpret_cast<size_t*>(copy[3]) == sizeof(kernargs)) &&
+        (static_cast<uint8_t*>(copy[1]) + sizeof(kernargs) == begin + size) &&
+        (memcmp(copy[1], kernargs, sizeof(kernargs)) == 0);
+  free(copy);
+  if (!ret) {
+    LogPrintfError("%s: the copied 'extra' struct doesn't match", __func__);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Measures the update cost and the argument memory by the graph size. Every cycle changes
+// 1% of the nodes and launches the graph with 2 launches in flight
+void benchmark() {
+  constexpr int kCycles = 1000;
+  for (size_t count : {100u, 1000u, 10000u, 100000u}) {
+    SimGraph graph(count, false);
+    const size_t initialBytes = graph.chunkBytes();
+    const size_t changed = std::max<size_t>(count / 100, 1);
+    std::mt19937 gen(count);
+    auto start = std::chrono::steady_clock::now();
+    for (int cycle = 0; cycle < kCycles; ++cycle) {
+      for (size_t i = 0; i < changed; ++i) {
+        graph.update(gen() % count);
+      }
+      graph.launch();
+      if (cycle >= 2) {
+        graph.complete();
+      }
+    }
+    auto time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+    printf("%s: %zu nodes, %.1f ns per node update, %zu KiB of kernel arguments after %d "
+           "updates, %zu KiB without the reuse\n", __func__, count,
+           time.count() / (kCycles * changed), graph.chunkBytes() / Ki, kCycles * (int)changed,
+           (initialBytes + kCycles * changed * kArgSize) / Ki);
+  }
+
+  // Argument copies of a kernel node with 8 arguments, against one allocation per argument
+  constexpr int kCopies = 1000000;
+  constexpr uint32_t kParams = 8;
+  uint64_t args[kParams] = {};
+  void* params[kParams];
+  for (uint32_t i = 0; i < kParams; ++i) {
+    params[i] = &args[i];
+  }
+  auto sizeOf = [](uint32_t) { return sizeof(uint64_t); };
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCopies; ++i) {
+    size_t size;
+    free(hip::CopyKernelParams(params, kParams, sizeOf, &size));
+  }
+  auto time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kCopies; ++i) {
+    void** copy = reinterpret_cast<void**>(malloc(kParams * sizeof(void*)));
+    for (uint32_t j = 0; j < kParams; ++j) {
+      copy[j] = malloc(sizeof(uint64_t));
+      memcpy(copy[j], params[j], sizeof(uint64_t));
+    }
+    for (uint32_t j = 0; j < kParams; ++j) {
+      free(copy[j]);
+    }
+    free(copy);
+  }
+  auto perArgTime =
+      std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+  printf("%s: %u arguments, %.1f ns per copy, %.1f ns with an allocation per argument\n",
+         __func__, kParams, time.count() / kCopies, perArgTime.count() / kCopies);
+}
+
+int main(int argc, char** argv) {
+  amd::Flag::init();
+  if ((argc > 1) && (strcmp(argv[1], "--benchmark") == 0)) {
+    benchmark();
+    return 0;
+  }
+  bool ret = testInPlace();
+  printf("%s: testInPlace() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testInFlight();
+    printf("%s: testInFlight() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testCopyParams();
+    printf("%s: testCopyParams() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testCopyExtra();
+    printf("%s: testCopyExtra() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
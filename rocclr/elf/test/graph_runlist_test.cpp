@@ -0,0 +1,226 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <hip_graph_runlist.hpp>
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <random>
+
+//! Graph node with the successors only
+struct TestNode {
+  std::vector<TestNode*> edges;
+  const std::vector<TestNode*>& GetEdges() const { return edges; }
+};
+typedef TestNode* Node;
+typedef std::vector<std::vector<Node>> Lists;
+typedef std::unordered_map<Node, std::vector<Node>> Dependencies;
+
+//! Nodes of a graph in the order of insertion
+struct TestGraph {
+  std::vector<std::unique_ptr<TestNode>> storage;
+  std::vector<Node> vertices;
+
+  explicit TestGraph(uint32_t count) {
+    for (uint32_t i = 0; i < count; ++i) {
+      storage.emplace_back(new TestNode());
+      vertices.push_back(storage.back().get());
+    }
+  }
+};
+
+// Builds a random DAG with up to maxEdges successors per node within the next window nodes.
+// The vertices are shuffled, so the traversal starts in the middle of the chains as well
+static void makeRandomDag(TestGraph& graph, uint32_t maxEdges, uint32_t window, uint32_t seed) {
+  std::mt19937 gen(seed);
+  const uint32_t count = graph.vertices.size();
+  for (uint32_t i = 0; i + 1 < count; ++i) {
+    const uint32_t edges = gen() % (maxEdges + 1);
+    for (uint32_t e = 0; e < edges; ++e) {
+      Node succ = graph.vertices[i + 1 + gen() % std::min(window, count - i - 1)];
+      auto& list = graph.vertices[i]->edges;
+      if (std::find(list.begin(), list.end(), succ) == list.end()) {
+        list.push_back(succ);
+      }
+    }
+  }
+  std::shuffle(graph.vertices.begin(), graph.vertices.end(), gen);
+}
+
+// The recursive run list analysis, which the graphs used before BuildRunLists()
+static void refRunListUtil(Node v, std::unordered_map<Node, bool>& visited,
+                           std::vector<Node>& singleList, Lists& parallelLists,
+                           Dependencies& dependencies) {
+  visited[v] = true;
+  singleList.push_back(v);
+  for (auto& adjNode : v->GetEdges()) {
+    if (!visited[adjNode]) {
+      if (singleList.empty()) {
+        dependencies[adjNode].push_back(v);
+      }
+      refRunListUtil(adjNode, visited, singleList, parallelLists, dependencies);
+    } else {
+      for (auto& list : parallelLists) {
+        if (adjNode == list[0]) {
+          for (auto k = singleList.rbegin(); k != singleList.rend(); ++k) {
+            list.insert(list.begin(), *k);
+          }
+          singleList.erase(singleList.begin(), singleList.end());
+        }
+      }
+      if (!singleList.empty()) {
+        dependencies[adjNode].push_back(v);
+      }
+    }
+  }
+  if (!singleList.empty()) {
+    parallelLists.push_back(singleList);
+    singleList.erase(singleList.begin(), singleList.end());
+  }
+}
+
+static void refRunList(const std::vector<Node>& vertices, Lists& parallelLists,
+                       Dependencies& dependencies) {
+  std::vector<Node> singleList;
+  std::unordered_map<Node, bool> visited;
+  for (auto node : vertices) visited[node] = false;
+  for (auto node : vertices) {
+    if (visited[node] == false) {
+      refRunListUtil(node, visited, singleList, parallelLists, dependencies);
+    }
+  }
+}
+
+static size_t buildRunLists(const std::vector<Node>& vertices, Lists& parallelLists,
+                            Dependencies& dependencies) {
+  size_t reported = 0;
+  hip::BuildRunLists(vertices, parallelLists, dependencies,
+                     [&reported](Node, Node) { ++reported; });
+  return reported;
+}
+
+bool testDiamond() {
+  // a -> b -> d, a -> c -> d
+  TestGraph graph(4);
+  Node a = graph.vertices[0], b = graph.vertices[1], c = graph.vertices[2],
+       d = graph.vertices[3];
+  a->edges = {b, c};
+  b->edges = {d};
+  c->edges = {d};
+  Lists lists;
+  Dependencies dependencies;
+  const size_t reported = buildRunLists(graph.vertices, lists, dependencies);
+  if ((lists != Lists{{a, b, d}, {c}}) || (dependencies.size() != 2) ||
+      (dependencies[c] != std::vector<Node>{a}) || (dependencies[d] != std::vector<Node>{c}) ||
+      (reported != 2)) {
+    LogPrintfError("%s: %zu lists, %zu dependencies", __func__, lists.size(),
+                   dependencies.size());
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// The lists and dependencies match the recursive analysis, including the merged lists
+bool testMatchesRecursive() {
+  for (uint32_t seed = 0; seed < 200; ++seed) {
+    TestGraph graph(1 + seed % 97);
+    makeRandomDag(graph, 1 + seed % 4, 1 + seed % 8, seed);
+    Lists lists, refLists;
+    Dependencies dependencies, refDependencies;
+    buildRunLists(graph.vertices, lists, dependencies);
+    refRunList(graph.vertices, refLists, refDependencies);
+    if ((lists != refLists) || (dependencies != refDependencies)) {
+      LogPrintfError("%s: seed %u, %zu lists vs %zu recursive lists", __func__, seed,
+                     lists.size(), refLists.size());
+      return false;
+    }
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// A chain deeper than the thread stack could hold with one frame per node
+bool testDeepChain() {
+  constexpr uint32_t kCount = 1000000;
+  TestGraph graph(kCount);
+  for (uint32_t i = 0; i + 1 < kCount; ++i) {
+    graph.vertices[i]->edges.push_back(graph.vertices[i + 1]);
+  }
+  Lists lists;
+  Dependencies dependencies;
+  buildRunLists(graph.vertices, lists, dependencies);
+  if ((lists.size() != 1) || (lists[0] != graph.vertices) || !dependencies.empty()) {
+    LogPrintfError("%s: %zu lists, %zu dependencies", __func__, lists.size(),
+                   dependencies.size());
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Measures the analysis time of large random graphs, against the recursive analysis
+void benchmark() {
+  for (uint32_t count : {1000u, 10000u, 100000u}) {
+    TestGraph graph(count);
+    makeRandomDag(graph, 2, 64, count);
+    Lists lists;
+    Dependencies dependencies;
+    auto start = std::chrono::steady_clock::now();
+    buildRunLists(graph.vertices, lists, dependencies);
+    auto time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    printf("%s: %u nodes, %.3f ms per analysis, %zu lists", __func__, count, time.count(),
+           lists.size());
+    if (count <= 10000) {
+      Lists refLists;
+      Dependencies refDependencies;
+      start = std::chrono::steady_clock::now();
+      refRunList(graph.vertices, refLists, refDependencies);
+      time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+      printf(", %.3f ms recursive", time.count());
+    }
+    printf("\n");
+  }
+}
+
+int main(int argc, char** argv) {
+  amd::Flag::init();
+  if ((argc > 1) && (strcmp(argv[1], "--benchmark") == 0)) {
+    benchmark();
+    return 0;
+  }
+  bool ret = testDiamond();
+  printf("%s: testDiamond() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testMatchesRecursive();
+    printf("%s: testMatchesRecursive() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testDeepChain();
+    printf("%s: testDeepChain() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,154 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <hip_graph_schedule.hpp>
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <set>
+
+typedef std::vector<std::vector<uint32_t>> Successors;
+
+// Builds a random DAG in topological order. Every node has up to maxEdges successors within
+// the next window nodes
+static void makeRandomDag(uint32_t count, uint32_t maxEdges, uint32_t window, uint32_t seed,
+                          std::vector<uint64_t>& cost, Successors& successors) {
+  std::mt19937 gen(seed);
+  cost.assign(count, 0);
+  successors.assign(count, {});
+  for (uint32_t i = 0; i < count; ++i) {
+    cost[i] = 1 + gen() % 100;
+    const uint32_t edges = gen() % (maxEdges + 1);
+    for (uint32_t e = 0; (e < edges) && (i + 1 < count); ++e) {
+      const uint32_t succ = i + 1 + gen() % std::min(window, count - i - 1);
+      if (std::find(successors[i].begin(), successors[i].end(), succ) == successors[i].end()) {
+        successors[i].push_back(succ);
+      }
+    }
+  }
+}
+
+bool testTrivial() {
+  if (!ScheduleGraphStreams({}, {}, 4).empty()) {
+    LogError("An empty graph returned streams");
+    return false;
+  }
+  // One stream or a chain keeps every node on stream 0
+  const std::vector<uint64_t> cost = {5, 5, 5};
+  const Successors fork = {{1, 2}, {}, {}};
+  const Successors chain = {{1}, {2}, {}};
+  for (auto streams : {ScheduleGraphStreams(cost, fork, 1), ScheduleGraphStreams(cost, chain, 8)}) {
+    if (streams != std::vector<uint32_t>(3, 0)) {
+      LogError("A serial schedule used more than one stream");
+      return false;
+    }
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testCriticalPath() {
+  // 0 -> {1, 2} -> 3, the long branch 1 must stay with the join on stream 0
+  const std::vector<uint64_t> cost = {1, 100, 1, 1};
+  const Successors successors = {{1, 2}, {3}, {3}, {}};
+  const std::vector<uint32_t> streams = ScheduleGraphStreams(cost, successors, 2);
+  const std::vector<uint32_t> expected = {0, 0, 1, 0};
+  if (streams != expected) {
+    LogPrintfError("Got streams {%u, %u, %u, %u}, expected {0, 0, 1, 0}", streams[0],
+                   streams[1], streams[2], streams[3]);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testBoundedStreams() {
+  // A root with 16 equal independent branches fills exactly the allowed streams
+  constexpr uint32_t kBranches = 16;
+  constexpr uint32_t kMaxStreams = 4;
+  std::vector<uint64_t> cost(kBranches + 1, 10);
+  Successors successors(kBranches + 1);
+  for (uint32_t i = 1; i <= kBranches; ++i) {
+    successors[0].push_back(i);
+  }
+  const std::vector<uint32_t> streams = ScheduleGraphStreams(cost, successors, kMaxStreams);
+  const std::set<uint32_t> used(streams.begin(), streams.end());
+  if ((used.size() != kMaxStreams) || (*used.rbegin() >= kMaxStreams)) {
+    LogPrintfError("%zu streams used, expected %u", used.size(), kMaxStreams);
+    return false;
+  }
+
+  // Random graphs never exceed the bound and the schedule is deterministic
+  for (uint32_t seed = 0; seed < 32; ++seed) {
+    makeRandomDag(500, 3, 20, seed, cost, successors);
+    const std::vector<uint32_t> first = ScheduleGraphStreams(cost, successors, kMaxStreams);
+    if ((first.size() != cost.size()) ||
+        (*std::max_element(first.begin(), first.end()) >= kMaxStreams) ||
+        (first != ScheduleGraphStreams(cost, successors, kMaxStreams))) {
+      LogPrintfError("Invalid schedule of the random graph %u", seed);
+      return false;
+    }
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Measures the scheduling time of large random graphs
+void benchmark() {
+  for (uint32_t count : {1000u, 10000u, 100000u}) {
+    std::vector<uint64_t> cost;
+    Successors successors;
+    makeRandomDag(count, 4, 64, count, cost, successors);
+    constexpr uint32_t kRuns = 5;
+    std::vector<uint32_t> streams;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t run = 0; run < kRuns; ++run) {
+      streams = ScheduleGraphStreams(cost, successors, 8);
+    }
+    auto time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    printf("%s: %u nodes, %.3f ms per schedule, %u streams\n", __func__, count,
+           time.count() / kRuns, *std::max_element(streams.begin(), streams.end()) + 1);
+  }
+}
+
+int main(int argc, char** argv) {
+  amd::Flag::init();
+  if ((argc > 1) && (strcmp(argv[1], "--benchmark") == 0)) {
+    benchmark();
+    return 0;
+  }
+  bool ret = testTrivial();
+  printf("%s: testTrivial() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testCriticalPath();
+    printf("%s: testCriticalPath() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testBoundedStreams();
+    printf("%s: testBoundedStreams() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <hiprtcPch.hpp>
+
+#include <algorithm>
+#include <cstdio>
+
+using hiprtc::helpers::PchTable;
+
+static const std::string kHeader = "hiprtc_runtime.h";
+
+bool testOptions() {
+  const std::vector<std::string> options = {"-O3", "-include", "user.h", "-include", kHeader,
+                                            "-DN=1"};
+  const std::string key = hiprtc::helpers::pchKey("gfx90a", "2.6", options);
+  std::vector<std::string> swapped = options;
+  std::swap(swapped[0], swapped[5]);
+  if ((key == hiprtc::helpers::pchKey("gfx942", "2.6", options)) ||
+      (key == hiprtc::helpers::pchKey("gfx90a", "2.7", options)) ||
+      (key == hiprtc::helpers::pchKey("gfx90a", "2.6", swapped)) ||
+      (key != hiprtc::helpers::pchKey("gfx90a", "2.6", options))) {
+    LogError("The PCH key doesn't match the configuration");
+    return false;
+  }
+
+  // Only the builtin header is removed from the PCH build
+  const std::vector<std::string> build = hiprtc::helpers::pchBuildOptions(options, kHeader);
+  const std::vector<std::string> expectedBuild = {"-O3",     "-include",  "user.h",  "-DN=1",
+                                                  "-Xclang", "-emit-pch", "-Xclang",
+                                                  "-fno-pch-timestamp"};
+  if (build != expectedBuild) {
+    LogError("Unexpected PCH build options");
+    return false;
+  }
+
+  const std::vector<std::string> compile =
+      hiprtc::helpers::pchCompileOptions(options, kHeader, "/tmp/a.pch");
+  const std::vector<std::string> expectedCompile = {"-O3",          "-include",   "user.h",
+                                                    "-include-pch", "/tmp/a.pch", "-DN=1",
+                                                    "-Xclang",      "-fno-validate-pch"};
+  if (compile != expectedCompile) {
+    LogError("Unexpected compile options with the PCH");
+    return false;
+  }
+
+  // A trailing -include without a file isn't replaced
+  const std::vector<std::string> trailing = {"-include"};
+  if (hiprtc::helpers::pchCompileOptions(trailing, kHeader, "/tmp/a.pch")[0] != "-include") {
+    LogError("A trailing -include was replaced");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testBuildOnRepeat() {
+  PchTable table(4);
+  bool build = true;
+  if (!table.acquire("a", &build).empty() || build) {
+    LogError("The first compile of a configuration requested a PCH build");
+    return false;
+  }
+  if (!table.acquire("a", &build).empty() || !build) {
+    LogError("The repeated configuration didn't request a PCH build");
+    return false;
+  }
+  // Another compile during the build doesn't build again
+  if (!table.acquire("a", &build).empty() || build) {
+    LogError("A PCH build was requested twice");
+    return false;
+  }
+  table.insert("a", "a.pch");
+  if ((table.acquire("a", &build) != "a.pch") || build) {
+    LogError("The built PCH wasn't returned");
+    return false;
+  }
+
+  // A failed build isn't repeated
+  table.acquire("b", &build);
+  table.acquire("b", &build);
+  table.insert("b", "");
+  if (!table.acquire("b", &build).empty() || build) {
+    LogError("A failed PCH build was repeated");
+    return false;
+  }
+
+  // A rejected PCH isn't used, but its file is kept for the removal
+  table.reject("a");
+  if (!table.acquire("a", &build).empty() || build) {
+    LogError("A rejected PCH was used or built again");
+    return false;
+  }
+  if (table.files() != std::vector<std::string>{"a.pch"}) {
+    LogError("The rejected PCH file isn't removed with the table");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testBound() {
+  PchTable table(2);
+  bool build = false;
+  table.acquire("a", &build);
+  table.acquire("a", &build);
+  table.insert("a", "a.pch");
+  table.acquire("b", &build);
+  table.acquire("b", &build);
+  // The new configuration drops the oldest one
+  table.acquire("c", &build);
+  if (table.size() != 2) {
+    LogPrintfError("The table has %zu configurations, expected 2", table.size());
+    return false;
+  }
+  if (!table.acquire("a", &build).empty() || build) {
+    LogError("The dropped configuration was kept");
+    return false;
+  }
+  // The build of "b" finishes after the configuration was dropped by "a"
+  table.insert("b", "b.pch");
+  std::vector<std::string> files = table.files();
+  std::sort(files.begin(), files.end());
+  if (files != std::vector<std::string>{"a.pch", "b.pch"}) {
+    LogError("The dropped PCH files aren't removed with the table");
+    return false;
+  }
+
+  PchTable disabled(0);
+  disabled.acquire("a", &build);
+  disabled.acquire("a", &build);
+  if (build || (disabled.size() != 0)) {
+    LogError("A table without entries requested a PCH build");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testPchLoadError() {
+  const std::string pch = "/tmp/a.pch";
+  const char* loadErrors[] = {
+      "fatal error: PCH file '/tmp/a.pch' not found: module file not found",
+      "fatal error: malformed or corrupted AST file: 'could not find file'",
+      "error: PCH file was compiled for the target 'gfx90a' but the current translation unit "
+      "is being compiled for target 'gfx942'",
+      "error: precompiled header uses __DATE__ or __TIME__"};
+  for (const char* log : loadErrors) {
+    if (!hiprtc::helpers::isPchLoadError(log, pch)) {
+      LogPrintfError("A PCH load error wasn't detected: %s", log);
+      return false;
+    }
+  }
+  // Errors in the user source don't fall back to the compile without the PCH
+  const char* sourceErrors[] = {
+      "",
+      "user.cu:3:5: error: use of undeclared identifier 'x'",
+      "user.cu:7:1: error: expected ';' after top level declarator\n1 error generated."};
+  for (const char* log : sourceErrors) {
+    if (hiprtc::helpers::isPchLoadError(log, pch)) {
+      LogPrintfError("A source error was taken for a PCH load error: %s", log);
+      return false;
+    }
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  bool ret = testOptions();
+  printf("%s: testOptions() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testBuildOnRepeat();
+    printf("%s: testBuildOnRepeat() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testBound();
+    printf("%s: testBound() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testPchLoadError();
+    printf("%s: testPchLoadError() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <hip_event_ipc_signal.hpp>
+#include <top.hpp>
+#include <os/os.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using hip::ihipIpcEventShmem_t;
+
+static constexpr int kTestSkipped = 77;
+
+#if defined(__linux__)
+// Shared memory of the producer and the waiting process
+struct WakeShmem {
+  ihipIpcEventShmem_t event;
+  std::atomic<int> waiting;       //!< The last record the waiter started to wait for
+  std::atomic<uint64_t> release;  //!< Time of the last slot release by the producer
+  uint64_t latency[1];            //!< Release to wake latency of every record, in ns
+};
+
+// Releases the signal slot of every record after the other process blocked on it, similar to
+// the completion callback of an IPC event record. The other process waits with
+// ihipIpcEventWaitSignal and saves the time from the release until it returned
+static bool runWake(uint32_t records, std::vector<uint64_t>& latency) {
+  const size_t size = sizeof(WakeShmem) + sizeof(uint64_t) * records;
+  auto shmem = reinterpret_cast<WakeShmem*>(
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+  if (shmem == MAP_FAILED) {
+    LogError("Failed to map the shared memory");
+    return false;
+  }
+  memset(reinterpret_cast<void*>(shmem), 0, size);
+  shmem->event.read_index = -1;
+  shmem->waiting = -1;
+
+  pid_t pid = fork();
+  if (pid == 0) {
+    for (int record = 0; record < static_cast<int>(records); ++record) {
+      const int offset = record % IPC_SIGNALS_PER_EVENT;
+      // Wait for the record, then for the device release of its slot
+      while (shmem->event.read_index < record) {
+        amd::Os::yield();
+      }
+      shmem->waiting = record;
+      hip::ihipIpcEventWaitSignal(&shmem->event, offset, record + IPC_SIGNALS_PER_EVENT);
+      shmem->latency[record] = amd::Os::timeNanos() - shmem->release;
+    }
+    _exit(0);
+  }
+  if (pid < 0) {
+    LogError("Failed to start the waiting process");
+    munmap(shmem, size);
+    return false;
+  }
+
+  for (int record = 0; record < static_cast<int>(records); ++record) {
+    const int offset = record % IPC_SIGNALS_PER_EVENT;
+    shmem->event.signal[offset] = 1;
+    shmem->event.read_index = record;
+    while (shmem->waiting < record) {
+      amd::Os::yield();
+    }
+    // Let the waiter finish the spins and block in the kernel
+    usleep(200);
+    shmem->release = amd::Os::timeNanos();
+    shmem->event.signal[offset] = 0;
+    hip::ihipIpcEventWake(&shmem->event.signal[offset]);
+  }
+
+  int status = 0;
+  bool ret = (waitpid(pid, &status, 0) == pid) && WIFEXITED(status) &&
+             (WEXITSTATUS(status) == 0);
+  if (!ret) {
+    LogError("The waiting process failed");
+  }
+  latency.assign(shmem->latency, shmem->latency + records);
+  munmap(shmem, size);
+  return ret;
+}
+#endif
+
+bool testWakeLatency() {
+#if defined(__linux__)
+  constexpr uint32_t kRecords = 200;
+  std::vector<uint64_t> latency;
+  if (!runWake(kRecords, latency)) {
+    return false;
+  }
+  std::sort(latency.begin(), latency.end());
+  // Without the wake every waiter would sleep until the 1ms futex timeout
+  const uint64_t median = latency[kRecords / 2];
+  if (median >= 500000) {
+    LogPrintfError("The median wake latency is %llu ns, the waiters aren't woken up",
+                   static_cast<unsigned long long>(median));
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+#else
+  return true;
+#endif
+}
+
+void benchmark() {
+#if defined(__linux__)
+  constexpr uint32_t kRecords = 5000;
+  std::vector<uint64_t> latency;
+  if (!runWake(kRecords, latency)) {
+    return;
+  }
+  std::sort(latency.begin(), latency.end());
+  printf("%s: %u records, wake latency median %.1f us, p99 %.1f us, max %.1f us\n", __func__,
+         kRecords, latency[kRecords / 2] / 1000.0, latency[kRecords * 99 / 100] / 1000.0,
+         latency.back() / 1000.0);
+#endif
+}
+
+int main(int argc, char** argv) {
+  amd::Flag::init();
+#if !defined(__linux__)
+  return kTestSkipped;
+#endif
+  if ((argc > 1) && (strcmp(argv[1], "--benchmark") == 0)) {
+    benchmark();
+    return 0;
+  }
+  bool ret = testWakeLatency();
+  printf("%s: testWakeLatency() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,204 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <device/rocm/rockernarg.hpp>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using roc::KernArgRing;
+
+//! CPU simulation of the kernarg pool backend. Every chunk fence stands for the dispatches in
+//! flight, which reference the chunk, until the simulated GPU retires them
+class SimBackend {
+ public:
+  SimBackend(uint32_t size, uint32_t maxSize) : maxSize_(maxSize) { newPool(size); }
+
+  void fence(uint32_t chunk) { pools_.back().busy_[chunk] = true; }
+  bool busy(uint32_t chunk) { return pools_.back().busy_[chunk]; }
+  bool grow(size_t minChunk) {
+    size_t size = 2 * static_cast<size_t>(ring_.size());
+    while ((size / KernArgRing::NumChunks) < minChunk) {
+      size *= 2;
+    }
+    if (size > maxSize_) {
+      return false;
+    }
+    ++grows_;
+    newPool(static_cast<uint32_t>(size));
+    return true;
+  }
+  void wait(uint32_t chunk) {
+    ++stalls_;
+    retire(pools_.back(), chunk);
+  }
+
+  //! GPU passes all dispatches, which were fenced
+  void retireAll() {
+    for (auto& pool : pools_) {
+      for (uint32_t i = 0; i < KernArgRing::NumChunks; ++i) {
+        retire(pool, i);
+      }
+    }
+  }
+
+  //! Allocates and checks, that the arguments don't overlap any arguments in flight
+  bool alloc(size_t size, size_t alignment) {
+    address ptr = ring_.alloc(*this, size, alignment);
+    Pool& pool = pools_.back();
+    if ((ptr < pool.base()) || ((ptr + size) > (pool.base() + ring_.size())) ||
+        !amd::isMultipleOf(ptr, alignment)) {
+      LogError("The arguments are outside of the current pool or misaligned");
+      return false;
+    }
+    const uint32_t chunk = static_cast<uint32_t>((ptr - pool.base()) / ring_.chunkSize());
+    if (pool.busy_[chunk]) {
+      LogError("The arguments were placed in a chunk, which GPU still references");
+      return false;
+    }
+    for (const auto& live : pool.live_) {
+      if ((ptr < live.first + live.second) && (live.first < ptr + size)) {
+        LogError("The arguments overlap the arguments in flight");
+        return false;
+      }
+    }
+    pool.live_.push_back({ptr, size});
+    pool.liveChunk_.push_back(chunk);
+    return true;
+  }
+
+  KernArgRing ring_;
+  uint32_t grows_ = 0;
+  uint32_t stalls_ = 0;
+
+ private:
+  struct Pool {
+    std::unique_ptr<unsigned char[]> memory_;
+    std::vector<bool> busy_;
+    std::vector<std::pair<address, size_t>> live_;  //!< Arguments in flight
+    std::vector<uint32_t> liveChunk_;               //!< The chunks of the arguments
+    address base() const { return memory_.get(); }
+  };
+
+  void newPool(uint32_t size) {
+    pools_.push_back({std::unique_ptr<unsigned char[]>(new unsigned char[size]),
+                      std::vector<bool>(KernArgRing::NumChunks, false), {}, {}});
+    ring_.reset(pools_.back().base(), size);
+  }
+
+  void retire(Pool& pool, uint32_t chunk) {
+    if (!pool.busy_[chunk]) {
+      return;
+    }
+    pool.busy_[chunk] = false;
+    for (size_t i = 0; i < pool.live_.size();) {
+      if (pool.liveChunk_[i] == chunk) {
+        pool.live_.erase(pool.live_.begin() + i);
+        pool.liveChunk_.erase(pool.liveChunk_.begin() + i);
+      } else {
+        ++i;
+      }
+    }
+  }
+
+  uint32_t maxSize_;
+  std::vector<Pool> pools_;
+};
+
+bool testWrap() {
+  SimBackend sim(16 * 256, 16 * 256);
+  // GPU keeps up with the dispatches, so the pool wraps without a grow or a stall
+  for (int i = 0; i < 1000; ++i) {
+    if (!sim.alloc(48 + (i % 3) * 8, 16)) {
+      return false;
+    }
+    if ((i % 4) == 3) {
+      sim.retireAll();
+    }
+  }
+  if ((sim.grows_ != 0) || (sim.stalls_ != 0)) {
+    LogPrintfError("The wrap grew the pool %u times and stalled %u times", sim.grows_,
+                   sim.stalls_);
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testGrowInFlight() {
+  SimBackend sim(16 * 256, 16 * 4096);
+  // GPU doesn't retire anything, hence the wrap to a busy chunk must grow the pool
+  for (int i = 0; i < 16 * 4 + 1; ++i) {
+    if (!sim.alloc(64, 16)) {
+      return false;
+    }
+  }
+  if ((sim.grows_ != 1) || (sim.ring_.size() != 16 * 512) || (sim.stalls_ != 0)) {
+    LogPrintfError("Unexpected pool state: size %u, grows %u, stalls %u", sim.ring_.size(),
+                   sim.grows_, sim.stalls_);
+    return false;
+  }
+
+  // The arguments, which don't fit into a chunk, grow the pool to fit
+  if (!sim.alloc(1000, 64) || (sim.ring_.chunkSize() < 1064) || (sim.grows_ != 2)) {
+    LogError("The pool wasn't grown for big arguments");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testStallAtLimit() {
+  SimBackend sim(16 * 256, 16 * 256);
+  // The pool can't grow, hence runtime has to wait for GPU on every wrap
+  for (int i = 0; i < 16 * 4 * 3; ++i) {
+    if (!sim.alloc(64, 16)) {
+      return false;
+    }
+  }
+  if ((sim.grows_ != 0) || (sim.stalls_ == 0)) {
+    LogPrintfError("The full pool grew %u times and stalled %u times", sim.grows_,
+                   sim.stalls_);
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  bool ret = testWrap();
+  printf("%s: testWrap() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testGrowInFlight();
+    printf("%s: testGrowInFlight() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testStallAtLimit();
+    printf("%s: testStallAtLimit() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
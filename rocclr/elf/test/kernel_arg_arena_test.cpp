@@ -0,0 +1,149 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <vdi_common.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <platform/kernelargarena.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <thread>
+#include <vector>
+
+using amd::KernelArgArena;
+
+// Counts the heap allocations of the threads, which enabled the counting
+static std::atomic<uint64_t> numHeapAllocs(0);
+static thread_local bool countHeapAllocs = false;
+
+void* operator new(size_t size) {
+  if (countHeapAllocs) {
+    ++numHeapAllocs;
+  }
+  void* ptr = malloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+
+//! Captures and releases the arguments like the commands do: a window of commands is in flight
+static bool captureLoop(size_t iterations, std::vector<address>& window, size_t argSize) {
+  for (size_t i = 0; i < iterations; ++i) {
+    address& slot = window[i % window.size()];
+    KernelArgArena::deallocate(slot);
+    slot = KernelArgArena::allocate(argSize);
+    if (slot == nullptr) {
+      LogError("The arena failed an allocation");
+      return false;
+    }
+    memset(slot, static_cast<int>(i), argSize);
+  }
+  for (auto& mem : window) {
+    KernelArgArena::deallocate(mem);
+    mem = nullptr;
+  }
+  return true;
+}
+
+bool testSteadyState() {
+  // Warm up the thread page and the free list
+  std::vector<address> window(256, nullptr);
+  if (!captureLoop(10000, window, 200)) {
+    return false;
+  }
+  const uint64_t pages = KernelArgArena::numPageAllocs();
+  countHeapAllocs = true;
+  const bool ret = captureLoop(1000000, window, 200);
+  countHeapAllocs = false;
+  if (!ret) {
+    return false;
+  }
+  if ((KernelArgArena::numPageAllocs() != pages) || (numHeapAllocs != 0)) {
+    LogPrintfError("Repeated captures allocated %lu pages and %lu heap blocks",
+                   KernelArgArena::numPageAllocs() - pages, numHeapAllocs.load());
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testCrossThreadRelease() {
+  // The commands are captured on the application thread and released on another thread
+  constexpr size_t kBatch = 1024;
+  std::vector<address> batch(kBatch, nullptr);
+  auto produce = [&batch]() {
+    for (auto& mem : batch) {
+      mem = KernelArgArena::allocate(120);
+    }
+  };
+  auto release = [&batch]() {
+    amd::Thread* thread = amd::Thread::current();
+    if (!VDI_CHECK_THREAD(thread)) {
+      return;
+    }
+    for (auto& mem : batch) {
+      KernelArgArena::deallocate(mem);
+      mem = nullptr;
+    }
+  };
+
+  for (int i = 0; i < 4; ++i) {
+    produce();
+    std::thread(release).join();
+  }
+  const uint64_t pages = KernelArgArena::numPageAllocs();
+  for (int i = 0; i < 100; ++i) {
+    produce();
+    std::thread(release).join();
+  }
+  if (KernelArgArena::numPageAllocs() != pages) {
+    LogPrintfError("The pages released by another thread weren't reused, %lu new pages",
+                   KernelArgArena::numPageAllocs() - pages);
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread)) {
+    printf("%s: Thread initialization failed!\n", __func__);
+    return 1;
+  }
+  bool ret = testSteadyState();
+  printf("%s: testSteadyState() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testCrossThreadRelease();
+    printf("%s: testCrossThreadRelease() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
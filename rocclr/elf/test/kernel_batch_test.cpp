@@ -0,0 +1,153 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "stub_device.hpp"
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <platform/kernel.hpp>
+#include <platform/program.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// Kernels per launch group
+static constexpr size_t kKernels = 16;
+
+//! Launches kKernels dispatches in each of the groups, one by one or as a batch, and returns
+//! the host time per kernel in ns
+static double launchKernels(amd::HostQueue& queue, amd::Kernel& kernel, size_t groups,
+                            bool batch) {
+  const size_t globalSize[1] = {64};
+  const size_t localSize[1] = {64};
+  amd::NDRangeContainer sizes(1, nullptr, globalSize, localSize);
+
+  std::vector<amd::NDRangeKernelCommand*> commands;
+  commands.reserve(kKernels);
+  uint64_t start = amd::Os::timeNanos();
+  for (size_t g = 0; g < groups; ++g) {
+    if (batch) {
+      commands.clear();
+      for (size_t i = 0; i < kKernels; ++i) {
+        auto command = new amd::NDRangeKernelCommand(queue, amd::Command::EventWaitList{},
+                                                     kernel, sizes);
+        command->captureAndValidate();
+        commands.push_back(command);
+      }
+      amd::Command* command =
+          new amd::KernelBatchCommand(queue, amd::Command::EventWaitList{}, commands);
+      command->enqueue();
+      command->release();
+    } else {
+      for (size_t i = 0; i < kKernels; ++i) {
+        auto command = new amd::NDRangeKernelCommand(queue, amd::Command::EventWaitList{},
+                                                     kernel, sizes);
+        command->captureAndValidate();
+        command->enqueue();
+        command->release();
+      }
+    }
+    queue.finish();
+  }
+  return static_cast<double>(amd::Os::timeNanos() - start) / (groups * kKernels);
+}
+
+bool testLaunchBatch(amd::HostQueue& queue, amd::Kernel& kernel) {
+  constexpr size_t kGroups = 100;
+  auto& vdev = static_cast<StubVirtualDevice&>(*queue.vdev());
+  uint64_t dispatches = vdev.dispatches();
+  uint64_t doorbells = vdev.doorbells();
+
+  launchKernels(queue, kernel, kGroups, false);
+  if ((vdev.dispatches() - dispatches != kGroups * kKernels) ||
+      (vdev.doorbells() - doorbells != kGroups * kKernels)) {
+    LogPrintfError("Single launches: %lu dispatches, %lu doorbells",
+                   vdev.dispatches() - dispatches, vdev.doorbells() - doorbells);
+    return false;
+  }
+
+  // The batch submits all dispatches with a single doorbell
+  dispatches = vdev.dispatches();
+  doorbells = vdev.doorbells();
+  launchKernels(queue, kernel, kGroups, true);
+  if ((vdev.dispatches() - dispatches != kGroups * kKernels) ||
+      (vdev.doorbells() - doorbells != kGroups)) {
+    LogPrintfError("Batched launches: %lu dispatches, %lu doorbells",
+                   vdev.dispatches() - dispatches, vdev.doorbells() - doorbells);
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Measures the host cost per kernel of the single and the batched launches
+void benchmark(amd::HostQueue& queue, amd::Kernel& kernel) {
+  constexpr size_t kGroups = 20000;
+  double single = launchKernels(queue, kernel, kGroups, false);
+  double batched = launchKernels(queue, kernel, kGroups, true);
+  printf("%s: %zu kernels per launch, single %.1f ns per kernel, batch %.1f ns per kernel\n",
+         __func__, kKernels, single, batched);
+}
+
+int main(int argc, char** argv) {
+  amd::Flag::init();
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread)) {
+    printf("%s: Couldn't create the host thread!\n", __func__);
+    return 1;
+  }
+  // HIP submits from the caller's thread
+  AMD_DIRECT_DISPATCH = true;
+
+  StubDevice* dev = new StubDevice();
+  if (!dev->create()) {
+    printf("%s: Couldn't create the stub device!\n", __func__);
+    return 1;
+  }
+  amd::Context* context = new amd::Context({dev}, amd::Context::Info());
+  amd::HostQueue* queue = new amd::HostQueue(*context, *dev, 0);
+  if (queue->vdev() == nullptr) {
+    printf("%s: Couldn't create the queue!\n", __func__);
+    return 1;
+  }
+  // The kernel has no arguments, since the stub device never executes it
+  amd::Program* program = new amd::Program(*context);
+  StubProgram devProgram(*dev, *program);
+  StubKernel devKernel(*dev, devProgram);
+  amd::Symbol symbol;
+  symbol.setDeviceKernel(*dev, &devKernel);
+  amd::Kernel* kernel = new amd::Kernel(*program, symbol, "stub");
+
+  bool ret = true;
+  if ((argc > 1) && (strcmp(argv[1], "--benchmark") == 0)) {
+    benchmark(*queue, *kernel);
+  } else {
+    ret = testLaunchBatch(*queue, *kernel);
+    printf("%s: testLaunchBatch() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+
+  kernel->release();
+  program->release();
+  queue->release();
+  context->release();
+  dev->release();
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "test_device.hpp"
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <cstdio>
+
+// Allocation unit of the test blocks, a multiple of the device allocation granularity
+static constexpr size_t kUnit = 2 * Mi;
+
+bool testFindAdd(roc::Device& dev) {
+  roc::Device::MemoryCache cache(dev, 8 * kUnit);
+  size_t p2pDevices = 0;
+  if (cache.find(kUnit, &p2pDevices) != nullptr) {
+    LogError("An empty cache returned a block");
+    return false;
+  }
+
+  void* a = dev.deviceLocalAlloc(kUnit);
+  void* b = dev.deviceLocalAlloc(2 * kUnit);
+  void* c = dev.deviceLocalAlloc(kUnit);
+  if ((a == nullptr) || (b == nullptr) || (c == nullptr)) {
+    LogError("Device memory allocation failed");
+    return false;
+  }
+  if (!cache.add(a, kUnit, 0) || !cache.add(b, 2 * kUnit, 1) || !cache.add(c, kUnit, 2)) {
+    LogError("A block within the limit wasn't cached");
+    return false;
+  }
+  if (cache.cacheSize() != 4 * kUnit) {
+    LogPrintfError("Cache size 0x%zx, expected 0x%zx", cache.cacheSize(), 4 * kUnit);
+    return false;
+  }
+
+  // The most recently freed block of the size class comes first
+  void* ptr = cache.find(kUnit, &p2pDevices);
+  if ((ptr != c) || (p2pDevices != 2)) {
+    LogError("The last freed block wasn't reused first");
+    return false;
+  }
+  ptr = cache.find(kUnit, &p2pDevices);
+  if ((ptr != a) || (p2pDevices != 0)) {
+    LogError("The older block of the size class wasn't found");
+    return false;
+  }
+  if (cache.find(kUnit, &p2pDevices) != nullptr) {
+    LogError("A block of another size class was returned");
+    return false;
+  }
+  if (cache.cacheSize() != 2 * kUnit) {
+    LogPrintfError("Cache size 0x%zx, expected 0x%zx", cache.cacheSize(), 2 * kUnit);
+    return false;
+  }
+  dev.memFree(a, kUnit);
+  dev.memFree(c, kUnit);
+
+  // The destructor releases the block of the other size class
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testLimit(roc::Device& dev) {
+  roc::Device::MemoryCache cache(dev, 4 * kUnit);
+  void* big = dev.deviceLocalAlloc(5 * kUnit);
+  if (big == nullptr) {
+    LogError("Device memory allocation failed");
+    return false;
+  }
+  if (cache.add(big, 5 * kUnit, 0)) {
+    LogError("A block above the cache limit was cached");
+    return false;
+  }
+  dev.memFree(big, 5 * kUnit);
+
+  void* x = dev.deviceLocalAlloc(2 * kUnit);
+  void* y = dev.deviceLocalAlloc(2 * kUnit);
+  void* z = dev.deviceLocalAlloc(kUnit);
+  if ((x == nullptr) || (y == nullptr) || (z == nullptr)) {
+    LogError("Device memory allocation failed");
+    return false;
+  }
+  cache.add(x, 2 * kUnit, 0);
+  cache.add(y, 2 * kUnit, 0);
+  // The new block doesn't fit, hence the oldest block must be released
+  if (!cache.add(z, kUnit, 0) || (cache.cacheSize() != 3 * kUnit)) {
+    LogPrintfError("Cache size 0x%zx after the trim, expected 0x%zx", cache.cacheSize(),
+                   3 * kUnit);
+    return false;
+  }
+  size_t p2pDevices = 0;
+  void* ptr = cache.find(2 * kUnit, &p2pDevices);
+  if (ptr != y) {
+    LogError("The trim didn't release the oldest block");
+    return false;
+  }
+  dev.memFree(y, 2 * kUnit);
+
+  if (!cache.trim() || (cache.cacheSize() != 0)) {
+    LogError("The full trim didn't release the cache");
+    return false;
+  }
+  if (cache.trim()) {
+    LogError("The trim of an empty cache reported a release");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  roc::Device* dev = initRocDevice();
+  if (dev == nullptr) {
+    printf("%s: No ROCm GPU device, skipped!\n", __func__);
+    return kTestSkipped;
+  }
+  bool ret = testFindAdd(*dev);
+  printf("%s: testFindAdd() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testLimit(*dev);
+    printf("%s: testLimit() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <device/devmetakey.hpp>
+
+#include <cstdio>
+#include <string>
+
+bool testLookup() {
+  const MetaKeyTable<int> table = {
+      {".name", 0}, {".type_name", 1}, {".size", 2}, {".align", 3}, {".value_kind", 4}};
+  const char* keys[] = {".name", ".type_name", ".size", ".align", ".value_kind"};
+  for (int i = 0; i < 5; ++i) {
+    auto entry = table.find(keys[i]);
+    if ((entry == nullptr) || (entry->value_ != i) || (entry->key_ != keys[i])) {
+      LogPrintfError("The key %s wasn't found", keys[i]);
+      return false;
+    }
+  }
+
+  // The prefixes, extensions and the keys of another case must not match
+  const char* unknown[] = {"", ".nam", ".names", ".Name", "name", ".size "};
+  for (const char* key : unknown) {
+    if (table.find(key) != nullptr) {
+      LogPrintfError("The unknown key \"%s\" was found", key);
+      return false;
+    }
+  }
+
+  // The lookup doesn't require a null terminated key
+  const std::string buf = ".size.align";
+  auto entry = table.find(std::string_view(buf.data(), 5));
+  if ((entry == nullptr) || (entry->value_ != 2)) {
+    LogError("The key in a larger buffer wasn't found");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testCollisions() {
+  // Similar keys share the slots after the hash mask, hence the lookup must probe
+  const MetaKeyTable<int> table = {
+      {".a", 0},  {".b", 1},  {".c", 2},  {".d", 3},  {".e", 4},  {".f", 5},  {".g", 6},
+      {".h", 7},  {".i", 8},  {".j", 9},  {".k", 10}, {".l", 11}, {".m", 12}, {".n", 13},
+      {".o", 14}, {".p", 15}, {".q", 16}, {".r", 17}, {".s", 18}, {".t", 19}, {".u", 20},
+      {".aa", 21}, {".ab", 22}, {".ba", 23}, {".bb", 24}};
+  const char* keys[] = {".a", ".b", ".c", ".d", ".e", ".f", ".g", ".h", ".i",
+                        ".j", ".k", ".l", ".m", ".n", ".o", ".p", ".q", ".r",
+                        ".s", ".t", ".u", ".aa", ".ab", ".ba", ".bb"};
+  for (int i = 0; i < 25; ++i) {
+    auto entry = table.find(keys[i]);
+    if ((entry == nullptr) || (entry->value_ != i)) {
+      LogPrintfError("The key %s wasn't found", keys[i]);
+      return false;
+    }
+  }
+  const char* unknown[] = {".v", ".w", ".x", ".y", ".z", ".ac", ".bc", "."};
+  for (const char* key : unknown) {
+    if (table.find(key) != nullptr) {
+      LogPrintfError("The unknown key \"%s\" was found", key);
+      return false;
+    }
+  }
+
+  const MetaKeyTable<int> single = {{"only", 7}};
+  auto entry = single.find("only");
+  if ((entry == nullptr) || (entry->value_ != 7) || (single.find("other") != nullptr)) {
+    LogError("The lookup in a single entry table failed");
+    return false;
+  }
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  bool ret = testLookup();
+  printf("%s: testLookup() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testCollisions();
+    printf("%s: testCollisions() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
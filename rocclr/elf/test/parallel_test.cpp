@@ -0,0 +1,140 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <utils/parallel.hpp>
+#include <vdi_common.hpp>
+#include <thread/thread.hpp>
+#include <thread/monitor.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+// Mock of a GPU agent, which takes a different time to initialize and may fail
+struct MockAgent {
+  size_t id_;
+  uint delayUs_;
+  bool fail_;
+};
+
+struct MockDevice {
+  size_t agentId_;
+};
+
+static MockDevice* createMockDevice(const MockAgent& agent) {
+  std::this_thread::sleep_for(std::chrono::microseconds(agent.delayUs_));
+  // The device constructors take runtime locks, which require a registered thread
+  amd::Thread* thread = amd::Thread::current();
+  if ((thread == nullptr) || !thread->isHostThread()) {
+    return nullptr;
+  }
+  static amd::Monitor lock("Mock device lock");
+  amd::ScopedLock sl(lock);
+  return agent.fail_ ? nullptr : new MockDevice{agent.id_};
+}
+
+// The devices are returned in the agent order, independent of the completion order,
+// and a failed agent leaves an empty slot
+bool testOrderAndErrors() {
+  std::vector<MockAgent> agents;
+  for (size_t i = 0; i < 32; ++i) {
+    // The earlier agents are the slower ones, so they complete last
+    agents.push_back({i, static_cast<uint>((32 - i) * 200), (i % 7) == 3});
+  }
+  auto devices = amd::parallelCreate<MockDevice>(
+      agents.size(), 8, [&agents](size_t idx) { return createMockDevice(agents[idx]); });
+  if (devices.size() != agents.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < agents.size(); ++i) {
+    if (agents[i].fail_ != (devices[i] == nullptr)) {
+      LogPrintfError("%s: Agent %zu failure isn't reported", __func__, i);
+      return false;
+    }
+    if (devices[i] && (devices[i]->agentId_ != i)) {
+      LogPrintfError("%s: Device %zu created for agent %zu", __func__, i, devices[i]->agentId_);
+      return false;
+    }
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// The repeated calls reuse a bounded set of the workers
+bool testWorkerReuse() {
+  std::mutex lock;
+  std::set<std::thread::id> threads;
+  for (int call = 0; call < 200; ++call) {
+    amd::parallelFor(64, 8, 1, [&](size_t) {
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+      std::lock_guard<std::mutex> guard(lock);
+      threads.insert(std::this_thread::get_id());
+    });
+  }
+  // The caller and up to the hardware concurrency workers
+  const size_t maxThreads = std::max<uint>(std::thread::hardware_concurrency(), 1);
+  if (threads.size() > maxThreads) {
+    LogPrintfError("%s: %zu threads for %zu cores", __func__, threads.size(), maxThreads);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded, %zu threads", __func__, threads.size());
+  return true;
+}
+
+// A nested call from a worker completes, even if all workers are busy
+bool testNested() {
+  std::atomic<size_t> items{0};
+  amd::parallelFor(16, 16, 1, [&](size_t) {
+    amd::parallelFor(16, 16, 1, [&](size_t) { ++items; });
+  });
+  if (items != 16 * 16) {
+    LogPrintfError("%s: %zu items instead of %d", __func__, items.load(), 16 * 16);
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  // The caller runs the items too, hence it's registered as an application thread
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread)) {
+    return 1;
+  }
+  bool ret = testOrderAndErrors();
+  printf("%s: testOrderAndErrors() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testWorkerReuse();
+    printf("%s: testWorkerReuse() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testNested();
+    printf("%s: testNested() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,274 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "stub_device.hpp"
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <platform/program.hpp>
+#include <utils/options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// The number of the source compilations and of the code object links
+static std::atomic<uint> numCompiles{0};
+static std::atomic<uint> numLinks{0};
+
+//! Device program with a stub compiler. The compilation is counted and the link produces an
+//! empty ELF code object, which the other devices load
+class CompilingProgram : public StubProgram {
+ public:
+  CompilingProgram(amd::Device& device, amd::Program& owner) : StubProgram(device, owner) {
+    isLC_ = 1;
+  }
+
+ protected:
+  bool compileImpl(const std::string& sourceCode, const std::vector<const std::string*>& headers,
+                   const char** headerIncludeNames, amd::option::Options* options,
+                   const std::vector<std::string>& preCompiledHeaders) override {
+    ++numCompiles;
+    if (sourceCode.find("error") != std::string::npos) {
+      buildLog_ += "error: stub compiler failure\n";
+      return false;
+    }
+    return true;
+  }
+  bool linkImpl(amd::option::Options* options) override {
+    ++numLinks;
+    if (binary().first != nullptr) {
+      // The code object of another device was loaded
+      return true;
+    }
+    return clBinary()->createElfBinary(false, TYPE_EXECUTABLE);
+  }
+};
+
+//! Stub device on the LC path, which creates the compiling programs
+class CompilingDevice : public StubDevice {
+ public:
+  bool create(const amd::Isa& isa) {
+    if (!amd::Device::create(isa)) {
+      return false;
+    }
+    settings_ = new device::Settings();
+    if (settings_ == nullptr) {
+      return false;
+    }
+    settings_->useLightning_ = true;
+    info_.type_ = CL_DEVICE_TYPE_GPU;
+    info_.available_ = true;
+    return true;
+  }
+  device::Program* createProgram(amd::Program& owner,
+                                 amd::option::Options* options = nullptr) override {
+    return new CompilingProgram(*this, owner);
+  }
+};
+
+// Builds the source for the devices and checks, that every device program has the status
+// of the build result
+static bool buildProgram(amd::Context& context, const std::vector<amd::Device*>& devices,
+                         const char* source, int32_t* result) {
+  amd::Program* program = new amd::Program(context, source, amd::Program::OpenCL_C);
+  *result = program->build(devices, "", nullptr, nullptr, false);
+  const int32_t status = (*result == CL_SUCCESS) ? CL_BUILD_SUCCESS : CL_BUILD_ERROR;
+  bool ret = true;
+  for (auto device : devices) {
+    const device::Program* devProgram = program->getDeviceProgram(*device);
+    if ((devProgram == nullptr) || (devProgram->buildStatus() != status)) {
+      LogPrintfError("A device program has a wrong build status, build result %d", *result);
+      ret = false;
+    }
+  }
+  program->release();
+  return ret;
+}
+
+// The devices with the same ISA compile the source once, every device links
+bool testSharedBuild(amd::Context& context, const std::vector<amd::Device*>& devices) {
+  numCompiles = 0;
+  numLinks = 0;
+  int32_t result = CL_SUCCESS;
+  if (!buildProgram(context, devices, "kernel void k() {}", &result) || (result != CL_SUCCESS) || (numCompiles != 1) || (numLinks != devices.size())) {
+    LogPrintfError("%s: result %d, %u compiles, %u links for %zu devices", __func__, result,
+                   numCompiles.load(), numLinks.load(), devices.size());
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Every ISA compiles the source once
+bool testDistinctIsas(amd::Context& context, const std::vector<amd::Device*>& devices) {
+  numCompiles = 0;
+  numLinks = 0;
+  int32_t result = CL_SUCCESS;
+  if (!buildProgram(context, devices, "kernel void k() {}", &result) || (result != CL_SUCCESS) ||
+      (numCompiles != 2) || (numLinks != devices.size())) {
+    LogPrintfError("%s: result %d, %u compiles, %u links for 2 ISAs", __func__, result,
+                   numCompiles.load(), numLinks.load());
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// A rebuild of the program compiles again, the shared code objects of the previous build
+// are dropped
+bool testRebuild(amd::Context& context, const std::vector<amd::Device*>& devices) {
+  amd::Program* program = new amd::Program(context, "kernel void k() {}", amd::Program::OpenCL_C);
+  numCompiles = 0;
+  int32_t result = program->build(devices, "", nullptr, nullptr, false);
+  if (result == CL_SUCCESS) {
+    result = program->build(devices, "-cl-fast-relaxed-math", nullptr, nullptr, false);
+  }
+  program->release();
+  if ((result != CL_SUCCESS) || (numCompiles != 2)) {
+    LogPrintfError("%s: result %d, %u compiles for 2 builds", __func__, result,
+                   numCompiles.load());
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// The blit programs of the devices with the same ISA compile the blit source once. A prebuilt
+// code object from GPU_BLIT_CODE_OBJECT_PATH skips the compilation
+bool testBlitPrograms(amd::Context& context, const std::vector<amd::Device*>& devices) {
+  numCompiles = 0;
+  std::vector<amd::Device::BlitProgram*> blitPrograms;
+  bool ret = true;
+  for (auto device : devices) {
+    blitPrograms.push_back(new amd::Device::BlitProgram(&context));
+    ret &= blitPrograms.back()->create(device, "", "");
+  }
+  if (!ret || (numCompiles != 2)) {
+    LogPrintfError("%s: %u compiles for 2 ISAs", __func__, numCompiles.load());
+    ret = false;
+  }
+
+  // Save the code object of the first ISA as a prebuilt one for a device of the third ISA
+  const amd::Isa& isa = amd::Isa::begin()[2];
+  std::string target(isa.targetId());
+  std::replace(target.begin(), target.end(), ':', '_');
+  const std::string fileName = amd::Os::getTempPath() + amd::Os::fileSeparator() +
+                               "ocl_blit_" + target + ".co";
+  if (ret) {
+    const device::Program::binary_t code =
+        blitPrograms[0]->program_->getDeviceProgram(*devices[0])->binary();
+    std::ofstream(fileName, std::ios::binary)
+        .write(reinterpret_cast<const char*>(code.first), code.second);
+  }
+  for (auto blitProgram : blitPrograms) {
+    delete blitProgram;
+  }
+
+  CompilingDevice* dev = new CompilingDevice();
+  if (ret && dev->create(isa)) {
+    const std::string path = amd::Os::getTempPath();
+    GPU_BLIT_CODE_OBJECT_PATH = path.c_str();
+    amd::Context* prebuiltContext = new amd::Context({dev}, amd::Context::Info());
+    amd::Device::BlitProgram* blitProgram = new amd::Device::BlitProgram(prebuiltContext);
+    numCompiles = 0;
+    if (!blitProgram->create(dev, "", "") || (numCompiles != 0)) {
+      LogPrintfError("%s: %u compiles with a prebuilt code object", __func__,
+                     numCompiles.load());
+      ret = false;
+    }
+    GPU_BLIT_CODE_OBJECT_PATH = "";
+    delete blitProgram;
+    prebuiltContext->release();
+  }
+  dev->release();
+  amd::Os::unlink(fileName);
+  if (ret) {
+    LogPrintfInfo("%s: Succeeded", __func__);
+  }
+  return ret;
+}
+
+// A failed build of the first device is reported by every device, they compile themselves.
+// The failures of several devices are reported as CL_INVALID_OPERATION
+bool testFailedBuild(amd::Context& context, const std::vector<amd::Device*>& devices) {
+  numCompiles = 0;
+  int32_t result = CL_SUCCESS;
+  if (!buildProgram(context, devices, "kernel void k() { error }", &result) ||
+      (result != CL_INVALID_OPERATION) || (numCompiles != devices.size())) {
+    LogPrintfError("%s: result %d, %u compiles for %zu devices", __func__, result,
+                   numCompiles.load(), devices.size());
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  // The build options are parsed with the option tables, as the runtime init does
+  if (!amd::Flag::init() || !amd::option::init()) {
+    printf("%s: Couldn't init the options!\n", __func__);
+    return 1;
+  }
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread)) {
+    printf("%s: Couldn't create the host thread!\n", __func__);
+    return 1;
+  }
+
+  // Four devices of the first ISA and two devices of the second one
+  std::vector<amd::Device*> devices;
+  for (int i = 0; i < 6; ++i) {
+    CompilingDevice* dev = new CompilingDevice();
+    if (!dev->create(amd::Isa::begin()[(i < 4) ? 0 : 1])) {
+      printf("%s: Couldn't create the stub device!\n", __func__);
+      return 1;
+    }
+    devices.push_back(dev);
+  }
+  const std::vector<amd::Device*> sameIsa(devices.begin(), devices.begin() + 4);
+  amd::Context* context = new amd::Context(devices, amd::Context::Info());
+
+  bool ret = testSharedBuild(*context, sameIsa);
+  printf("%s: testSharedBuild() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testDistinctIsas(*context, devices);
+    printf("%s: testDistinctIsas() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testRebuild(*context, sameIsa);
+    printf("%s: testRebuild() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testBlitPrograms(*context, devices);
+    printf("%s: testBlitPrograms() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testFailedBuild(*context, sameIsa);
+    printf("%s: testFailedBuild() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+
+  context->release();
+  for (auto dev : devices) {
+    dev->release();
+  }
+  return ret ? 0 : 1;
+}
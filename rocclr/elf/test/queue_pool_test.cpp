@@ -0,0 +1,216 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+#include <device/rocm/rocqueuepool.hpp>
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+// Mock HW queue of the pool, only the address identifies it
+struct MockQueue {
+  int id_;
+};
+
+struct MockQueueInfo {
+  int refCount;
+  uint64_t load_;
+};
+typedef std::map<MockQueue*, MockQueueInfo> MockPool;
+
+// A stream and its averaged load, accounted on the queue, similar to VirtualGPU
+struct MockStream {
+  MockQueue* queue_;
+  uint64_t load_;
+  uint64_t packets_;  //!< Packets submitted between two synchronization points
+};
+
+// Acquires a queue for a new stream. A pool below maxQueues creates a new queue
+static MockQueue* acquire(MockPool& pool, std::vector<MockQueue>& queues, size_t maxQueues) {
+  if (pool.size() < maxQueues) {
+    MockQueue* queue = &queues[pool.size()];
+    pool[queue] = {1, 0};
+    return queue;
+  }
+  auto it = roc::leastLoadedQueue(pool);
+  it->second.refCount++;
+  return it->first;
+}
+
+// Runs a synchronization point of every stream, returns the number of migrations
+static uint32_t sync(MockPool& pool, std::vector<MockStream>& streams) {
+  uint32_t migrations = 0;
+  for (auto& stream : streams) {
+    const uint64_t load = roc::averageQueueLoad(stream.load_, stream.packets_);
+    if (load == stream.load_) {
+      continue;
+    }
+    auto current = pool.find(stream.queue_);
+    auto target = roc::rebalanceQueueLoad(pool, current, stream.load_, load);
+    stream.load_ = load;
+    if (target != current) {
+      stream.queue_ = target->first;
+      ++migrations;
+    }
+  }
+  return migrations;
+}
+
+// Checks that the pool loads and users match the streams
+static bool checkPool(const MockPool& pool, const std::vector<MockStream>& streams) {
+  for (const auto& it : pool) {
+    int refCount = 0;
+    uint64_t load = 0;
+    for (const auto& stream : streams) {
+      if (stream.queue_ == it.first) {
+        ++refCount;
+        load += stream.load_;
+      }
+    }
+    if ((refCount != it.second.refCount) || (load != it.second.load_)) {
+      LogPrintfError("Queue %d has %d users and load %llu, expected %d and %llu", it.first->id_,
+                     it.second.refCount, static_cast<unsigned long long>(it.second.load_),
+                     refCount, static_cast<unsigned long long>(load));
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testNewStreams() {
+  std::vector<MockQueue> queues = {{0}, {1}, {2}};
+  MockPool pool;
+  std::vector<MockStream> streams;
+  for (int i = 0; i < 3; ++i) {
+    streams.push_back({acquire(pool, queues, 3), 0, 0});
+  }
+  // The first stream is busy, so the next streams go to the idle queues with fewer users
+  streams[0].packets_ = 100;
+  sync(pool, streams);
+  streams[0].packets_ = 0;
+  for (int i = 0; i < 4; ++i) {
+    streams.push_back({acquire(pool, queues, 3), 0, 0});
+    if (streams.back().queue_ == &queues[0]) {
+      LogError("A new stream was mapped to the busy queue");
+      return false;
+    }
+  }
+  if ((pool[&queues[1]].refCount != 3) || (pool[&queues[2]].refCount != 3)) {
+    LogError("The new streams aren't spread by the number of users");
+    return false;
+  }
+  if (!checkPool(pool, streams)) {
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testMigration() {
+  std::vector<MockQueue> queues = {{0}, {1}};
+  MockPool pool;
+  // Two busy streams share queue 0, two idle streams share queue 1
+  std::vector<MockStream> streams = {
+      {&queues[0], 0, 100}, {&queues[0], 0, 100}, {&queues[1], 0, 0}, {&queues[1], 0, 0}};
+  pool[&queues[0]] = {2, 0};
+  pool[&queues[1]] = {2, 0};
+
+  uint32_t migrations = 0;
+  for (int round = 0; round < 1000; ++round) {
+    migrations += sync(pool, streams);
+    if (!checkPool(pool, streams)) {
+      return false;
+    }
+  }
+  if (migrations != 1) {
+    LogPrintfError("%u migrations, expected one busy stream to move", migrations);
+    return false;
+  }
+  if (streams[0].queue_ == streams[1].queue_) {
+    LogError("The busy streams share a queue");
+    return false;
+  }
+  // The idle streams never move
+  if ((streams[2].queue_ != &queues[1]) || (streams[3].queue_ != &queues[1])) {
+    LogError("An idle stream was migrated");
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testHysteresis() {
+  std::vector<MockQueue> queues = {{0}, {1}};
+  MockPool pool;
+  // Three equally busy streams on two queues can't be balanced, one queue stays with two
+  std::vector<MockStream> streams = {
+      {&queues[0], 0, 100}, {&queues[0], 0, 100}, {&queues[0], 0, 100}};
+  pool[&queues[0]] = {3, 0};
+  pool[&queues[1]] = {0, 0};
+
+  uint32_t migrations = 0;
+  for (int round = 0; round < 1000; ++round) {
+    // Bursts alternate, so the averaged loads fluctuate around the same value
+    for (size_t i = 0; i < streams.size(); ++i) {
+      streams[i].packets_ = ((round + i) % 2 == 0) ? 90 : 110;
+    }
+    migrations += sync(pool, streams);
+    if (!checkPool(pool, streams)) {
+      return false;
+    }
+  }
+  if ((migrations == 0) || (migrations > 2)) {
+    LogPrintfError("%u migrations, the streams bounce between the queues", migrations);
+    return false;
+  }
+  // A stream, which owns its queue, stays on it
+  for (auto& stream : streams) {
+    if (pool[stream.queue_].refCount == 1) {
+      stream.packets_ = 1000;
+      MockQueue* queue = stream.queue_;
+      sync(pool, streams);
+      if (stream.queue_ != queue) {
+        LogError("The owner of a queue was migrated");
+        return false;
+      }
+      break;
+    }
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  bool ret = testNewStreams();
+  printf("%s: testNewStreams() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testMigration();
+    printf("%s: testMigration() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testHysteresis();
+    printf("%s: testHysteresis() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef STUB_DEVICE_HPP_
+#define STUB_DEVICE_HPP_
+
+#include <top.hpp>
+#include <vdi_common.hpp>
+#include <device/device.hpp>
+#include <device/devkernel.hpp>
+#include <device/devprogram.hpp>
+#include <platform/command.hpp>
+#include <platform/commandqueue.hpp>
+#include <platform/context.hpp>
+
+#include <atomic>
+
+//! Virtual device without a HW queue. It counts the submissions and completes the commands
+//! on the markers and flushes, so the host side of the runtime can be measured alone
+class StubVirtualDevice : public device::VirtualDevice {
+ public:
+  explicit StubVirtualDevice(amd::Device& device) : device::VirtualDevice(device) {}
+
+  void submitKernel(amd::NDRangeKernelCommand& cmd) override {
+    dispatches_++;
+    doorbells_++;
+  }
+  void submitKernelBatch(amd::KernelBatchCommand& cmd) override {
+    dispatches_ += cmd.commands().size();
+    doorbells_++;
+  }
+  void submitMarker(amd::Marker& cmd) override { complete(cmd.GetBatchHead()); }
+  void flush(amd::Command* list = nullptr, bool wait = false) override { complete(list); }
+
+  void submitReadMemory(amd::ReadMemoryCommand& cmd) override {}
+  void submitWriteMemory(amd::WriteMemoryCommand& cmd) override {}
+  void submitCopyMemory(amd::CopyMemoryCommand& cmd) override {}
+  void submitCopyMemoryP2P(amd::CopyMemoryP2PCommand& cmd) override {}
+  void submitMapMemory(amd::MapMemoryCommand& cmd) override {}
+  void submitUnmapMemory(amd::UnmapMemoryCommand& cmd) override {}
+  void submitNativeFn(amd::NativeFnCommand& cmd) override {}
+  void submitAccumulate(amd::AccumulateCommand& cmd) override {}
+  void submitExternalSemaphoreCmd(amd::ExternalSemaphoreCmd& cmd) override {}
+  void submitFillMemory(amd::FillMemoryCommand& cmd) override {}
+  void submitMigrateMemObjects(amd::MigrateMemObjectsCommand& cmd) override {}
+  void submitAcquireExtObjects(amd::AcquireExtObjectsCommand& cmd) override {}
+  void submitReleaseExtObjects(amd::ReleaseExtObjectsCommand& cmd) override {}
+  void submitPerfCounter(amd::PerfCounterCommand& cmd) override {}
+  void submitThreadTraceMemObjects(amd::ThreadTraceMemObjectsCommand& cmd) override {}
+  void submitThreadTrace(amd::ThreadTraceCommand& cmd) override {}
+  void submitSvmFreeMemory(amd::SvmFreeMemoryCommand& cmd) override {}
+  void submitSvmCopyMemory(amd::SvmCopyMemoryCommand& cmd) override {}
+  void submitSvmFillMemory(amd::SvmFillMemoryCommand& cmd) override {}
+  void submitSvmMapMemory(amd::SvmMapMemoryCommand& cmd) override {}
+  void submitSvmUnmapMemory(amd::SvmUnmapMemoryCommand& cmd) override {}
+  void submitSignal(amd::SignalCommand& cmd) override {}
+  void submitMakeBuffersResident(amd::MakeBuffersResidentCommand& cmd) override {}
+
+  bool isHandlerPending() const override { return false; }
+  bool isFenceDirty() const override { return false; }
+  bool dispatchAqlPacket(uint8_t* aqlpacket, amd::AccumulateCommand* vcmd = nullptr) override {
+    return true;
+  }
+
+  //! Returns the number of the submitted kernel dispatches
+  uint64_t dispatches() const { return dispatches_; }
+  //! Returns the number of the doorbell rings, one per kernel submission
+  uint64_t doorbells() const { return doorbells_; }
+
+ private:
+  //! Completes the list of the submitted commands, as VirtualGPU::updateCommandsState does
+  static void complete(amd::Command* list) {
+    while (list != nullptr) {
+      amd::Command* next = list->getNext();
+      if (list->status() == CL_SUBMITTED) {
+        list->setStatus(CL_RUNNING);
+        list->setStatus(CL_COMPLETE);
+      }
+      list->release();
+      list = next;
+    }
+  }
+
+  std::atomic<uint64_t> dispatches_{0};  //!< The number of the kernel dispatches
+  std::atomic<uint64_t> doorbells_{0};   //!< The number of the doorbell rings
+};
+
+//! Device without HW. It creates StubVirtualDevice queues and nothing else
+class StubDevice : public amd::Device {
+ public:
+  bool create() {
+    if (!amd::Device::create(*amd::Isa::begin())) {
+      return false;
+    }
+    settings_ = new device::Settings();
+    info_.type_ = CL_DEVICE_TYPE_GPU;
+    info_.available_ = true;
+    return settings_ != nullptr;
+  }
+
+#if defined(WITH_COMPILER_LIB)
+  Compiler* compiler() const override { return nullptr; }
+#endif
+  device::VirtualDevice* createVirtualDevice(amd::CommandQueue* queue = nullptr) override {
+    return new StubVirtualDevice(*this);
+  }
+  device::Program* createProgram(amd::Program& owner,
+                                 amd::option::Options* options = nullptr) override {
+    return nullptr;
+  }
+  device::Memory* createMemory(amd::Memory& owner) const override { return nullptr; }
+  device::Memory* createMemory(size_t size) const override { return nullptr; }
+  bool createSampler(const amd::Sampler&, device::Sampler**) const override { return false; }
+  device::Memory* createView(amd::Memory& owner, const device::Memory& parent) const override {
+    return nullptr;
+  }
+  device::Signal* createSignal() const override { return nullptr; }
+  bool bindExternalDevice(uint flags, void* const pDevice[], void* pContext,
+                          bool validateOnly) override {
+    return false;
+  }
+  bool unbindExternalDevice(uint flags, void* const pDevice[], void* pContext,
+                            bool validateOnly) override {
+    return false;
+  }
+  bool globalFreeMemory(size_t* freeMemory) const override { return false; }
+  bool importExtSemaphore(void** extSemaphore, const amd::Os::FileDesc& handle,
+                          amd::ExternalSemaphoreHandleType sem_handle_type) override {
+    return false;
+  }
+  void DestroyExtSemaphore(void* extSemaphore) override {}
+  void* svmAlloc(amd::Context& context, size_t size, size_t alignment, cl_svm_mem_flags flags,
+                 void* svmPtr) const override {
+    return nullptr;
+  }
+  void svmFree(void* ptr) const override {}
+  void* virtualAlloc(void* addr, size_t size, size_t alignment) override { return nullptr; }
+  bool SetMemAccess(void* va_addr, size_t va_size, VmmAccess access_flags,
+                    size_t count) override {
+    return false;
+  }
+  bool GetMemAccess(void* va_addr, VmmAccess* access_flags_ptr) override { return false; }
+  void virtualFree(void* addr) override {}
+#if defined(__clang__)
+#if __has_feature(address_sanitizer)
+  device::UriLocator* createUriLocator() const override { return nullptr; }
+#endif
+#endif
+};
+
+//! Device program without a binary. It only owns the stub kernels
+class StubProgram : public device::Program {
+ public:
+  StubProgram(amd::Device& device, amd::Program& owner) : device::Program(device, owner) {}
+
+ protected:
+  bool createBinary(amd::option::Options* options) override { return true; }
+  bool saveBinaryAndSetType(type_t type) override { return true; }
+#if defined(WITH_COMPILER_LIB)
+  const aclTargetInfo& info() override { return info_; }
+#endif
+};
+
+//! Device kernel without arguments and code object, which the stub device never executes
+class StubKernel : public device::Kernel {
+ public:
+  StubKernel(const amd::Device& device, const device::Program& program)
+      : device::Kernel(device, "stub", program) {
+    createSignature(parameters_t(), 0, amd::KernelSignature::ABIVersion_2);
+  }
+};
+
+#endif /*STUB_DEVICE_HPP_*/
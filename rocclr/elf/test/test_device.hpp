@@ -0,0 +1,45 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef TEST_DEVICE_HPP_
+#define TEST_DEVICE_HPP_
+
+#include <top.hpp>
+#include <vdi_common.hpp>
+#include <platform/runtime.hpp>
+#include <device/rocm/rocdevice.hpp>
+
+//! ctest reports a test, which exits with this code, as skipped
+constexpr int kTestSkipped = 77;
+
+//! Initializes the runtime and returns the first ROCm GPU device or nullptr
+inline roc::Device* initRocDevice() {
+  amd::Thread* thread = amd::Thread::current();
+  if (!VDI_CHECK_THREAD(thread) || !amd::Runtime::init()) {
+    return nullptr;
+  }
+  const std::vector<amd::Device*>& devices = amd::Device::getDevices(CL_DEVICE_TYPE_GPU, false);
+  if (devices.empty()) {
+    return nullptr;
+  }
+  return static_cast<roc::Device*>(devices[0]);
+}
+
+#endif /*TEST_DEVICE_HPP_*/
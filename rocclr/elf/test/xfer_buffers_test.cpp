@@ -0,0 +1,152 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "test_device.hpp"
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <cstdio>
+#include <set>
+#include <vector>
+
+using roc::Device;
+
+// Size of the test staging buffers
+static constexpr size_t kBufSize = 64 * Ki;
+
+bool testReuse(Device& dev, roc::VirtualGPU& gpu) {
+  Device::XferBuffers pool(dev, kBufSize);
+  if (!pool.create()) {
+    LogError("Couldn't create the transfer buffers");
+    return false;
+  }
+
+  roc::Memory* first = pool.acquire();
+  if (first == nullptr) {
+    LogError("Couldn't acquire the preallocated buffer");
+    return false;
+  }
+  if ((pool.acquiredCount() != 1) || (first->size() < kBufSize)) {
+    LogError("Unexpected state of the acquired buffer");
+    return false;
+  }
+  pool.release(gpu, *first);
+  if (pool.acquiredCount() != 0) {
+    LogError("The released buffer is still counted");
+    return false;
+  }
+
+  // A released buffer must be reused instead of a new allocation
+  roc::Memory* second = pool.acquire();
+  if (second != first) {
+    LogError("The released buffer wasn't reused");
+    return false;
+  }
+  pool.release(gpu, *second);
+
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testOverflow(Device& dev, roc::VirtualGPU& gpu) {
+  Device::XferBuffers pool(dev, kBufSize);
+  if (!pool.create()) {
+    LogError("Couldn't create the transfer buffers");
+    return false;
+  }
+
+  // Acquire more buffers than the slots and the overflow list can keep
+  constexpr size_t kPoolSize =
+      Device::XferBuffers::MaxXferBufListSize + Device::XferBuffers::MaxXferBufOverflowSize;
+  constexpr size_t kCount = 2 * kPoolSize;
+  std::vector<roc::Memory*> buffers;
+  for (size_t i = 0; i < kCount; ++i) {
+    roc::Memory* buf = pool.acquire();
+    if (buf == nullptr) {
+      LogPrintfError("Couldn't acquire the buffer %zu", i);
+      return false;
+    }
+    buffers.push_back(buf);
+  }
+  if (pool.acquiredCount() != kCount) {
+    LogPrintfError("Acquired count %u, expected %zu", pool.acquiredCount(), kCount);
+    return false;
+  }
+  if (std::set<roc::Memory*>(buffers.begin(), buffers.end()).size() != kCount) {
+    LogError("The same buffer was acquired twice");
+    return false;
+  }
+  for (auto buf : buffers) {
+    pool.release(gpu, *buf);
+  }
+
+  // The pool keeps the buffers up to its limit and destroys the rest
+  if (pool.freeCount() != kPoolSize) {
+    LogPrintfError("The pool keeps %zu free buffers, expected %zu", pool.freeCount(), kPoolSize);
+    return false;
+  }
+  buffers.clear();
+  for (size_t i = 0; i < kPoolSize; ++i) {
+    roc::Memory* buf = pool.acquire();
+    if (buf == nullptr) {
+      LogPrintfError("Couldn't acquire the buffer %zu", i);
+      return false;
+    }
+    buffers.push_back(buf);
+  }
+  if (pool.freeCount() != 0) {
+    LogError("The free buffers weren't reused");
+    return false;
+  }
+  for (auto buf : buffers) {
+    pool.release(gpu, *buf);
+  }
+
+  // The idle trim keeps one buffer
+  pool.trim(1);
+  if (pool.freeCount() != 1) {
+    LogPrintfError("The pool keeps %zu free buffers after the trim", pool.freeCount());
+    return false;
+  }
+
+  // The destructor releases all free buffers
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  Device* dev = initRocDevice();
+  if (dev == nullptr) {
+    printf("%s: No ROCm GPU device, skipped!\n", __func__);
+    return kTestSkipped;
+  }
+  roc::VirtualGPU* gpu = dev->xferQueue();
+  if (gpu == nullptr) {
+    printf("%s: No transfer queue, skipped!\n", __func__);
+    return kTestSkipped;
+  }
+  bool ret = testReuse(*dev, *gpu);
+  printf("%s: testReuse() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testOverflow(*dev, *gpu);
+    printf("%s: testOverflow() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
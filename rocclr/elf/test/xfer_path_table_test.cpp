@@ -0,0 +1,161 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc. All Rights Reserved.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include <top.hpp>
+#include <device/rocm/rocdevice.hpp>
+#include <utils/flags.hpp>
+#include <utils/debug.hpp>
+
+#include <cstdio>
+#include <fstream>
+
+typedef roc::Device::XferPathTable XferPathTable;
+
+static constexpr size_t kMinPinnedSize = 64 * Ki;
+static constexpr char kTableFile[] = "xfer_path_table.txt";
+
+bool testBuckets() {
+  const struct {
+    size_t size;
+    uint32_t bucket;
+  } cases[] = {{0, 0}, {1, 0}, {4 * Ki, 0}, {4 * Ki + 1, 1}, {64 * Ki, 4}, {1 * Mi, 8},
+               {2 * Gi, XferPathTable::TotalBuckets - 1},
+               {size_t(64) * Gi, XferPathTable::TotalBuckets - 1}};
+  for (const auto& it : cases) {
+    if (XferPathTable::bucket(it.size) != it.bucket) {
+      LogPrintfError("Size %zu is in bucket %u, expected %u", it.size,
+                     XferPathTable::bucket(it.size), it.bucket);
+      return false;
+    }
+  }
+
+  // Without calibration the table follows the static pinned transfer threshold
+  XferPathTable table(kMinPinnedSize, false);
+  if ((table.select(XferPathTable::Read, 4 * Ki) != XferPathTable::Staged) ||
+      (table.select(XferPathTable::Write, kMinPinnedSize) != XferPathTable::Staged) ||
+      (table.select(XferPathTable::Read, 2 * kMinPinnedSize) != XferPathTable::Pinned)) {
+    LogError("The initial paths don't follow the pinned transfer threshold");
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+// Runs the copies, which the table selects, until the choice is made. Staged copies are faster
+static void calibrate(XferPathTable& table, XferPathTable::Direction dir, size_t size) {
+  for (uint32_t i = 0; i < 2 * XferPathTable::MinSamples; ++i) {
+    const XferPathTable::Path path = table.select(dir, size);
+    table.record(dir, path, size, (path == XferPathTable::Staged) ? size : 10 * size);
+  }
+}
+
+bool testCalibration() {
+  XferPathTable table(kMinPinnedSize, true);
+  // Both paths are measured before the choice
+  uint32_t samples[XferPathTable::TotalPaths] = {};
+  for (uint32_t i = 0; i < 2 * XferPathTable::MinSamples; ++i) {
+    const XferPathTable::Path path = table.select(XferPathTable::Read, 1 * Mi);
+    samples[path]++;
+    table.record(XferPathTable::Read, path, 1 * Mi, (path == XferPathTable::Staged) ? Mi : 10 * Mi);
+  }
+  if ((samples[XferPathTable::Staged] != XferPathTable::MinSamples) ||
+      (samples[XferPathTable::Pinned] != XferPathTable::MinSamples)) {
+    LogPrintfError("Sampled %u staged and %u pinned copies, expected %u of each",
+                   samples[XferPathTable::Staged], samples[XferPathTable::Pinned],
+                   XferPathTable::MinSamples);
+    return false;
+  }
+  if (table.select(XferPathTable::Read, 1 * Mi) != XferPathTable::Staged) {
+    LogError("The faster path wasn't selected");
+    return false;
+  }
+  // The other direction and the other buckets are calibrated separately
+  if (table.select(XferPathTable::Write, 1 * Mi) != XferPathTable::Staged ||
+      table.select(XferPathTable::Write, 1 * Mi) != XferPathTable::Staged) {
+    LogError("The write direction didn't start its own calibration");
+    return false;
+  }
+
+  // The running average follows a change of the copy times
+  for (uint32_t i = 0; i < XferPathTable::MaxWindow; ++i) {
+    table.record(XferPathTable::Read, XferPathTable::Staged, 1 * Mi, 100 * Mi);
+  }
+  if (table.select(XferPathTable::Read, 1 * Mi) != XferPathTable::Pinned) {
+    LogError("The table didn't switch to the faster path after the slowdown");
+    return false;
+  }
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+bool testLoadSave() {
+  XferPathTable calibrated(kMinPinnedSize, true);
+  calibrate(calibrated, XferPathTable::Read, 1 * Mi);
+  if (!calibrated.save(kTableFile)) {
+    LogError("The table wasn't saved");
+    return false;
+  }
+
+  // The loaded buckets are fixed, so they aren't measured and don't change
+  XferPathTable loaded(kMinPinnedSize, true);
+  if (!loaded.load(kTableFile)) {
+    LogError("The saved table wasn't loaded");
+    return false;
+  }
+  for (uint32_t i = 0; i < XferPathTable::MaxWindow; ++i) {
+    if (loaded.select(XferPathTable::Read, 1 * Mi) != XferPathTable::Staged) {
+      LogError("The loaded path wasn't used");
+      return false;
+    }
+    loaded.record(XferPathTable::Read, XferPathTable::Staged, 1 * Mi, 100 * Mi);
+  }
+  if (loaded.select(XferPathTable::Write, 2 * Mi) != XferPathTable::Pinned) {
+    LogError("The loaded default path doesn't match the saved table");
+    return false;
+  }
+
+  {
+    std::ofstream file(kTableFile, std::ios::trunc);
+    file << "read 4096 dma" << std::endl;
+  }
+  XferPathTable invalid(kMinPinnedSize, true);
+  if (invalid.load(kTableFile) || invalid.load("missing_xfer_path_table.txt")) {
+    LogError("An invalid or missing table was loaded");
+    return false;
+  }
+  remove(kTableFile);
+  LogPrintfInfo("%s: Succeeded", __func__);
+  return true;
+}
+
+int main() {
+  amd::Flag::init();
+  bool ret = testBuckets();
+  printf("%s: testBuckets() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  if (ret) {
+    ret = testCalibration();
+    printf("%s: testCalibration() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  if (ret) {
+    ret = testLoadSave();
+    printf("%s: testLoadSave() %s!\n", __func__, ret ? "Succeeded" : "Failed");
+  }
+  return ret ? 0 : 1;
+}
@@ -22,8 +22,12 @@
 #include "platform/command.hpp"
 #include "platform/commandqueue.hpp"
 #include "platform/command_utils.hpp"
+#include "os/os.hpp"
 
 #include <atomic>
+#include <string>
+#include <unordered_set>
+#include <vector>
 
 namespace activity_prof {
 
@@ -42,11 +46,233 @@ static inline size_t linearSize(const amd::Coord3D& size3d) {
   return size;
 }
 
+namespace {
+
+//! The interval to deliver the buffered records
+constexpr uint64_t kRefreshIntervalNs = 1000000;
+//! The number of queries of a thread before the enabled operations are refreshed from the tool
+constexpr uint32_t kRefreshQueries = 1024;
+//! The number of records, accumulated per thread before the delivery to the tool
+constexpr size_t kRecordBatchSize = 256;
+
+//! Bitmask of the operations, enabled in the tool. The tool has no way to notify the runtime
+//! about the changes, hence the mask is refreshed after kRefreshQueries queries of a thread,
+//! at the synchronization points and on the registration of a tool
+std::atomic<uint32_t> enabled_mask{0};
+std::atomic<bool> enabled_mask_stale{true};
+thread_local uint32_t queries_until_refresh = 0;
+
+//! The time of the last delivery of the records, buffered by all threads
+std::atomic<uint64_t> flush_all_time{0};
+
+//! Set once the static objects are destroyed. The tool can be unloaded at that point, hence
+//! the records of the exiting threads are dropped
+std::atomic<bool> process_exiting{false};
+struct ExitGuard {
+  ~ExitGuard() { process_exiting.store(true, std::memory_order_relaxed); }
+} exit_guard;
+
+//! Activity record with a copy of the kernel name, since the kernel can be destroyed
+//! before the record reaches the tool
+struct BufferedRecord {
+  activity_record_t record_;
+  std::string kernel_name_;
+};
+
+typedef std::vector<BufferedRecord> Records;
+
+// ================================================================================================
+void DeliverRecords(Records& records) {
+  auto function = report_activity.load(std::memory_order_relaxed);
+  if (function == nullptr) {
+    return;
+  }
+  for (auto& it : records) {
+    if (it.record_.op == OP_ID_DISPATCH) {
+      it.record_.kernel_name = it.kernel_name_.c_str();
+    }
+    function(ACTIVITY_DOMAIN_HIP_OPS, it.record_.op, &it.record_);
+  }
+}
+
+//! Delivers the records of all threads if the last delivery is older than the refresh interval
+void FlushStaleRecords(uint64_t now);
+
+//! Delivers the records of all threads
+void FlushAll();
+
+//! Per-thread buffer of the activity records. Only the owner thread appends records and
+//! a flush from another thread is rare, so the buffer lock is practically uncontended
+class RecordBuffer {
+ public:
+  RecordBuffer();
+  ~RecordBuffer();
+
+  //! Appends a record and delivers the batch if the buffer is full or too old
+  void Append(const activity_record_t& record, const char* kernel_name);
+
+  //! Delivers all buffered records to the tool
+  void Flush();
+
+  //! Moves all buffered records to the batch
+  void Take(Records* batch);
+
+ private:
+  std::mutex lock_;               //!< Serializes the owner with the flushing threads
+  Records records_;               //!< Buffered records
+  uint64_t first_record_ns_ = 0;  //!< The time of the oldest buffered record
+};
+
+//! The list of all thread buffers. Never destroyed, since threads can exit at any time
+std::mutex& BuffersLock() {
+  static auto* lock = new std::mutex;
+  return *lock;
+}
+
+std::unordered_set<RecordBuffer*>& Buffers() {
+  static auto* buffers = new std::unordered_set<RecordBuffer*>;
+  return *buffers;
+}
+
+// ================================================================================================
+RecordBuffer::RecordBuffer() {
+  records_.reserve(kRecordBatchSize);
+  std::lock_guard<std::mutex> lock(BuffersLock());
+  Buffers().insert(this);
+}
+
+// ================================================================================================
+RecordBuffer::~RecordBuffer() {
+  {
+    std::lock_guard<std::mutex> lock(BuffersLock());
+    Buffers().erase(this);
+  }
+  // Don't call the tool during the process teardown, since it may be already unloaded
+  if (!process_exiting.load(std::memory_order_relaxed)) {
+    Flush();
+  }
+}
+
+// ================================================================================================
+void RecordBuffer::Append(const activity_record_t& record, const char* kernel_name) {
+  Records batch;
+  bool batch_ready = true;
+  uint64_t now = amd::Os::timeNanos();
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (records_.empty()) {
+      first_record_ns_ = now;
+    }
+    records_.push_back({record, (kernel_name != nullptr) ? kernel_name : std::string()});
+    if ((records_.size() < kRecordBatchSize) &&
+        ((now - first_record_ns_) < kRefreshIntervalNs)) {
+      batch_ready = false;
+    } else {
+      batch.reserve(kRecordBatchSize);
+      batch.swap(records_);
+    }
+  }
+  if (batch_ready) {
+    DeliverRecords(batch);
+  }
+  FlushStaleRecords(now);
+}
+
+// ================================================================================================
+void RecordBuffer::Flush() {
+  Records batch;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    if (records_.empty()) {
+      return;
+    }
+    batch.reserve(kRecordBatchSize);
+    batch.swap(records_);
+  }
+  DeliverRecords(batch);
+}
+
+// ================================================================================================
+void RecordBuffer::Take(Records* batch) {
+  std::lock_guard<std::mutex> lock(lock_);
+  for (auto& it : records_) {
+    batch->push_back(std::move(it));
+  }
+  records_.clear();
+}
+
+thread_local RecordBuffer record_buffer;
+
+// ================================================================================================
+void FlushStaleRecords(uint64_t now) {
+  // The buffers of the threads, which stopped to report, are delivered by the active threads,
+  // so a record doesn't stay in an idle buffer longer than the refresh interval
+  uint64_t last = flush_all_time.load(std::memory_order_relaxed);
+  if (((now - last) >= kRefreshIntervalNs) &&
+      flush_all_time.compare_exchange_strong(last, now, std::memory_order_relaxed)) {
+    FlushAll();
+  }
+}
+
+// ================================================================================================
+void RefreshEnabledMask() {
+  uint32_t mask = 0;
+  if (auto report = report_activity.load(std::memory_order_relaxed)) {
+    for (uint32_t op = 0; op < OP_ID_NUMBER; ++op) {
+      if (report(ACTIVITY_DOMAIN_HIP_OPS, op, nullptr) == 0) {
+        mask |= 1u << op;
+      }
+    }
+  }
+  enabled_mask.store(mask, std::memory_order_relaxed);
+  enabled_mask_stale.store(false, std::memory_order_relaxed);
+  queries_until_refresh = kRefreshQueries;
+  FlushStaleRecords(amd::Os::timeNanos());
+}
+
+// ================================================================================================
+void FlushAll() {
+  Records batch;
+  {
+    // Don't call the tool under the lock, since it could report from a new thread
+    std::lock_guard<std::mutex> lock(BuffersLock());
+    for (auto buffer : Buffers()) {
+      buffer->Take(&batch);
+    }
+  }
+  DeliverRecords(batch);
+}
+
+}  // namespace
+
+// ================================================================================================
 bool IsEnabled(OpId operation_id) {
-  if (operation_id < OP_ID_NUMBER)
-    if (auto report = report_activity.load(std::memory_order_relaxed))
-      return report(ACTIVITY_DOMAIN_HIP_OPS, operation_id, nullptr) == 0;
-  return false;
+  if ((operation_id >= OP_ID_NUMBER) ||
+      (report_activity.load(std::memory_order_relaxed) == nullptr)) {
+    return false;
+  }
+  // A query counter instead of the clock keeps the time read off the dispatch path
+  if (enabled_mask_stale.load(std::memory_order_relaxed) || (queries_until_refresh-- == 0)) {
+    RefreshEnabledMask();
+  }
+  return (enabled_mask.load(std::memory_order_relaxed) & (1u << operation_id)) != 0;
+}
+
+// ================================================================================================
+void FlushActivity() {
+  flush_all_time.store(amd::Os::timeNanos(), std::memory_order_relaxed);
+  // A synchronization point also picks up the changes of the enabled operations
+  enabled_mask_stale.store(true, std::memory_order_relaxed);
+  FlushAll();
+}
+
+// ================================================================================================
+void RegisterReportActivity(int (*function)(activity_domain_t domain, uint32_t operation_id,
+                                            void* data)) {
+  FlushActivity();
+  report_activity.store(function, std::memory_order_relaxed);
+  // Force the refresh of the enabled operations on the next query
+  enabled_mask_stale.store(true, std::memory_order_relaxed);
 }
 
 void ReportActivity(const amd::Command& command) {
@@ -58,8 +284,7 @@ void ReportActivity(const amd::Command& command) {
     return;
   }
 
-  auto function = report_activity.load(std::memory_order_relaxed);
-  if (!function) return;
+  if (report_activity.load(std::memory_order_relaxed) == nullptr) return;
 
   const auto* queue = command.queue();
   assert(queue != nullptr);
@@ -77,9 +302,10 @@ void ReportActivity(const amd::Command& command) {
       {}  // copied data size for memcpy, or kernel name for dispatch
   };
 
+  const char* kernel_name = nullptr;
   switch (command.type()) {
     case CL_COMMAND_NDRANGE_KERNEL:
-      record.kernel_name =
+      kernel_name =
           static_cast<const amd::NDRangeKernelCommand&>(command).kernel().name().c_str();
       break;
     case CL_COMMAND_READ_BUFFER:
@@ -101,20 +327,32 @@ void ReportActivity(const amd::Command& command) {
       break;
   }
 
-  if (command.type() == CL_COMMAND_TASK) {
+  if (command.type() == ROCCLR_COMMAND_KERNEL_BATCH) {
+    // Report every kernel of the batch as a separate dispatch
+    const auto& batch = static_cast<const amd::KernelBatchCommand&>(command);
+    record.kind = CL_COMMAND_NDRANGE_KERNEL;
+    const auto& timestamps = batch.getTimestamps();
+    for (uint32_t i = 0; i < batch.commands().size(); i++) {
+      // Without per-dispatch timestamps all kernels report the time of the whole batch
+      if (timestamps.size() == batch.commands().size()) {
+        record.begin_ns = timestamps[i].first;
+        record.end_ns = timestamps[i].second;
+      }
+      record_buffer.Append(record, batch.commands()[i]->kernel().name().c_str());
+    }
+  } else if (command.type() == CL_COMMAND_TASK) {
     auto timestamps = static_cast<const amd::AccumulateCommand&>(command).getTimestamps();
     for (uint32_t i = 0; i < timestamps.size(); i++) {
       auto it = timestamps[i];
       record.begin_ns = it.first;
       record.end_ns = it.second;
-      record.kernel_name =
-        static_cast<const amd::AccumulateCommand&>(command).getKernelNames()[i].c_str();
-      function(ACTIVITY_DOMAIN_HIP_OPS, operation_id, &record);
+      record_buffer.Append(record,
+        static_cast<const amd::AccumulateCommand&>(command).getKernelNames()[i].c_str());
     }
   } else {
       record.begin_ns = command.profilingInfo().start_;
       record.end_ns = command.profilingInfo().end_;
-      function(ACTIVITY_DOMAIN_HIP_OPS, operation_id, &record);
+      record_buffer.Append(record, kernel_name);
   }
 }
 
@@ -159,6 +397,7 @@ const char* getOclCommandKindString(cl_command_type commandType) {
     CASE_STRING(CL_COMMAND_SVM_UNMAP, SvmUnmap);
     CASE_STRING(ROCCLR_COMMAND_STREAM_WAIT_VALUE, StreamWait);
     CASE_STRING(ROCCLR_COMMAND_STREAM_WRITE_VALUE, StreamWrite);
+    CASE_STRING(ROCCLR_COMMAND_KERNEL_BATCH, KernelBatch);
     default:
       break;
   };
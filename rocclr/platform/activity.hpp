@@ -21,6 +21,7 @@
 #pragma once
 
 #include "top.hpp"
+#include "platform/command_utils.hpp"
 
 #include <atomic>
 #include <array>
@@ -51,6 +52,7 @@ constexpr OpId OperationId(cl_command_type commandType) {
   switch (commandType) {
     case CL_COMMAND_NDRANGE_KERNEL:
     case CL_COMMAND_TASK:
+    case ROCCLR_COMMAND_KERNEL_BATCH:
       return OP_ID_DISPATCH;
     case CL_COMMAND_READ_BUFFER:
     case CL_COMMAND_READ_BUFFER_RECT:
@@ -73,9 +75,21 @@ constexpr OpId OperationId(cl_command_type commandType) {
   }
 }
 
+//! Returns true if the tool enabled the operation. The result is taken from a cached bitmask,
+//! which is refreshed from the tool after a number of queries and at the synchronization points
 bool IsEnabled(OpId operation_id);
+
+//! Queues the activity records of a completed command for the delivery to the tool
 void ReportActivity(const amd::Command& command);
 
+//! Delivers the activity records, buffered by all threads, to the tool. Called on every
+//! synchronization, so the records of the completed commands are visible to the tool after it
+void FlushActivity();
+
+//! Installs a new tool callback. The records, buffered for the old callback, are delivered first
+void RegisterReportActivity(int (*function)(activity_domain_t domain, uint32_t operation_id,
+                                            void* data));
+
 }  // namespace activity_prof
 
 const char* getOclCommandKindString(cl_command_type kind);
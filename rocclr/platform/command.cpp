@@ -52,7 +52,7 @@ Event::Event(HostQueue& queue, bool profilingEnabled)
       device_(&queue.device()),
       profilingInfo_(profilingEnabled),
       event_scope_(Device::kCacheStateInvalid) {
-  notified_.clear();
+  notified_.store(false, std::memory_order_relaxed);
 }
 
 // ================================================================================================
@@ -63,7 +63,7 @@ Event::Event()
       notify_event_(nullptr),
       device_(nullptr),
       event_scope_(Device::kCacheStateInvalid) {
-  notified_.clear();
+  notified_.store(false, std::memory_order_relaxed);
 }
 
 // ================================================================================================
@@ -133,6 +133,12 @@ bool Event::setStatus(int32_t status, uint64_t timeStamp) {
     if (callbacks_ != (CallBackEntry*)0) {
       processCallbacks(status);
     }
+    // Buffer the activity record before the status update. A waiter, which spins on the status,
+    // delivers the records right after the wait and must find the record of this command
+    if ((status <= CL_COMPLETE) && profilingInfo().enabled_ &&
+        activity_prof::IsEnabled(OP_ID_DISPATCH)) {
+      activity_prof::ReportActivity(command());
+    }
     if (!status_.compare_exchange_strong(currentStatus, status, std::memory_order_relaxed)) {
       // Somebody else beat us to it, let them deal with the release/signal.
       return false;
@@ -158,7 +164,7 @@ bool Event::setStatus(int32_t status, uint64_t timeStamp) {
       releaseResources();
     }
 
-    if (profilingInfo().enabled_ && activity_prof::IsEnabled(OP_ID_DISPATCH)) {
+    if (!IS_HIP && profilingInfo().enabled_ && activity_prof::IsEnabled(OP_ID_DISPATCH)) {
       activity_prof::ReportActivity(command());
     }
 
@@ -193,7 +199,7 @@ bool Event::resetStatus(int32_t status) {
     ClPrint(LOG_ERROR, LOG_CMD, "Failed to reset command status");
     return false;
   }
-  notified_.clear();
+  notified_.store(false, std::memory_order_relaxed);
   return true;
 }
 
@@ -271,17 +277,21 @@ bool Event::awaitCompletion() {
 
 // ================================================================================================
 bool Event::notifyCmdQueue(bool cpu_wait) {
+  // The queue is notified only once per event. Skip the lock on repeated status polls
+  if (notified_.load(std::memory_order_acquire)) {
+    return true;
+  }
   HostQueue* queue = command().queue();
   if (AMD_DIRECT_DISPATCH) {
     ScopedLock l(notify_lock_);
     if ((status() > CL_COMPLETE) && (nullptr != queue) &&
         // If HW event was assigned, then notification can be ignored, since a barrier was issued
         (HwEvent() == nullptr) &&
-        !notified_.test_and_set()) {
+        !notified_.exchange(true, std::memory_order_acq_rel)) {
       // Make sure the queue is draining the enqueued commands.
       amd::Command* command = new amd::Marker(*queue, false, nullWaitList, this, cpu_wait);
       if (command == NULL) {
-        notified_.clear();
+        notified_.store(false, std::memory_order_relaxed);
         return false;
       }
       ClPrint(LOG_DEBUG, LOG_CMD, "Queue marker to command queue: %p", queue);
@@ -290,11 +300,12 @@ bool Event::notifyCmdQueue(bool cpu_wait) {
       notify_event_ = command;
     }
   } else {
-    if ((status() > CL_COMPLETE) && (nullptr != queue) && !notified_.test_and_set()) {
+    if ((status() > CL_COMPLETE) && (nullptr != queue) &&
+        !notified_.exchange(true, std::memory_order_acq_rel)) {
       // Make sure the queue is draining the enqueued commands.
       amd::Command* command = new amd::Marker(*queue, false, nullWaitList, this);
       if (command == NULL) {
-        notified_.clear();
+        notified_.store(false, std::memory_order_relaxed);
         return false;
       }
       ClPrint(LOG_DEBUG, LOG_CMD, "Queue marker to command queue: %p", queue);
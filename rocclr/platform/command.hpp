@@ -93,7 +93,7 @@ class Event : public RuntimeObject {
 
   std::atomic<CallBackEntry*> callbacks_;  //!< linked list of callback entries.
   std::atomic<int32_t> status_;            //!< current execution status.
-  std::atomic_flag notified_;              //!< Command queue was notified
+  std::atomic<bool> notified_;             //!< Command queue was notified
   void*  hw_event_;                        //!< HW event ID associated with SW event
   Event* notify_event_;                    //!< Notify event, which should contain HW signal
   const Device* device_;                   //!< Device, this event associated with
@@ -1184,6 +1184,47 @@ class NDRangeKernelCommand : public Command {
   int32_t captureAndValidate();
 };
 
+/*! \brief  Submits a list of captured kernel dispatches as a single command.
+ *
+ *  The kernel commands are captured and validated by the caller, but never enqueued on
+ *  their own. The batch owns them and releases them with its resources.
+ */
+class KernelBatchCommand : public Command {
+ private:
+  std::vector<NDRangeKernelCommand*> commands_;  //!< Captured kernel dispatches
+
+  //! Timestamps of the individual dispatches for activity profiling
+  std::vector<std::pair<uint64_t, uint64_t>> tsList_;
+
+ public:
+  KernelBatchCommand(HostQueue& queue, const EventWaitList& eventWaitList,
+                     const std::vector<NDRangeKernelCommand*>& commands)
+      : Command(queue, ROCCLR_COMMAND_KERNEL_BATCH, eventWaitList), commands_(commands) {}
+
+  void releaseResources() {
+    for (const auto& command : commands_) {
+      command->release();
+    }
+    commands_.clear();
+    Command::releaseResources();
+  }
+
+  virtual void submit(device::VirtualDevice& device) { device.submitKernelBatch(*this); }
+
+  //! Return the list of captured kernel dispatches
+  const std::vector<NDRangeKernelCommand*>& commands() const { return commands_; }
+
+  //! Add the timestamp of the next dispatch in the batch if available
+  void addTimestamps(uint64_t startTs, uint64_t endTs) {
+    if (activity_prof::IsEnabled(OP_ID_DISPATCH)) {
+      tsList_.push_back(std::make_pair(startTs, endTs));
+    }
+  }
+
+  //! Return the timestamps of the dispatches
+  const std::vector<std::pair<uint64_t, uint64_t>>& getTimestamps() const { return tsList_; }
+};
+
 class NativeFnCommand : public Command {
  private:
   void(CL_CALLBACK* nativeFn_)(void*);
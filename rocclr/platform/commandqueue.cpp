@@ -117,6 +117,10 @@ void HostQueue::finish(bool cpu_wait) {
   if (IS_HIP) {
     command = getLastQueuedCommand(true);
     if (command == nullptr) {
+      // The queue is idle, but the records of its completed commands can be still buffered
+      if (activity_prof::IsEnabled(OP_ID_DISPATCH)) {
+        activity_prof::FlushActivity();
+      }
       return;
     }
   }
@@ -125,7 +129,8 @@ void HostQueue::finish(bool cpu_wait) {
   bool force_marker = false;
   // Force CPU wait if profiler is enabled. Pytorch tests may use tracer's plugin and rely on
   // profiling information to be available right after finish.
-  cpu_wait |= activity_prof::IsEnabled(OP_ID_DISPATCH);
+  const bool profiler_enabled = activity_prof::IsEnabled(OP_ID_DISPATCH);
+  cpu_wait |= profiler_enabled;
   if (AMD_DIRECT_DISPATCH && (command != nullptr) && !cpu_wait) {
     void* hw_event =
       (command->NotifyEvent() != nullptr) ? command->NotifyEvent()->HwEvent() : command->HwEvent();
@@ -160,6 +165,10 @@ void HostQueue::finish(bool cpu_wait) {
     }
   }
   command->release();
+  if (profiler_enabled) {
+    // Deliver the buffered activity records, so the profiler sees them right after finish
+    activity_prof::FlushActivity();
+  }
   ClPrint(LOG_DEBUG, LOG_CMD, "All commands finished");
 }
 
@@ -19,6 +19,7 @@
  THE SOFTWARE. */
 
 #include "platform/kernel.hpp"
+#include "platform/kernelargarena.hpp"
 #include "platform/program.hpp"
 #include "os/alloc.hpp"
 #include "platform/command.hpp"
@@ -27,6 +28,7 @@
 
 namespace amd {
 
+// ================================================================================================
 Kernel::Kernel(Program& program, const Symbol& symbol, const std::string& name)
     : program_(program), symbol_(symbol), name_(name) {
   parameters_ = new (signature()) KernelParameters(const_cast<KernelSignature&>(signature()));
@@ -164,8 +166,7 @@ address KernelParameters::capture(device::VirtualDevice& vDev, uint64_t lclMemSi
 
   address mem = vDev.allocKernelArguments(totalSize_ + execInfoSize, 128);
   if (mem == nullptr) {
-    mem = reinterpret_cast<address>(AlignedMemory::allocate(totalSize_ + execInfoSize,
-                                                            PARAMETERS_MIN_ALIGNMENT));
+    mem = KernelArgArena::allocate(totalSize_ + execInfoSize);
   } else {
     deviceKernelArgs_ = true;
   }
@@ -235,7 +236,9 @@ address KernelParameters::capture(device::VirtualDevice& vDev, uint64_t lclMemSi
 
   // Check if capture was successful
   if (CL_SUCCESS != *error) {
-    AlignedMemory::deallocate(mem);
+    if (!deviceKernelArgs()) {
+      KernelArgArena::deallocate(mem);
+    }
     mem = nullptr;
   }
   return mem;
@@ -286,7 +289,7 @@ void KernelParameters::release(address mem) const {
   }
 
   if (!deviceKernelArgs()) {
-    AlignedMemory::deallocate(mem);
+    KernelArgArena::deallocate(mem);
   }
 }
 
@@ -0,0 +1,110 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "platform/kernelargarena.hpp"
+#include "os/alloc.hpp"
+#include "utils/flags.hpp"
+#include "utils/debug.hpp"
+
+namespace amd {
+
+thread_local KernelArgArena::ThreadArena KernelArgArena::arena_;
+Monitor KernelArgArena::lock_("Kernel arguments arena lock");
+KernelArgArena::Page* KernelArgArena::freeList_ = nullptr;
+size_t KernelArgArena::numFreePages_ = 0;
+std::atomic<uint64_t> KernelArgArena::numAllocs_(0);
+
+KernelArgArena::Page* KernelArgArena::acquirePage(size_t size) {
+  Page* page = nullptr;
+  if (size == kPageSize) {
+    ScopedLock lock(lock_);
+    if (freeList_ != nullptr) {
+      page = freeList_;
+      freeList_ = page->next_;
+      --numFreePages_;
+    }
+  }
+  if (page == nullptr) {
+    page = reinterpret_cast<Page*>(AlignedMemory::allocate(size, kPageSize));
+    if (page == nullptr) {
+      return nullptr;
+    }
+    page->size_ = size;
+    const uint64_t numAllocs = ++numAllocs_;
+    ClPrint(LOG_DEBUG, LOG_RESOURCE, "Kernel arguments arena allocates page %p, size %zu, "
+            "total allocations %lu", page, size, numAllocs);
+  }
+  page->next_ = nullptr;
+  page->refCount_.store(1, std::memory_order_relaxed);
+  return page;
+}
+
+void KernelArgArena::releasePage(Page* page) {
+  if (page->refCount_.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+  if (page->size_ == kPageSize) {
+    ScopedLock lock(lock_);
+    if (numFreePages_ < kMaxFreePages) {
+      page->next_ = freeList_;
+      freeList_ = page;
+      ++numFreePages_;
+      return;
+    }
+  }
+  AlignedMemory::deallocate(page);
+}
+
+address KernelArgArena::allocate(size_t size) {
+  const size_t alignment = PARAMETERS_MIN_ALIGNMENT;
+  if ((headerSize() + size) > kPageSize) {
+    // The arguments don't fit into a page, hence use a dedicated one
+    Page* page = acquirePage(alignUp(headerSize() + size, kPageSize));
+    return (page != nullptr) ? reinterpret_cast<address>(page) + headerSize() : nullptr;
+  }
+
+  ThreadArena& arena = arena_;
+  if ((arena.page_ == nullptr) || ((alignUp(arena.offset_, alignment) + size) > kPageSize)) {
+    Page* page = acquirePage(kPageSize);
+    if (page == nullptr) {
+      return nullptr;
+    }
+    // Drop the owner reference, so the old page can be recycled with the last block
+    if (arena.page_ != nullptr) {
+      releasePage(arena.page_);
+    }
+    arena.page_ = page;
+    arena.offset_ = headerSize();
+  }
+
+  address mem = reinterpret_cast<address>(arena.page_) + alignUp(arena.offset_, alignment);
+  arena.offset_ = (mem + size) - reinterpret_cast<address>(arena.page_);
+  arena.page_->refCount_.fetch_add(1, std::memory_order_relaxed);
+  return mem;
+}
+
+void KernelArgArena::deallocate(address mem) {
+  if (mem != nullptr) {
+    // The blocks always start in the first page of the allocation
+    releasePage(reinterpret_cast<Page*>(alignDown(mem, kPageSize)));
+  }
+}
+
+}  // namespace amd
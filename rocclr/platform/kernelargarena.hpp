@@ -0,0 +1,86 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef KERNELARGARENA_HPP_
+#define KERNELARGARENA_HPP_
+
+#include "top.hpp"
+#include "utils/flags.hpp"
+#include "utils/util.hpp"
+#include "thread/monitor.hpp"
+
+#include <atomic>
+
+namespace amd {
+
+//! Per-thread bump allocator for the captured kernel arguments. Every page keeps a reference
+//! counter of the live argument blocks plus one reference of the owning thread. The page goes
+//! back to the free list, once the thread moved to another page and all commands, which
+//! captured the arguments from the page, were released.
+class KernelArgArena : public AllStatic {
+ public:
+  static constexpr size_t kPageSize = 64 * Ki;    //!< Page size and alignment
+  static constexpr size_t kMaxFreePages = 64;     //!< The max number of cached free pages
+
+  //! Allocates a block of memory for the captured arguments
+  static address allocate(size_t size);
+
+  //! Releases the block of memory for the captured arguments
+  static void deallocate(address mem);
+
+  //! Returns the number of page allocations from the system since the process start
+  static uint64_t numPageAllocs() { return numAllocs_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Page {
+    std::atomic<uint32_t> refCount_;  //!< The number of live blocks and the owner reference
+    size_t size_;                     //!< The size of the page, including the header
+    Page* next_;                      //!< The next page in the free list
+  };
+
+  //! The current page of the thread
+  struct ThreadArena {
+    Page* page_ = nullptr;  //!< Active page for the allocations
+    size_t offset_ = 0;     //!< Current offset in the active page
+    ~ThreadArena() {
+      if (page_ != nullptr) {
+        releasePage(page_);
+      }
+    }
+  };
+
+  static size_t headerSize() { return alignUp(sizeof(Page), PARAMETERS_MIN_ALIGNMENT); }
+
+  //! Gets a page from the free list or allocates a new one
+  static Page* acquirePage(size_t size);
+
+  //! Drops a reference to the page and recycles it if it was the last one
+  static void releasePage(Page* page);
+
+  static thread_local ThreadArena arena_;     //!< The arena of the current thread
+  static Monitor lock_;                       //!< Lock for the free list
+  static Page* freeList_;                     //!< The list of free pages
+  static size_t numFreePages_;                //!< The number of pages in the free list
+  static std::atomic<uint64_t> numAllocs_;    //!< The number of page allocations
+};
+
+}  // namespace amd
+
+#endif  // KERNELARGARENA_HPP_
@@ -23,6 +23,7 @@
 #include "platform/program.hpp"
 #include "platform/context.hpp"
 #include "utils/options.hpp"
+#include "utils/parallel.hpp"
 #if defined(WITH_COMPILER_LIB)
 #include "utils/libUtils.h"
 #include "utils/bif_section_labels.hpp"
@@ -32,8 +33,11 @@
 #include <cstdlib>  // for malloc
 #include <cstring>  // for strcmp
 #include <sstream>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <list>
+#include <unordered_map>
 #include <utility>
 
 namespace amd {
@@ -485,6 +489,30 @@ void Program::StubProgramSource(const std::string& app_name) {
   program_counter++;
 }
 
+// ================================================================================================
+//! Pending build of a device program
+struct DeviceBuild {
+  Device* device_ = nullptr;                //!< Target device
+  device::Program* program_ = nullptr;      //!< Device program, created late for the group members
+  const DeviceBuild* leader_ = nullptr;     //!< The build of the group, which compiles the source
+  int32_t result_ = CL_SUCCESS;             //!< Result of the device program build
+  option::Options options_;                 //!< Parsed build options for the device
+};
+
+// ================================================================================================
+//! Returns the key of devices, which produce identical code objects from the same source and
+//! options. The key includes the device properties the compiler exposes to the source
+static std::string BuildGroupKey(const Device& device) {
+  const device::Settings& settings = device.settings();
+  const device::Info& info = device.info();
+  std::stringstream key;
+  key << device.isa().isaName() << ' ' << settings.enableWgpMode_ << settings.enableWave32Mode_
+      << settings.lcWavefrontSize64_ << settings.reportFMAF_ << settings.reportFMA_
+      << settings.singleFpDenorm_ << info.imageSupport_ << ' ' << info.singleFPConfig_ << ' '
+      << info.maxGlobalVariableSize_ << ' ' << info.version_ << ' ' << info.extensions_;
+  return key.str();
+}
+
 int32_t Program::build(const std::vector<Device*>& devices, const char* options,
                       void(CL_CALLBACK* notifyFptr)(cl_program, void*), void* data,
                       bool optionChangable, bool newDevProg) {
@@ -514,8 +542,14 @@ int32_t Program::build(const std::vector<Device*>& devices, const char* options,
   optionChangable &= adjustOptionsOnIgnoreEnv(cppstr);
 
   // Build the program programs associated with the given devices.
+  std::list<DeviceBuild> builds;
+  std::unordered_map<std::string, DeviceBuild*> groups;
+  bool parallel = true;
   for (const auto& it : devices) {
-    option::Options parsedOptions;
+    builds.emplace_back();
+    DeviceBuild& build = builds.back();
+    build.device_ = it;
+    option::Options& parsedOptions = build.options_;
     constexpr bool LinkOptsOnly = false;
     if ((language_ != HIP) && !ParseAllOptions(cppstr, parsedOptions, optionChangable, LinkOptsOnly,
                          it->settings().useLightning_)) {
@@ -529,13 +563,23 @@ int32_t Program::build(const std::vector<Device*>& devices, const char* options,
       const binary_t& bin = binary(*it);
       if (sourceCode_.empty() && (std::get<0>(bin) == NULL)) {
         retval = false;
+        builds.pop_back();
         continue;
       }
-      retval = addDeviceProgram(*it, std::get<0>(bin), std::get<1>(bin), false, &parsedOptions);
-      if (retval != CL_SUCCESS) {
-        return retval;
+      // Devices with the same ISA and compiler settings reuse the code object of the first one
+      if ((std::get<0>(bin) == NULL) && it->settings().useLightning_) {
+        auto group = groups.emplace(BuildGroupKey(*it), &build);
+        if (!group.second) {
+          build.leader_ = group.first->second;
+        }
+      }
+      if (build.leader_ == nullptr) {
+        retval = addDeviceProgram(*it, std::get<0>(bin), std::get<1>(bin), false, &parsedOptions);
+        if (retval != CL_SUCCESS) {
+          return retval;
+        }
+        devProgram = getDeviceProgram(*it);
       }
-      devProgram = getDeviceProgram(*it);
     }
 
     parsedOptions.oVariables->AssumeAlias = true;
@@ -554,10 +598,54 @@ int32_t Program::build(const std::vector<Device*>& devices, const char* options,
     }
 
     // We only build a Device-Program once
-    if (devProgram->buildStatus() != CL_BUILD_NONE) {
+    if ((devProgram != nullptr) && (devProgram->buildStatus() != CL_BUILD_NONE)) {
+      builds.pop_back();
       continue;
     }
-    int32_t result = devProgram->build(sourceCode_, options, &parsedOptions, precompiledHeaders_);
+    build.program_ = devProgram;
+    // The compiler library of the HSAIL path isn't thread safe
+    parallel &= it->settings().useLightning_;
+  }
+
+  // Compile the first device of every group, distinct ISAs are built concurrently
+  std::vector<DeviceBuild*> leaders;
+  for (auto& build : builds) {
+    if (build.leader_ == nullptr) {
+      leaders.push_back(&build);
+    }
+  }
+  amd::parallelFor(leaders.size(), parallel ? GPU_PROGRAM_BUILD_THREADS : 1, 1,
+                   [this, &leaders, options](size_t idx) {
+                     DeviceBuild& build = *leaders[idx];
+                     build.result_ = build.program_->build(sourceCode_, options, &build.options_,
+                                                           precompiledHeaders_);
+                   });
+
+  for (auto& build : builds) {
+    const DeviceBuild* leader = build.leader_;
+    if (leader != nullptr) {
+      // Load the code object of the group, if the first device failed then compile again,
+      // so every device reports the errors in its own log
+      const bool shared = (leader->result_ == CL_SUCCESS);
+      const device::Program::binary_t code =
+          shared ? leader->program_->binary() : device::Program::binary_t(nullptr, 0);
+      int32_t status =
+          addDeviceProgram(*build.device_, code.first, code.second, true, &build.options_);
+      if (status != CL_SUCCESS) {
+        return status;
+      }
+      build.program_ = getDeviceProgram(*build.device_);
+      if (shared) {
+        sharedBinaries_.insert(build.device_);
+      }
+      build.result_ = build.program_->build(shared ? std::string() : sourceCode_, options,
+                                            &build.options_, precompiledHeaders_);
+      if (shared) {
+        build.program_->setBuildLog(leader->program_->buildLog() +
+                                    build.program_->buildLog());
+      }
+    }
+    int32_t result = build.result_;
 
     // Check if the previous device failed a build
     if ((result != CL_SUCCESS) && (retval != CL_SUCCESS)) {
@@ -648,6 +736,18 @@ void Program::clear() {
 
   devicePrograms_.clear();
   deviceList_.clear();
+
+  // Shared code objects belong to the previous build, hence a rebuild must compile again
+  for (const auto& device : sharedBinaries_) {
+    auto it = binary_.find(device);
+    if (it != binary_.end()) {
+      if (std::get<2>(it->second)) {
+        delete[] std::get<0>(it->second);
+      }
+      binary_.erase(it);
+    }
+  }
+  sharedBinaries_.clear();
   if (symbolTable_) symbolTable_->clear();
   kernelNames_.clear();
 }
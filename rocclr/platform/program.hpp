@@ -110,6 +110,7 @@ class Program : public RuntimeObject {
   std::string sourceCode_;   //!< Strings that make up the source code
   Language language_;        //!< Input source language
   devicebinary_t binary_;    //!< The binary image, provided by the app
+  std::set<Device const*> sharedBinaries_;  //!< Devices with a code object of another device
   symbols_t* symbolTable_;   //!< The program's kernels symbol table
   std::string kernelNames_;  //!< The program kernel names
 
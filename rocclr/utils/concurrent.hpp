@@ -111,6 +111,43 @@ template <typename T, int N = 5> class ConcurrentLinkedQueue : public HeapObject
   inline bool empty();
 };
 
+/*! \brief A small, direct-mapped, lock-free cache.
+ *
+ * Keys and values are arrays of 64-bit words. Each entry is protected with a
+ * sequence counter (seqlock): readers never block and a lookup, which races with
+ * a writer, is reported as a miss. A writer that loses the race for an entry
+ * simply skips the update, so the cache never returns a torn value.
+ */
+template <uint KeyWords, uint ValueWords, uint NumEntries = 8> class ConcurrentCache {
+ public:
+  typedef uint64_t Key[KeyWords];
+  typedef uint64_t Value[ValueWords];
+
+  //! \brief Find the value for the key. Returns false on a miss.
+  inline bool find(const Key& key, Value& value) const;
+
+  //! \brief Insert or replace the value for the key.
+  inline void insert(const Key& key, const Value& value);
+
+ private:
+  struct Entry {
+    std::atomic<uint32_t> seq_{0};                //!< Even - stable, odd - update in progress
+    std::atomic<uint64_t> key_[KeyWords] = {};    //!< Cached key
+    std::atomic<uint64_t> value_[ValueWords] = {};  //!< Cached value
+  };
+
+  //! \brief Returns the entry index for the key.
+  static inline uint index(const Key& key) {
+    uint64_t hash = 0;
+    for (uint i = 0; i < KeyWords; ++i) {
+      hash = (hash ^ key[i]) * 0x100000001b3ULL;
+    }
+    return static_cast<uint>((hash ^ (hash >> 32)) % NumEntries);
+  }
+
+  Entry entries_[NumEntries];  //!< Cache entries
+};
+
 /*@}*/
 
 template <typename T, int N> inline ConcurrentLinkedQueue<T, N>::ConcurrentLinkedQueue() {
@@ -204,6 +241,47 @@ template <typename T, int N> inline bool ConcurrentLinkedQueue<T, N>::empty() {
   }
 }
 
+template <uint KeyWords, uint ValueWords, uint NumEntries>
+inline bool ConcurrentCache<KeyWords, ValueWords, NumEntries>::find(const Key& key,
+                                                                    Value& value) const {
+  const Entry& entry = entries_[index(key)];
+  uint32_t seq = entry.seq_.load(std::memory_order_acquire);
+  // Zero sequence means the entry was never written
+  if ((seq == 0) || (seq & 1)) {
+    return false;
+  }
+  for (uint i = 0; i < KeyWords; ++i) {
+    if (entry.key_[i].load(std::memory_order_relaxed) != key[i]) {
+      return false;
+    }
+  }
+  for (uint i = 0; i < ValueWords; ++i) {
+    value[i] = entry.value_[i].load(std::memory_order_relaxed);
+  }
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return (seq == entry.seq_.load(std::memory_order_relaxed));
+}
+
+template <uint KeyWords, uint ValueWords, uint NumEntries>
+inline void ConcurrentCache<KeyWords, ValueWords, NumEntries>::insert(const Key& key,
+                                                                      const Value& value) {
+  Entry& entry = entries_[index(key)];
+  uint32_t seq = entry.seq_.load(std::memory_order_relaxed);
+  if ((seq & 1) || !entry.seq_.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire,
+                                                       std::memory_order_relaxed)) {
+    // Another thread updates the entry
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+  for (uint i = 0; i < KeyWords; ++i) {
+    entry.key_[i].store(key[i], std::memory_order_relaxed);
+  }
+  for (uint i = 0; i < ValueWords; ++i) {
+    entry.value_[i].store(value[i], std::memory_order_relaxed);
+  }
+  entry.seq_.store(seq + 2, std::memory_order_release);
+}
+
 }  // namespace amd
 
 #endif /*CONCURRENT_HPP_*/
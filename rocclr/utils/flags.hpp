@@ -247,6 +247,30 @@ release(bool, HIP_VMEM_MANAGE_SUPPORT, true,                                  \
         "Virtual Memory Management Support")                                  \
 release(bool, DEBUG_HIP_GRAPH_DOT_PRINT, false,                               \
          "Enable/Disable graph debug dot print dump")                         \
+release(uint, HSA_KERNARG_POOL_MAX_SIZE, 16 * 1024 * 1024,                    \
+        "Max size the kernarg pool can grow to before the runtime stalls")    \
+release(bool, ROC_QUEUE_LOAD_BALANCE, true,                                   \
+        "Migrate idle streams to less loaded HW queues from the pool")        \
+release(cstring, GPU_BLIT_CODE_OBJECT_PATH, "",                               \
+        "Path to prebuilt blit code objects, matching this runtime version")  \
+release(uint, ROC_DEVICE_INIT_THREADS, 8,                                     \
+        "Max threads for device creation at init, 1 - serial creation")       \
+release(uint, HIP_GRAPH_INSTANTIATE_THREADS, 8,                               \
+        "Max threads for graph node preparation at instantiation")            \
+release(uint, HIP_GRAPH_MAX_STREAMS, 4,                                       \
+        "Max streams for graph branches, 0 - one stream per DFS branch")      \
+release(uint, HIP_MEMCPY_DIRECT_SIZE, 4096,                                   \
+        "Max size of sync host copies, done by CPU directly, 0 - disabled")   \
+release(uint, HIP_MEMCPY_DIRECT_READ_SIZE, 64,                                \
+        "Max size of CPU direct reads from large BAR device memory")          \
+release(bool, ROC_XFER_PATH_CALIBRATION, false,                               \
+        "Select staged/pinned transfer paths from the measured copy times")   \
+release(cstring, ROC_XFER_PATH_TABLE, "",                                     \
+        "Transfer path table file prefix, loaded at init, saved at exit")     \
+release(uint, GPU_PROGRAM_BUILD_THREADS, 8,                                   \
+        "Max threads for program builds of distinct ISAs, 1 - serial builds") \
+release(bool, HIPRTC_USE_PCH_CACHE, true,                                     \
+        "Reuse a builtin header PCH for repeated hiprtc compile options")     \
 
 namespace amd {
 
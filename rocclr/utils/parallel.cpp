@@ -0,0 +1,154 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#include "utils/parallel.hpp"
+#include "thread/thread.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace amd {
+
+namespace {
+
+//! A parallelFor() call, shared by the caller and the workers, which joined it
+struct ParallelJob {
+  std::atomic<size_t> next_{0};                  //!< The next index to run
+  size_t count_;                                 //!< The number of indices
+  const std::function<void(size_t)>& func_;      //!< The function to run for every index
+  const std::function<void()>& threadInit_;      //!< Per thread initialization of the call
+  size_t helpers_;                               //!< Workers, which still can join the job
+  size_t active_ = 0;                            //!< Workers, which run the job (pool lock)
+
+  ParallelJob(size_t count, const std::function<void(size_t)>& func,
+              const std::function<void()>& threadInit, size_t helpers)
+      : count_(count), func_(func), threadInit_(threadInit), helpers_(helpers) {}
+
+  void run() {
+    for (size_t idx = next_++; idx < count_; idx = next_++) {
+      func_(idx);
+    }
+  }
+};
+
+//! Process wide pool of the worker threads. The workers are created on demand, up to the
+//! hardware concurrency, and wait for the jobs until the process exits
+class WorkerPool {
+ public:
+  //! Runs the job on the caller and on up to helpers workers
+  void run(ParallelJob& job, size_t helpers);
+
+ private:
+  void workerLoop();
+
+  std::mutex lock_;                    //!< Guards the job queue and the worker counters
+  std::condition_variable workCv_;     //!< Signals a new job to the idle workers
+  std::condition_variable doneCv_;     //!< Signals the callers that a worker left a job
+  std::deque<ParallelJob*> jobs_;      //!< Jobs, which accept more workers
+  size_t workers_ = 0;                 //!< The number of the created workers
+  size_t idle_ = 0;                    //!< The number of the workers without a job
+};
+
+// ================================================================================================
+void WorkerPool::run(ParallelJob& job, size_t helpers) {
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    const size_t maxWorkers = std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1;
+    while ((idle_ < helpers) && (workers_ < maxWorkers)) {
+      // The workers live until the process exits, hence they are never joined
+      std::thread(&WorkerPool::workerLoop, this).detach();
+      ++workers_;
+      ++idle_;
+    }
+    jobs_.push_back(&job);
+  }
+  workCv_.notify_all();
+
+  job.run();
+
+  std::unique_lock<std::mutex> lock(lock_);
+  // No more workers can join once the caller finished the indices
+  auto it = std::find(jobs_.begin(), jobs_.end(), &job);
+  if (it != jobs_.end()) {
+    jobs_.erase(it);
+  }
+  doneCv_.wait(lock, [&job]() { return job.active_ == 0; });
+}
+
+// ================================================================================================
+void WorkerPool::workerLoop() {
+  // Runtime locks require a registered thread object. It's allocated for the thread lifetime,
+  // as the runtime does for the application threads, so the TLS pointer never dangles
+  new HostThread();
+  std::unique_lock<std::mutex> lock(lock_);
+  while (true) {
+    workCv_.wait(lock, [this]() { return !jobs_.empty(); });
+    ParallelJob* job = jobs_.front();
+    ++job->active_;
+    if (--job->helpers_ == 0) {
+      jobs_.pop_front();
+    }
+    --idle_;
+    lock.unlock();
+
+    if (job->threadInit_) {
+      job->threadInit_();
+    }
+    job->run();
+
+    lock.lock();
+    ++idle_;
+    if (--job->active_ == 0) {
+      doneCv_.notify_all();
+    }
+  }
+}
+
+//! The pool is never destroyed, since the detached workers wait on it until the process exits
+WorkerPool& workerPool() {
+  static auto* pool = new WorkerPool;
+  return *pool;
+}
+
+}  // namespace
+
+// ================================================================================================
+void parallelFor(size_t count, uint maxThreads, size_t minItemsPerThread,
+                 const std::function<void(size_t)>& func,
+                 const std::function<void()>& threadInit) {
+  const size_t num_threads =
+      std::min<size_t>({count / std::max<size_t>(minItemsPerThread, 1), maxThreads,
+                        std::thread::hardware_concurrency()});
+  if (num_threads <= 1) {
+    for (size_t idx = 0; idx < count; ++idx) {
+      func(idx);
+    }
+    return;
+  }
+
+  ParallelJob job(count, func, threadInit, num_threads - 1);
+  workerPool().run(job, num_threads - 1);
+}
+
+}  // namespace amd
@@ -0,0 +1,64 @@
+/* Copyright (c) 2026 Advanced Micro Devices, Inc.
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in
+ all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ THE SOFTWARE. */
+
+#ifndef PARALLEL_HPP_
+#define PARALLEL_HPP_
+
+#include "top.hpp"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+//! \addtogroup Utils
+
+namespace amd { /*@{*/
+
+/*! \brief Runs func(idx) for every idx in [0, count) on a bounded set of host threads.
+ *
+ *  The caller thread takes part in the work. The number of threads is limited by maxThreads,
+ *  by count / minItemsPerThread and by the hardware concurrency, a single thread runs the
+ *  loop serially on the caller. The indices are distributed dynamically, so items with a
+ *  different cost are balanced. The workers are kept in a process wide pool and reused by the
+ *  next calls. Every worker is registered as an amd::HostThread for its lifetime, hence it can
+ *  take runtime locks, and runs threadInit (if any) before the first item of the call.
+ *  A nested call can't deadlock, since the caller runs the items no worker picked up.
+ */
+void parallelFor(size_t count, uint maxThreads, size_t minItemsPerThread,
+                 const std::function<void(size_t)>& func,
+                 const std::function<void()>& threadInit = nullptr);
+
+/*! \brief Creates count objects with create(idx) on parallelFor() and returns them in the
+ *  index order, so the caller registers them serially in a stable order. A failed creation
+ *  returns nullptr and leaves an empty slot, which the caller reports.
+ */
+template <typename T>
+std::vector<std::unique_ptr<T>> parallelCreate(size_t count, uint maxThreads,
+                                               const std::function<T*(size_t)>& create,
+                                               const std::function<void()>& threadInit = nullptr) {
+  std::vector<std::unique_ptr<T>> objects(count);
+  parallelFor(count, maxThreads, 1, [&](size_t idx) { objects[idx].reset(create(idx)); },
+              threadInit);
+  return objects;
+}
+
+/*@}*/} // namespace amd
+
+#endif /*PARALLEL_HPP_*/